@@ -31,11 +31,16 @@ HEADERS += include/task1/dfabuilder.h \
            include/task1/task1window.h \
            include/task2/task2window.h \
            include/task1/lexergenerator.h \
+           include/task1/compiledlexer.h \
+           include/task1/dfatablepacker.h \
+           include/task1/dfalexer.h \
            include/task1/lexertester.h \
            include/task1/mainwindow.h \
            include/task1/nfabuilder.h \
            include/task1/regexprocessor.h \
            include/task1/regexengine.h \
+           include/task1/symboltable.h \
+           include/task1/compactnfa.h \
            include/task2/AST.h \
            include/task2/Grammar.h \
            include/task2/GrammarParser.h \
@@ -56,11 +61,16 @@ SOURCES += main.cpp \
            src/task1/task1window.cpp \
            src/task2/task2window.cpp \
            src/task1/lexergenerator.cpp \
+           src/task1/compiledlexer.cpp \
+           src/task1/dfatablepacker.cpp \
+           src/task1/dfalexer.cpp \
            src/task1/lexertester.cpp \
            src/task1/mainwindow.cpp \
            src/task1/nfabuilder.cpp \
            src/task1/regexprocessor.cpp \
            src/task1/regexengine.cpp \
+           src/task1/symboltable.cpp \
+           src/task1/compactnfa.cpp \
            src/task2/Grammar.cpp \
            src/task2/GrammarParser.cpp \
            src/task2/LL1.cpp \
@@ -0,0 +1,196 @@
+/*
+ * @file compactnfa.h
+ * @id compactnfa-h
+ * @brief 实现冻结的紧凑NFA表示（CSR格式），供子集构造等只读算法使用
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#ifndef COMPACTNFA_H
+#define COMPACTNFA_H
+
+#include <QList>
+#include <QHash>
+#include <QVector>
+#include "nfabuilder.h"
+
+/**
+ * @brief 紧凑NFA类
+ * 
+ * 将NFA冻结为只读的CSR（压缩稀疏行）形式：
+ * 1. 状态重新编号为连续的0..n-1（保持原编号的大小顺序）
+ * 2. 带标号的转换与ε转换分别使用一组偏移数组和目标数组存储
+ * 3. 所有数组分配在同一块连续内存（arena）中
+ * 
+ * 状态s的带标号转换位于下标区间[labelBegin(s), labelEnd(s))，按符号编号排序；
+ * ε转换的目标位于[epsilonBegin(s), epsilonEnd(s))。
+ * 
+ * 调用buildEpsilonClosures()后，每个状态的ε-闭包以位集形式预先计算好，
+ * 任意状态集合的ε-闭包即为各状态闭包位集的按位或。
+ */
+class CompactNFA
+{
+public:
+    /**
+     * @brief 构造空的紧凑NFA
+     */
+    CompactNFA();
+
+    /**
+     * @brief 从NFA构建紧凑NFA
+     * 
+     * @param nfa 原始NFA
+     * @param symbolMap 符号重新标记表：原符号 -> 替换后的符号列表，
+     *                  为空时保持原符号不变（用于按字母表等价类展开转换）
+     */
+    explicit CompactNFA(const NFA &nfa, const QHash<SymbolId, QList<SymbolId>> &symbolMap = QHash<SymbolId, QList<SymbolId>>());
+
+    /**
+     * @brief 获取状态数量
+     * 
+     * @return int 状态数量
+     */
+    int stateCount() const { return m_stateCount; }
+
+    /**
+     * @brief 获取起始状态（紧凑编号）
+     * 
+     * @return int 起始状态
+     */
+    int startState() const { return m_startState; }
+
+    /**
+     * @brief 获取带标号转换的起始下标
+     * 
+     * @param state 状态（紧凑编号）
+     * @return int 起始下标
+     */
+    int labelBegin(int state) const { return m_arena[m_labelOffsets + state]; }
+
+    /**
+     * @brief 获取带标号转换的结束下标（不含）
+     * 
+     * @param state 状态（紧凑编号）
+     * @return int 结束下标
+     */
+    int labelEnd(int state) const { return m_arena[m_labelOffsets + state + 1]; }
+
+    /**
+     * @brief 获取带标号转换的输入符号
+     * 
+     * @param edge 转换下标
+     * @return SymbolId 输入符号编号
+     */
+    SymbolId labelSymbol(int edge) const { return static_cast<SymbolId>(m_arena[m_labelSymbols + edge]); }
+
+    /**
+     * @brief 获取带标号转换的目标状态
+     * 
+     * @param edge 转换下标
+     * @return int 目标状态（紧凑编号）
+     */
+    int labelTarget(int edge) const { return m_arena[m_labelTargets + edge]; }
+
+    /**
+     * @brief 获取状态ε转换目标数组的起始指针
+     * 
+     * @param state 状态（紧凑编号）
+     * @return const qint32* 起始指针
+     */
+    const qint32 *epsilonBegin(int state) const { return m_arena.constData() + m_epsilonTargets + m_arena[m_epsilonOffsets + state]; }
+
+    /**
+     * @brief 获取状态ε转换目标数组的结束指针（不含）
+     * 
+     * @param state 状态（紧凑编号）
+     * @return const qint32* 结束指针
+     */
+    const qint32 *epsilonEnd(int state) const { return m_arena.constData() + m_epsilonTargets + m_arena[m_epsilonOffsets + state + 1]; }
+
+    /**
+     * @brief 判断状态是否为接受状态
+     * 
+     * @param state 状态（紧凑编号）
+     * @return bool 是接受状态返回true
+     */
+    bool isAccept(int state) const { return m_arena[m_acceptInfo + state] != NOT_ACCEPT; }
+
+    /**
+     * @brief 获取接受状态对应的正则表达式索引
+     * 
+     * @param state 状态（紧凑编号）
+     * @return int 正则表达式索引，非接受状态或没有索引时返回-1
+     */
+    int regexIndex(int state) const { return qMax(m_arena[m_acceptInfo + state], -1); }
+
+    /**
+     * @brief 获取紧凑编号对应的原始NFA状态编号
+     * 
+     * @param state 状态（紧凑编号）
+     * @return NFAState 原始状态编号
+     */
+    NFAState originalState(int state) const { return m_arena[m_originalStates + state]; }
+
+    /**
+     * @brief 预计算每个状态的ε-闭包位集
+     * 
+     * 对ε转换图做强连通分量缩点（Tarjan算法），同一分量内的状态闭包相同；
+     * 分量按逆拓扑序完成，完成时其后继分量的闭包均已就绪，
+     * 闭包 = 分量内状态 ∪ 后继分量闭包。每个分量只保存一行位集
+     */
+    void buildEpsilonClosures();
+
+    /**
+     * @brief 获取位集的字数（每字64位）
+     * 
+     * @return int 每行位集的quint64个数
+     */
+    int closureWords() const { return m_closureWords; }
+
+    /**
+     * @brief 获取状态的ε-闭包位集（需先调用buildEpsilonClosures）
+     * 
+     * @param state 状态（紧凑编号）
+     * @return const quint64* 长度为closureWords()的位集
+     */
+    const quint64 *epsilonClosure(int state) const { return m_closureBits.constData() + static_cast<qsizetype>(m_closureRow[state]) * m_closureWords; }
+
+    /**
+     * @brief 获取占用的内存字节数
+     * 
+     * @return qsizetype 字节数
+     */
+    qsizetype memoryBytes() const
+    {
+        return m_arena.size() * static_cast<qsizetype>(sizeof(qint32))
+             + m_closureBits.size() * static_cast<qsizetype>(sizeof(quint64))
+             + m_closureRow.size() * static_cast<qsizetype>(sizeof(int));
+    }
+
+private:
+    /**
+     * @brief 非接受状态在接受信息数组中的取值
+     */
+    static constexpr qint32 NOT_ACCEPT = -2;
+
+    int m_stateCount;        ///< 状态数量
+    int m_startState;        ///< 起始状态（紧凑编号）
+
+    QVector<qint32> m_arena; ///< 存放所有数组的连续内存
+
+    // 各数组在arena中的起始位置
+    int m_labelOffsets;      ///< 带标号转换偏移数组，长度n+1
+    int m_labelSymbols;      ///< 带标号转换的输入符号
+    int m_labelTargets;      ///< 带标号转换的目标状态
+    int m_epsilonOffsets;    ///< ε转换偏移数组，长度n+1
+    int m_epsilonTargets;    ///< ε转换的目标状态
+    int m_acceptInfo;        ///< 正则表达式索引；-1表示接受但无索引，NOT_ACCEPT表示非接受
+    int m_originalStates;    ///< 紧凑编号 -> 原始编号
+
+    int m_closureWords;            ///< 每行闭包位集的字数
+    QVector<quint64> m_closureBits; ///< 各强连通分量的闭包位集，逐行存放
+    QVector<int> m_closureRow;      ///< 状态 -> 所属分量的位集行号
+};
+
+#endif // COMPACTNFA_H
@@ -0,0 +1,258 @@
+/*
+ * @file compiledlexer.h
+ * @id compiledlexer-h
+ * @brief 定义编译后词法分析器的二进制格式，并提供基于内存映射的加载器
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#ifndef COMPILEDLEXER_H
+#define COMPILEDLEXER_H
+
+#include <QString>
+#include <QFile>
+#include <QtGlobal>
+
+/**
+ * @brief 编译后词法分析器文件头
+ * 
+ * 文件按本机字节序存储，由LexerGenerator::saveCompiledLexer写出，整体布局为：
+ * 1. 文件头（本结构体，88字节）
+ * 2. 字节等价类表：256个quint8，字节 -> 等价类
+ * 3. 行位移压缩的转移表（见PackedDFATable）：
+ *    base为stateCount个无符号整数，宽indexBytes字节；
+ *    default为stateCount个有符号整数，next与check各为packedSize个有符号整数，宽stateBytes字节
+ * 4. 接受表：stateCount个qint32，接受状态的token编码，非接受状态为CompiledLexer::NOT_ACCEPT
+ * 
+ * 各段偏移量均为4字节对齐，加载时只需校验文件头即可直接使用映射内存
+ */
+typedef struct {
+    char magic[8];              ///< 魔数"BYYLLEX"，以'\0'结尾
+    quint32 version;            ///< 格式版本号
+    quint32 headerSize;         ///< 文件头字节数
+    quint32 byteOrderMark;      ///< 字节序标记，写入0x01020304
+    quint32 stateCount;         ///< DFA状态数
+    quint64 specHash;           ///< 正则表达式规格文本的哈希值
+    quint32 classCount;         ///< 字节等价类数
+    qint32 startState;          ///< 起始状态
+    quint32 stateBytes;         ///< default/next/check每项的字节数：1、2或4
+    quint32 indexBytes;         ///< base每项的字节数：1、2或4
+    quint32 packedSize;         ///< next/check的项数
+    quint32 byteClassOffset;    ///< 字节等价类表的偏移量
+    quint32 baseOffset;         ///< base的偏移量
+    quint32 defaultOffset;      ///< default的偏移量
+    quint32 nextOffset;         ///< next的偏移量
+    quint32 checkOffset;        ///< check的偏移量
+    quint32 acceptOffset;       ///< 接受表的偏移量
+    quint32 fileSize;           ///< 文件总字节数
+    quint32 reserved[2];        ///< 保留，写入0
+} CompiledLexerHeader;
+
+/**
+ * @brief 编译后词法分析器类
+ * 
+ * 通过内存映射加载二进制格式的词法分析器，加载为O(1)：
+ * 只校验文件头与各段边界，之后的查表直接读取映射内存，不做任何解析。
+ * 来源不可信的文件可在加载后调用verify()检查压缩表中的下标。
+ * 工具可先比较specHash()与当前规格的哈希，相同则跳过正则解析与DFA构建
+ */
+class CompiledLexer
+{
+public:
+    /**
+     * @brief 当前格式版本号
+     */
+    static constexpr quint32 FORMAT_VERSION = 2;
+    
+    /**
+     * @brief 接受表中表示非接受状态的值
+     */
+    static constexpr qint32 NOT_ACCEPT = -2147483647 - 1;
+    
+    /**
+     * @brief 出错状态
+     */
+    static constexpr qint32 DEAD_STATE = -1;
+    
+    /**
+     * @brief 构造函数
+     */
+    CompiledLexer();
+    
+    /**
+     * @brief 析构函数，解除内存映射
+     */
+    ~CompiledLexer();
+    
+    /**
+     * @brief 以内存映射方式加载编译后的词法分析器
+     * 
+     * @param path 文件路径
+     * @return bool 加载成功返回true，失败时可通过getErrorMessage获取原因
+     */
+    bool load(const QString &path);
+    
+    /**
+     * @brief 检查压缩表中的下标与状态编号不会越界
+     * 
+     * load()不检查表的内容，对来源不可信的文件可在加载后调用本函数，
+     * 耗时与表的大小成线性
+     * 
+     * @return bool 有效返回true，无效时可通过getErrorMessage获取原因
+     */
+    bool verify();
+    
+    /**
+     * @brief 解除内存映射并关闭文件
+     */
+    void unload();
+    
+    /**
+     * @brief 是否已加载
+     * 
+     * @return bool 已加载返回true
+     */
+    bool isLoaded() const;
+    
+    /**
+     * @brief 获取生成该文件时的规格哈希
+     * 
+     * @return quint64 规格哈希
+     */
+    quint64 specHash() const;
+    
+    /**
+     * @brief 获取DFA状态数
+     * 
+     * @return int 状态数
+     */
+    int stateCount() const;
+    
+    /**
+     * @brief 获取字节等价类数
+     * 
+     * @return int 等价类数
+     */
+    int classCount() const;
+    
+    /**
+     * @brief 获取起始状态
+     * 
+     * @return int 起始状态
+     */
+    int startState() const;
+    
+    /**
+     * @brief 状态转移
+     * 
+     * @param state 当前状态（必须有效）
+     * @param c 输入字节
+     * @return int 下一状态，出错时返回DEAD_STATE
+     */
+    inline int nextState(int state, uchar c) const
+    {
+        const int classIndex = m_byteClasses[c];
+        for (int s = state; s >= 0; s = readState(m_defaults, s)) {
+            const int slot = readIndex(m_base, s) + classIndex;
+            if (readState(m_check, slot) == s) {
+                return readState(m_next, slot);
+            }
+        }
+        return DEAD_STATE;
+    }
+    
+    /**
+     * @brief 判断状态是否为接受状态
+     * 
+     * @param state 状态
+     * @return bool 接受状态返回true
+     */
+    inline bool isAccept(int state) const
+    {
+        return m_acceptTokens[state] != NOT_ACCEPT;
+    }
+    
+    /**
+     * @brief 获取接受状态的token编码
+     * 
+     * @param state 状态
+     * @return int token编码，非接受状态返回NOT_ACCEPT
+     */
+    inline int acceptToken(int state) const
+    {
+        return m_acceptTokens[state];
+    }
+    
+    /**
+     * @brief 获取错误信息
+     * 
+     * @return QString 错误信息
+     */
+    QString getErrorMessage() const;
+    
+    /**
+     * @brief 计算正则表达式规格文本的哈希
+     * 
+     * 对UTF-8编码的规格文本做64位FNV-1a哈希，写入文件头并用于判断规格是否变化
+     * 
+     * @param specText 规格文本
+     * @return quint64 哈希值
+     */
+    static quint64 hashSpec(const QString &specText);
+    
+private:
+    /**
+     * @brief 读取default/next/check中的一项
+     * 
+     * @param table 表起始地址
+     * @param i 下标
+     * @return int 有符号值
+     */
+    inline int readState(const uchar *table, int i) const
+    {
+        switch (m_stateBytes) {
+        case 1:
+            return reinterpret_cast<const qint8 *>(table)[i];
+        case 2:
+            return reinterpret_cast<const qint16 *>(table)[i];
+        default:
+            return reinterpret_cast<const qint32 *>(table)[i];
+        }
+    }
+    
+    /**
+     * @brief 读取base中的一项
+     * 
+     * @param table 表起始地址
+     * @param i 下标
+     * @return int 无符号值
+     */
+    inline int readIndex(const uchar *table, int i) const
+    {
+        switch (m_indexBytes) {
+        case 1:
+            return table[i];
+        case 2:
+            return reinterpret_cast<const quint16 *>(table)[i];
+        default:
+            return static_cast<int>(reinterpret_cast<const quint32 *>(table)[i]);
+        }
+    }
+    
+    QFile m_file;                        ///< 映射的文件
+    uchar *m_data;                       ///< 映射内存起始地址
+    const CompiledLexerHeader *m_header; ///< 文件头
+    const quint8 *m_byteClasses;         ///< 字节等价类表
+    const uchar *m_base;                 ///< 每个状态的行起点
+    const uchar *m_defaults;             ///< 每个状态的默认状态
+    const uchar *m_next;                 ///< 叠放后的后继状态
+    const uchar *m_check;                ///< 叠放后每个位置所属的状态
+    const qint32 *m_acceptTokens;        ///< 接受表
+    int m_classCount;                    ///< 等价类数
+    int m_stateBytes;                    ///< default/next/check每项的字节数
+    int m_indexBytes;                    ///< base每项的字节数
+    QString m_errorMessage;              ///< 错误信息
+};
+
+#endif // COMPILEDLEXER_H
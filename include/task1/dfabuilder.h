@@ -14,7 +14,9 @@
 #include <QList>
 #include <QSet>
 #include <QMap>
+#include <QVector>
 #include "nfabuilder.h"
+#include "compactnfa.h"
 
 /**
  * @brief DFA状态类型
@@ -37,7 +39,7 @@ typedef int NFAState;
  */
 typedef struct {
     DFAState fromState;  ///< 起始状态
-    QString input;       ///< 输入字符
+    SymbolId input;      ///< 输入符号编号
     DFAState toState;    ///< 目标状态
 } DFATransition;
 
@@ -48,24 +50,53 @@ typedef struct {
  */
 typedef struct {
     QList<DFAState> states;                  ///< 所有状态
-    QSet<QString> alphabet;                 ///< 字母表
+    QSet<SymbolId> alphabet;                ///< 字母表（符号编号）
     QList<DFATransition> transitions;      ///< 转换规则
     DFAState startState;                   ///< 起始状态
     QSet<DFAState> acceptStates;           ///< 接受状态集合
     /**
-     * @brief 状态映射：NFA状态列表 -> DFA状态
+     * @brief 状态来源的偏移表：DFA状态 -> 在provenanceStates中的起始位置
      * 
-     * 用于记录NFA状态子集到DFA状态的映射关系
+     * 状态s对应的NFA状态为provenanceStates[provenanceOffsets[s], provenanceOffsets[s + 1])，按编号升序。
+     * 为空表示未记录，可由DFABuilder::computeProvenance按需计算
      */
-    QMap<QList<NFAState>, DFAState> stateMap;
+    QVector<int> provenanceOffsets;
+    QVector<NFAState> provenanceStates;    ///< 所有DFA状态的NFA状态集合，按DFA状态顺序连续存放
     /**
      * @brief 接受状态到正则表达式索引的映射
      * 
      * 用于标识哪个正则表达式匹配成功
      */
     QMap<DFAState, int> acceptStateToRegexIndex;
+    /**
+     * @brief 多单词正则表达式的接受状态到单词下标的映射
+     * 
+     * 值为所接受单词在RegexItem::wordList中的下标，token编码为RegexItem::code加该下标；
+     * 由DFABuilder::labelWordAcceptStates填充，最小化时作为初始划分的依据之一
+     */
+    QMap<DFAState, int> acceptStateToWordIndex;
 } DFA;
 
+/**
+ * @brief 子集构造中一条后继边
+ * 
+ * 记录某个DFA状态在一个等价类上的目标集合
+ */
+typedef struct {
+    int classIndex;    ///< 等价类在有序字母表中的下标
+    DFAState state;    ///< 已登记的目标状态，-1表示需在合并阶段登记
+    quint64 hash;      ///< 目标集合位集的哈希值
+    int offset;        ///< 目标位集在StateSuccessors::bits中的偏移（state为-1时有效）
+} SuccessorEdge;
+
+/**
+ * @brief 子集构造中一个DFA状态的全部后继
+ */
+typedef struct {
+    QVector<SuccessorEdge> edges;  ///< 按等价类顺序排列的后继边
+    QVector<quint64> bits;         ///< 未登记目标集合的位集
+} StateSuccessors;
+
 /**
  * @brief DFA构建器类
  * 
@@ -74,6 +105,7 @@ typedef struct {
  * 1. ε-闭包计算
  * 2. move操作计算
  * 3. NFA到DFA的完整转换
+ * 4. 由语法树按followpos直接构造DFA
  */
 class DFABuilder
 {
@@ -98,36 +130,195 @@ public:
      */
     DFA convertNFAToDFA(const NFA &nfa);
     
+    /**
+     * @brief 由正则表达式语法树直接构造DFA
+     * 
+     * 按Aho–Sethi–Ullman的followpos方法构造，不经过Thompson NFA与ε-闭包：
+     * 各语法树分别求nullable/firstpos/lastpos/followpos，每棵树末尾接一个结束标记位置，
+     * DFA状态即位置集合。多棵树视为选择，含结束标记的状态为接受状态，
+     * 排在前面的树优先，与convertNFAToDFA对合并NFA的优先级一致。
+     * 得到的DFA与子集构造的结果语言相同（最小化后同构），但不记录状态来源
+     * 
+     * @param trees 语法树列表（由NFABuilder::buildSyntaxTree构建）
+     * @param regexIndices 每棵树对应的正则表达式索引
+     * @return 构造得到的DFA
+     */
+    DFA convertRegexesToDFA(const QList<RegexSyntaxTree> &trees, const QList<int> &regexIndices);
+    
+    /**
+     * @brief 标注多单词正则表达式的接受状态
+     * 
+     * 复制多单词项各单词路径上的状态，使每个单词结束于自己的接受状态，
+     * 并把单词下标记录到DFA::acceptStateToWordIndex。
+     * 需在最小化之前调用，最小化后每个单词仍有各自的接受状态，生成的词法分析器无需再查单词表
+     * 
+     * @param dfa 要标注的DFA
+     * @param regexItems 正则表达式项列表（下标与DFA::acceptStateToRegexIndex一致）
+     */
+    void labelWordAcceptStates(DFA &dfa, const QList<RegexItem> &regexItems) const;
+    
     /**
      * @brief 获取错误信息
      * 
      * @return QString 错误信息字符串
      */
     QString getErrorMessage() const;
+    
+    /**
+     * @brief 设置子集构造时是否记录状态来源
+     * 
+     * 状态来源只用于追溯每个DFA状态来自哪些NFA状态，
+     * 默认不记录，需要时用computeProvenance按需计算
+     * 
+     * @param keep 为true时在转换结束时填充DFA::provenanceOffsets/provenanceStates
+     */
+    void setKeepProvenance(bool keep);
+    
+    /**
+     * @brief 子集构造时是否记录状态来源
+     * 
+     * @return bool 为true时填充状态来源
+     */
+    bool keepProvenance() const;
+    
+    /**
+     * @brief 按需计算DFA的状态来源
+     * 
+     * 从起始状态出发广度优先遍历DFA，同时在NFA上模拟子集构造，
+     * 得到每个可达DFA状态对应的NFA状态集合；DFA若由直接构造法得到，
+     * 结果为沿首条到达路径模拟出的NFA状态集合
+     * 
+     * @param nfa DFA对应的NFA
+     * @param dfa 要填充状态来源的DFA
+     */
+    void computeProvenance(const NFA &nfa, DFA &dfa) const;
+    
+    /**
+     * @brief 获取一个DFA状态对应的NFA状态集合
+     * 
+     * @param dfa DFA
+     * @param state DFA状态
+     * @return QList<NFAState> 升序的NFA状态，未记录状态来源时为空
+     */
+    static QList<NFAState> provenanceOf(const DFA &dfa, DFAState state);
+    
+    /**
+     * @brief 设置子集构造使用的线程数
+     * 
+     * 多线程时同一层的DFA状态由多个线程并行计算后继，
+     * 新状态仍按确定顺序编号，结果与单线程完全相同
+     * 
+     * @param count 线程数，默认为1；小于等于0表示使用QThread::idealThreadCount()
+     */
+    void setThreadCount(int count);
+    
+    /**
+     * @brief 获取子集构造使用的线程数
+     * 
+     * @return int 线程数设置
+     */
+    int threadCount() const;
+    
+    /**
+     * @brief 设置多个正则表达式同时接受时的优先级
+     * 
+     * 一个DFA状态同时包含多个正则表达式的接受状态时，多单词项（关键字、运算符等单词列表）
+     * 优先于一般模式，同类之间按正则表达式的声明顺序（下标小者优先），
+     * 与NFA的合并顺序、语法树的顺序及正则表达式名称无关。未设置时只按下标比较。
+     * 子集构造与直接构造都按此优先级确定接受状态的正则表达式索引
+     * 
+     * @param regexItems 正则表达式项列表（下标与正则表达式索引一致）
+     */
+    void setTokenPriority(const QList<RegexItem> &regexItems);
 
 private:
     /**
-     * @brief 计算ε-闭包
+     * @brief 计算字母表等价类
+     * 
+     * NFA中的符号（单字符或字符类）可能互相重叠。将字符空间按
+     * "被哪些符号覆盖"划分为互不相交的等价类，每条转换替换为其覆盖的各个等价类，
+     * 子集构造只需遍历等价类，而不是每个出现过的字符
+     * 
+     * @param symbolSet 出现过的所有非空符号
+     * @param classes 输出参数，按首字符升序排列的等价类符号
+     * @return QHash<SymbolId, QList<SymbolId>> 原始符号 -> 其覆盖的等价类符号
+     */
+    QHash<SymbolId, QList<SymbolId>> computeCharClasses(const QSet<SymbolId> &symbolSet, QList<SymbolId> &classes);
+    
+    /**
+     * @brief 标记接受状态
+     * 
+     * 若新状态的集合包含接受NFA状态，则记为接受状态，
+     * 并以优先级最高（见setTokenPriority）的正则表达式作为其索引
+     * 
+     * @param dfa 正在构建的DFA
+     * @param nfa 紧凑NFA
+     * @param acceptMask 接受状态位掩码
+     * @param state 新创建的DFA状态
+     */
+    void markAcceptState(DFA &dfa, const CompactNFA &nfa, const QVector<quint64> &acceptMask, DFAState state);
+    
+    /**
+     * @brief 获取正则表达式的接受优先级
+     * 
+     * @param regexIndex 正则表达式索引，-1表示未映射
+     * @return int 优先级，值越小越优先；未映射的排在最后
+     */
+    int regexRank(int regexIndex) const;
+    
+    /**
+     * @brief 计算状态集合位集的64位哈希
+     * 
+     * @param bits 位集
+     * @param words 位集字数
+     * @return quint64 哈希值
+     */
+    static quint64 hashStateSet(const quint64 *bits, int words);
+    
+    /**
+     * @brief 查找DFA状态集合
+     * 
+     * 在开放寻址表中按哈希查找，只读，可被多个线程同时调用
      * 
-     * 计算给定状态集合的ε-闭包，即通过ε转换可达的所有状态
+     * @param bits 状态集合位集
+     * @param hash 位集的哈希值
+     * @return DFAState 对应的DFA状态，不存在时返回-1
+     */
+    DFAState findStateSet(const quint64 *bits, quint64 hash) const;
+    
+    /**
+     * @brief 登记新的DFA状态集合
      * 
-     * @param nfa NFA对象
-     * @param states 起始状态集合
-     * @return QSet<NFAState> ε-闭包结果集合
+     * @param bits 状态集合位集
+     * @param hash 位集的哈希值
+     * @return DFAState 新分配的DFA状态
      */
-    QSet<NFAState> epsilonClosure(const NFA &nfa, const QSet<NFAState> &states);
+    DFAState addStateSet(const quint64 *bits, quint64 hash);
     
     /**
-     * @brief 计算move操作
+     * @brief 计算一个DFA状态的全部后继
      * 
-     * 计算给定状态集合在特定输入下的转换结果
+     * 按等价类分桶求出后继集合，已登记的集合直接解析为状态编号；
+     * 只读访问共享数据，可在工作线程中调用
      * 
-     * @param nfa NFA对象
-     * @param states 起始状态集合
-     * @param input 输入字符
-     * @return QSet<NFAState> 通过输入字符可达的状态集合
+     * @param nfa 紧凑NFA
+     * @param classIndex 等价类符号 -> 字母表下标
+     * @param state 要展开的DFA状态
+     * @param targets 工作区，每个等价类一行位集
+     * @param classStamp 工作区，等价类最近一次出现时所属的状态编号加1
+     * @param touched 工作区，出现过的等价类下标
+     * @param result 输出参数，该状态的后继
      */
-    QSet<NFAState> move(const NFA &nfa, const QSet<NFAState> &states, const QString &input);
+    void computeSuccessors(const CompactNFA &nfa, const int *classIndex, DFAState state,
+                           quint64 *targets, int *classStamp, QVector<int> &touched,
+                           StateSuccessors &result) const;
+    
+    /**
+     * @brief 重置状态集合池与去重表
+     * 
+     * @param words 每个状态集合位集的字数
+     */
+    void resetStateSets(int words);
     
     /**
      * @brief 获取下一个可用的DFA状态编号
@@ -143,6 +334,14 @@ private:
 
     DFAState m_nextState;      ///< 下一个可用的状态编号
     QString m_errorMessage;    ///< 错误信息
+    bool m_keepProvenance;     ///< 子集构造时是否记录状态来源
+    int m_threadCount;         ///< 子集构造使用的线程数，小于等于0表示自动
+    QVector<int> m_regexRank;  ///< 正则表达式索引 -> 接受优先级，为空时按索引
+    
+    int m_setWords;                ///< 每个状态集合位集的字数
+    QVector<quint64> m_setPool;    ///< 状态集合池，DFA状态i的位集位于[i*m_setWords, (i+1)*m_setWords)
+    QVector<quint64> m_setHashes;  ///< 每个DFA状态集合的64位哈希
+    QVector<int> m_setSlots;       ///< 开放寻址表，槽中为DFA状态编号，-1表示空槽
 };
 
 #endif // DFABUILDER_H
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*
+ * @file dfalexer.h
+ * @id dfalexer-h
+ * @brief 提供进程内的词法分析接口，直接用最小化DFA的稠密转移表识别单词，大输入分块并行
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#ifndef DFALEXER_H
+#define DFALEXER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+#include "regexprocessor.h"
+#include "dfabuilder.h"
+#include "dfatablepacker.h"
+
+/**
+ * @brief 识别出的单词
+ * 
+ * 单词为输入中[offset, offset + length)的字节
+ */
+typedef struct {
+    int code;        ///< token编码
+    qint64 offset;   ///< 单词在输入中的起始偏移
+    qint64 length;   ///< 单词的字节数
+} LexedToken;
+
+/**
+ * @brief 进程内词法分析器类
+ * 
+ * 与生成的词法分析器规则相同：跳过空白字符（'\t'~'\r'与空格），按最长匹配识别单词，
+ * 无法识别的字节逐个跳过。输入较大且线程数大于1时分块并行：
+ * 各块从块首推测识别，再从上一块实际结束的位置顺序重新识别，直到与推测结果的单词起点汇合
+ */
+class DFALexer
+{
+public:
+    /**
+     * @brief 构造函数
+     */
+    DFALexer();
+    
+    /**
+     * @brief 析构函数
+     */
+    ~DFALexer();
+    
+    /**
+     * @brief 由最小化DFA构建词法分析器
+     * 
+     * @param regexItems 正则表达式项列表
+     * @param minimizedDFA 最小化的DFA（已标注多单词项的接受状态）
+     * @return bool 构建成功返回true，失败时可通过getErrorMessage获取原因
+     */
+    bool build(const QList<RegexItem> &regexItems, const DFA &minimizedDFA);
+    
+    /**
+     * @brief 识别输入中的全部单词
+     * 
+     * @param source 输入字节
+     * @return QVector<LexedToken> 按偏移递增排列的单词，未构建时返回空列表
+     */
+    QVector<LexedToken> tokenize(const QByteArray &source) const;
+    
+    /**
+     * @brief 设置识别使用的线程数
+     * 
+     * 多线程时结果与单线程完全相同
+     * 
+     * @param count 线程数，默认为1；小于等于0表示使用QThread::idealThreadCount()
+     */
+    void setThreadCount(int count);
+    
+    /**
+     * @brief 获取识别使用的线程数
+     * 
+     * @return int 线程数设置
+     */
+    int threadCount() const;
+    
+    /**
+     * @brief 获取错误信息
+     * 
+     * @return QString 错误信息
+     */
+    QString getErrorMessage() const;
+    
+private:
+    /**
+     * @brief 一个块的推测识别结果
+     */
+    typedef struct {
+        qint64 begin;                ///< 块首
+        qint64 limit;                ///< 块尾，单词起点到达limit即停止
+        qint64 end;                  ///< 停止时的扫描位置
+        QVector<LexedToken> tokens;  ///< 推测识别出的单词
+    } Chunk;
+    
+    /**
+     * @brief 从start开始按最长匹配识别一个单词
+     * 
+     * @param data 输入起始地址
+     * @param size 输入字节数
+     * @param start 单词起点
+     * @param code 输出参数，token编码
+     * @return qint64 单词之后的位置，无法识别时返回-1
+     */
+    qint64 lexToken(const uchar *data, qint64 size, qint64 start, int &code) const;
+    
+    /**
+     * @brief 识别一个单词（无法识别时跳过该字节）并跳过其后的空白字符
+     * 
+     * @param data 输入起始地址
+     * @param size 输入字节数
+     * @param pos 扫描位置
+     * @param tokens 识别出的单词追加到此列表
+     * @return qint64 下一扫描位置
+     */
+    qint64 lexStep(const uchar *data, qint64 size, qint64 pos, QVector<LexedToken> &tokens) const;
+    
+    /**
+     * @brief 从块首推测识别一个块
+     * 
+     * @param data 输入起始地址
+     * @param size 输入字节数
+     * @param chunk 块，识别结果写入tokens与end
+     */
+    void lexChunk(const uchar *data, qint64 size, Chunk &chunk) const;
+    
+    /**
+     * @brief 跳过空白字符
+     * 
+     * @param data 输入起始地址
+     * @param size 输入字节数
+     * @param pos 扫描位置
+     * @return qint64 第一个非空白字符的位置
+     */
+    static qint64 skipBlank(const uchar *data, qint64 size, qint64 pos);
+    
+    DenseDFATable m_table;           ///< 稠密转移表
+    QVector<qint32> m_acceptTokens;  ///< 每个状态的token编码，非接受状态为CompiledLexer::NOT_ACCEPT
+    bool m_built;                    ///< 是否已构建
+    int m_threadCount;               ///< 识别使用的线程数，小于等于0表示自动
+    QString m_errorMessage;          ///< 错误信息
+};
+
+#endif // DFALEXER_H
@@ -60,39 +60,25 @@ private:
     /**
      * @brief Hopcroft算法的实现
      * 
-     * 使用Hopcroft算法对DFA进行最小化分区
+     * 基于可细分划分（块/元素数组、块内标记计数、(块, 符号)工作集合）实现，
+     * 时间复杂度O(m·log n)，m为转换数，n为状态数。
+     * 初始划分按接受的token（正则表达式下标与单词下标）区分接受状态
      * 
      * @param dfa 输入DFA
-     * @return QList<QSet<DFAState>> 最小化后的状态分区
+     * @return QList<QSet<DFAState>> 最小化后的状态分区，按块中最小状态编号排序
      */
     QList<QSet<DFAState>> hopcroftAlgorithm(const DFA &dfa);
     
     /**
-     * @brief 计算在输入字符下的状态集合的移动
+     * @brief 去掉从起始状态不可达的状态及其出边
      * 
-     * @param dfa 输入DFA
-     * @param states 状态集合
-     * @param input 输入字符
-     * @return QSet<DFAState> 移动后的状态集合
-     */
-    QSet<DFAState> move(const DFA &dfa, const QSet<DFAState> &states, const QString &input);
-    
-    /**
-     * @brief 检查状态是否在接受状态集合中
+     * 状态编号不变，只从状态列表与转换中删去；
+     * 例如DFABuilder::labelWordAcceptStates复制单词路径后，原路径上的状态可能不再可达
      * 
      * @param dfa 输入DFA
-     * @param state 要检查的状态
-     * @return bool 是接受状态返回true，否则返回false
-     */
-    bool isAcceptState(const DFA &dfa, DFAState state);
-    
-    /**
-     * @brief 辅助函数：获取状态集合的代表
-     * 
-     * @param states 状态集合
-     * @return DFAState 状态集合的代表状态
+     * @return DFA 只含可达状态的DFA
      */
-    DFAState getSetRepresentative(const QSet<DFAState> &states);
+    DFA removeUnreachableStates(const DFA &dfa);
     
     /**
      * @brief 辅助函数：创建新的DFA状态映射
@@ -102,17 +88,6 @@ private:
      */
     QMap<DFAState, DFAState> createStateMap(const QList<QSet<DFAState>> &partitions);
     
-    /**
-     * @brief 增强Hopcroft算法以处理可选符号的语义限制
-     * 
-     * 对Hopcroft算法进行扩展，以处理可选符号的语义限制
-     * 
-     * @param dfa 输入DFA
-     * @param partitions 初始状态分区
-     * @return QList<QSet<DFAState>> 增强后的状态分区
-     */
-    QList<QSet<DFAState>> enhanceHopcroftForOptionalSymbols(const DFA &dfa, const QList<QSet<DFAState>> &partitions);
-    
     /**
      * @brief 错误信息
      */
@@ -0,0 +1,135 @@
+/*
+ * @file dfatablepacker.h
+ * @id dfatablepacker-h
+ * @brief 把最小化DFA压缩为按字节等价类索引的行位移（comb-vector）转移表
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#ifndef DFATABLEPACKER_H
+#define DFATABLEPACKER_H
+
+#include <QString>
+#include <QVector>
+#include "dfabuilder.h"
+
+/**
+ * @brief 稠密转移表
+ * 
+ * 字节先经byteClasses映射为等价类（转移表中列完全相同的字节归为一类），
+ * 状态s在等价类k上的后继为transitions[s * classCount + k]，-1表示出错状态
+ */
+typedef struct {
+    int stateCount;                ///< 状态数
+    int classCount;                ///< 字节等价类数
+    DFAState startState;           ///< 起始状态
+    QVector<quint8> byteClasses;   ///< 字节 -> 等价类，共256项
+    QVector<qint32> transitions;   ///< 按状态行优先存放的稠密转移表
+} DenseDFATable;
+
+/**
+ * @brief 行位移压缩的转移表
+ * 
+ * 与flex的base/def/nxt/chk相同：状态s的行以base[s]为起点叠放在next/check中，
+ * 查找等价类k时若check[base[s] + k] == s则后继为next[base[s] + k]，
+ * 否则改查默认状态defaults[s]（与s的行只有少数列不同的先前状态），
+ * 默认状态为-1时为出错状态。默认状态的编号总小于s本身，查找必然终止。
+ * 
+ * 各数组在内存中统一用32位存放，输出时按stateBytes/indexBytes收窄
+ */
+typedef struct {
+    int stateCount;                ///< 状态数
+    int classCount;                ///< 字节等价类数
+    DFAState startState;           ///< 起始状态
+    QVector<quint8> byteClasses;   ///< 字节 -> 等价类，共256项
+    QVector<qint32> base;          ///< 每个状态的行在next/check中的起点
+    QVector<qint32> defaults;      ///< 每个状态的默认状态，-1表示没有
+    QVector<qint32> next;          ///< 叠放后的后继状态，-1表示出错状态
+    QVector<qint32> check;         ///< 叠放后每个位置所属的状态，-1表示空位
+    int stateBytes;                ///< 存放状态编号（含-1）所需的字节数：1、2或4
+    int indexBytes;                ///< 存放base所需的字节数：1、2或4
+} PackedDFATable;
+
+/**
+ * @brief DFA转移表压缩器类
+ * 
+ * 先把最小化DFA按字节展开为稠密表并归并字节等价类，
+ * 再为每个状态挑选默认状态，只保留与默认状态不同的列，
+ * 最后用首次适配把各行叠放进同一对next/check数组
+ */
+class DFATablePacker
+{
+public:
+    /**
+     * @brief 构造函数
+     */
+    DFATablePacker();
+    
+    /**
+     * @brief 析构函数
+     */
+    ~DFATablePacker();
+    
+    /**
+     * @brief 构建稠密转移表
+     * 
+     * 状态编号必须为连续的0..n-1（最小化DFA满足），只展开0~255的字节
+     * 
+     * @param dfa 最小化DFA
+     * @param table 输出参数，稠密转移表
+     * @return bool 构建成功返回true，失败时可通过getErrorMessage获取原因
+     */
+    bool buildDenseTable(const DFA &dfa, DenseDFATable &table);
+    
+    /**
+     * @brief 压缩稠密转移表
+     * 
+     * @param dense 稠密转移表
+     * @return PackedDFATable 行位移压缩的转移表
+     */
+    PackedDFATable pack(const DenseDFATable &dense) const;
+    
+    /**
+     * @brief 在压缩表上查找状态转移
+     * 
+     * @param table 压缩转移表
+     * @param state 当前状态（必须有效）
+     * @param c 输入字节
+     * @return int 下一状态，出错时返回-1
+     */
+    static int nextState(const PackedDFATable &table, int state, uchar c);
+    
+    /**
+     * @brief 计算存放某个取值范围的整数所需的字节数
+     * 
+     * 最小值非负时按无符号类型计算，否则按有符号类型计算
+     * 
+     * @param minValue 最小值
+     * @param maxValue 最大值
+     * @return int 字节数：1、2或4
+     */
+    static int integerBytes(qint64 minValue, qint64 maxValue);
+    
+    /**
+     * @brief 获取错误信息
+     * 
+     * @return QString 错误信息
+     */
+    QString getErrorMessage() const;
+    
+private:
+    /**
+     * @brief 挑选默认状态时比较的最近状态个数
+     */
+    static constexpr int DEFAULT_CANDIDATES = 32;
+    
+    /**
+     * @brief 默认状态链的最大长度，限制最坏情况下一次查找的跳转次数
+     */
+    static constexpr int MAX_DEFAULT_DEPTH = 3;
+    
+    QString m_errorMessage;  ///< 错误信息
+};
+
+#endif // DFATABLEPACKER_H
@@ -24,9 +24,34 @@
  */
 enum class GenerationMethod {
     DIRECT_MATCH,     ///< 直接匹配逻辑，适用于简单正则表达式
-    STATE_TRANSITION  ///< 状态转移逻辑，基于DFA状态机实现
+    STATE_TRANSITION, ///< 状态转移逻辑，基于DFA状态机实现
+    TABLE_DRIVEN,     ///< 表驱动逻辑，字节等价类映射加稠密或行位移压缩的转移表
+    DIRECT_CODED      ///< 直接编码逻辑，每个状态一段带标号的代码，以goto转移
 };
 
+/**
+ * @brief 直接编码法中一个状态的出边区间
+ * 
+ * 字节low~high都转移到状态target
+ */
+typedef struct {
+    int low;     ///< 区间下界（0~255）
+    int high;    ///< 区间上界（0~255）
+    int target;  ///< 后继状态
+} DirectCodedRange;
+
+/**
+ * @brief 自环加速的字节集合
+ * 
+ * 状态在自环字节上转移回自身，生成的代码用SIMD一次比较16或32个字节跳过整段自环。
+ * 自环字节集合与其补集中区间较少的一方参与比较：
+ * stopSet为false时ranges为自环字节（命中继续），为true时ranges为补集（命中停止）
+ */
+typedef struct {
+    QList<CharRange> ranges;  ///< 参与比较的字节区间（0~255，已排序合并）
+    bool stopSet;             ///< ranges是否为停止字节
+} SelfLoopRun;
+
 /**
  * @brief 词法分析器生成器类
  * 
@@ -78,6 +103,34 @@ public:
      */
     bool saveTokenMap(const QList<RegexItem> &regexItems, const QString &outputPath);
     
+    /**
+     * @brief 保存编译后的词法分析器
+     * 
+     * 将最小化DFA写成可由CompiledLexer内存映射加载的二进制文件，
+     * 包含字节等价类表、行位移压缩的转移表（见DFATablePacker）、接受状态token代码表与规格哈希
+     * 
+     * @param regexItems 正则表达式项列表
+     * @param minimizedDFA 最小化的DFA
+     * @param specHash 规格文本哈希，见CompiledLexer::hashSpec
+     * @param outputPath 输出文件路径
+     * @return bool 保存成功返回true，失败返回false
+     */
+    bool saveCompiledLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA,
+                           quint64 specHash, const QString &outputPath);
+    
+    /**
+     * @brief 计算接受状态的token代码
+     * 
+     * 生成的词法分析器、编译后的二进制词法分析器与DFALexer共用
+     * 
+     * @param regexItems 正则表达式项列表
+     * @param minimizedDFA 最小化的DFA
+     * @param isAccept 输出参数，每个状态是否为接受状态
+     * @param tokens 输出参数，每个状态的token代码，未映射为-1
+     */
+    static void computeAcceptTokens(const QList<RegexItem> &regexItems, const DFA &minimizedDFA,
+                                    QVector<bool> &isAccept, QVector<int> &tokens);
+    
     /**
      * @brief 获取错误信息
      * 
@@ -102,13 +155,137 @@ private:
     /**
      * @brief 生成状态转移逻辑的词法分析器
      * 
-     * 生成基于状态转移表的词法分析器代码
+     * 生成基于状态转移表的词法分析器代码，状态转移函数getNextState按生成方法
+     * 由switch-case结构（STATE_TRANSITION）或查表（TABLE_DRIVEN）实现
      * 
      * @param regexItems 正则表达式项列表
      * @param minimizedDFA 最小化的DFA
+     * @param method 生成方法，STATE_TRANSITION或TABLE_DRIVEN
      * @return QString 生成的词法分析器代码
      */
-    QString generateStateTransitionLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA);
+    QString generateStateTransitionLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA,
+                                         GenerationMethod method);
+    
+    /**
+     * @brief 生成流式输入的公共部分
+     * 
+     * 状态转移法、表驱动法与直接编码法共用的头文件、源文件读入、单词输出与scanBlank函数
+     * 
+     * @return QString 生成的代码
+     */
+    QString generateStreamPrologue();
+    
+    /**
+     * @brief 生成源文件读入函数
+     * 
+     * 生成的loadSource对普通文件用mmap整体映射，对标准输入按大块读入，
+     * 词法分析器用原始指针扫描，单词以(偏移, 长度)表示
+     * 
+     * @return QString 生成的代码
+     */
+    QString generateSourceLoader();
+    
+    /**
+     * @brief 生成单词输出函数
+     * 
+     * 生成的emitToken把单词格式化到输出缓冲区，写满时一次fwrite写出；
+     * 命令行选项-b改为输出二进制单词流（"LXT1"加标志字节，之后每个单词为
+     * zigzag编码、与上一单词末尾的距离、长度的LEB128变长整数），
+     * -n在每行前附带行号（与LexerTester解析的三列格式一致），
+     * 行号由lineOf在首次调用时建立换行符偏移表后二分查找；
+     * -j指定分块并行识别的线程数（直接匹配法忽略该选项）
+     * 
+     * @return QString 生成的代码
+     */
+    QString generateTokenOutput();
+    
+    /**
+     * @brief 生成流式输入的主函数
+     * 
+     * 解析命令行选项并读入源文件（未指定时读标准输入），循环调用lexStep直到扫描到末尾，
+     * 输入足够大且-j指定了多个线程时改为分块并行识别，最后写出输出缓冲区中剩余的内容
+     * 
+     * @return QString 生成的lexStep、并行词法分析与main函数代码
+     */
+    QString generateStreamMain();
+    
+    /**
+     * @brief 生成分块并行的词法分析函数
+     * 
+     * 除第0块外各块由一个线程从块首推测识别，主线程按块依次拼接：
+     * 从上一块实际结束的位置顺序重新识别，直到落到推测结果中的单词起点为止
+     * 
+     * @return QString 生成的代码
+     */
+    QString generateParallelLexing();
+    
+    /**
+     * @brief 生成直接编码法的词法分析器
+     * 
+     * 每个最小化DFA状态生成一段带标号的代码，转移为区间比较加goto，
+     * 接受状态的token编码直接写在代码中，不生成状态转移表与接受状态表
+     * 
+     * @param regexItems 正则表达式项列表
+     * @param minimizedDFA 最小化的DFA
+     * @return QString 生成的词法分析器代码，失败时返回空字符串
+     */
+    QString generateDirectCodedLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA);
+    
+    /**
+     * @brief 生成直接编码法中一个状态的区间分派代码
+     * 
+     * @param ranges 按字节升序排列且互不相交的区间
+     * @param first 本次处理的第一个区间下标
+     * @param last 本次处理的最后一个区间下标
+     * @param isAccept 每个状态是否为接受状态
+     * @param depth 缩进层数
+     * @return QString 生成的分派代码
+     */
+    QString generateDirectCodedDispatch(const QList<DirectCodedRange> &ranges, int first, int last,
+                                        const QVector<bool> &isAccept, int depth);
+    
+    /**
+     * @brief 找出可以做自环加速的状态
+     * 
+     * 自环字节数不少于SELF_LOOP_MIN_BYTES，且自环字节集合或其补集
+     * 不超过SIMD_RUN_MAX_RANGES个区间的状态才加速
+     * 
+     * @param minimizedDFA 最小化的DFA
+     * @return QMap<DFAState, SelfLoopRun> 状态 -> 自环字节集合
+     */
+    QMap<DFAState, SelfLoopRun> collectSelfLoopRuns(const DFA &minimizedDFA);
+    
+    /**
+     * @brief 生成SIMD支持代码
+     * 
+     * 按编译器预定义宏选择AVX2/SSE2指令集，并生成跨编译器的lexerCountTrailingZeros
+     * 
+     * @return QString 生成的代码
+     */
+    QString generateSimdSupport();
+    
+    /**
+     * @brief 生成跳过一段字节的扫描函数
+     * 
+     * 生成的函数先以32字节（AVX2）、16字节（SSE2）步长比较，再逐字节处理剩余部分，
+     * 返回第一个不属于该段的字节位置
+     * 
+     * @param name 函数名
+     * @param run 字节集合
+     * @return QString 生成的扫描函数代码
+     */
+    QString generateRunScanner(const QString &name, const SelfLoopRun &run);
+    
+    /**
+     * @brief 生成各状态的自环扫描函数
+     * 
+     * 字节集合相同的状态共用同一个扫描函数
+     * 
+     * @param runs 状态 -> 自环字节集合
+     * @param scannerNames 输出参数，状态 -> 扫描函数名
+     * @return QString 生成的扫描函数代码
+     */
+    QString generateSelfLoopScanners(const QMap<DFAState, SelfLoopRun> &runs, QMap<DFAState, QString> &scannerNames);
     
     /**
      * @brief 生成DFA状态转移表
@@ -120,6 +297,35 @@ private:
      */
     QString generateStateTransitionTable(const DFA &minimizedDFA);
     
+    /**
+     * @brief 生成表驱动的状态转移表
+     * 
+     * 用DFATablePacker构建字节等价类映射与转移表：稠密表不超过DENSE_TABLE_LIMIT字节时
+     * 直接输出二维数组，否则输出行位移压缩的base/default/next/check数组。
+     * 元素类型按状态数选为unsigned char/short/int，ERROR_STATE取NUM_STATES
+     * 
+     * @param minimizedDFA 最小化的DFA
+     * @return QString 生成的转移表与getNextState函数代码，失败时返回空字符串
+     */
+    QString generateTableDrivenTransitions(const DFA &minimizedDFA);
+    
+    /**
+     * @brief 生成整数数组的初始化列表
+     * 
+     * @param values 数组元素
+     * @param perLine 每行元素个数
+     * @return QString 形如"{\n    1, 2,\n    3\n}"的初始化列表
+     */
+    static QString integerArrayInitializer(const QVector<qint32> &values, int perLine);
+    
+    /**
+     * @brief 获取指定字节数的无符号整数类型名
+     * 
+     * @param bytes 字节数：1、2或4
+     * @return QString C++类型名
+     */
+    static QString unsignedTypeName(int bytes);
+    
     /**
      * @brief 生成接受状态映射
      * 
@@ -131,6 +337,46 @@ private:
      */
     QString generateAcceptStatesMap(const QList<RegexItem> &regexItems, const DFA &minimizedDFA);
     
+    /**
+     * @brief 生成字符区间判断条件
+     * 
+     * 区间会先排序合并，超出单字节范围的部分被忽略，
+     * 例如 [0-9] 与 '.' 生成 (c >= '0' && c <= '9') || c == '.'
+     * 
+     * @param ranges 字符区间列表
+     * @param var 被判断的字符变量表达式（应为unsigned char）
+     * @return QString 判断条件，没有可匹配的字节时返回空字符串
+     */
+    QString generateCharCondition(const QList<CharRange> &ranges, const QString &var);
+    
+    /**
+     * @brief 生成字符的C++字面量
+     * 
+     * @param c 字符编码（0~255）
+     * @return QString 可打印字符返回'x'形式，其余返回十进制数值
+     */
+    QString charLiteral(ushort c);
+    
+    /**
+     * @brief 表驱动方法输出稠密转移表的大小上限（字节）
+     */
+    static constexpr int DENSE_TABLE_LIMIT = 64 * 1024;
+    
+    /**
+     * @brief 直接编码法逐个比较的区间数上限，超过时二分
+     */
+    static constexpr int DIRECT_CODED_LINEAR_LIMIT = 4;
+    
+    /**
+     * @brief 自环加速要求的最少自环字节数
+     */
+    static constexpr int SELF_LOOP_MIN_BYTES = 8;
+    
+    /**
+     * @brief 自环加速时SIMD比较的最多区间数
+     */
+    static constexpr int SIMD_RUN_MAX_RANGES = 4;
+    
     QString m_errorMessage;  ///< 错误信息
     QList<RegexItem> m_regexItems;  ///< 正则表达式列表
 };
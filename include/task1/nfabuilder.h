@@ -15,7 +15,9 @@
 #include <QSet>
 #include <QMap>
 #include <QHash>
+#include <QVector>
 #include "regexprocessor.h"
+#include "symboltable.h"
 
 /**
  * @brief NFA状态类型
@@ -31,29 +33,23 @@ typedef int NFAState;
  */
 typedef struct {
     NFAState fromState;  ///< 起始状态
-    QString input;       ///< 输入符号，空字符串表示epsilon转换
+    SymbolId input;      ///< 输入符号编号，SymbolTable::EPSILON表示epsilon转换
     NFAState toState;    ///< 目标状态
 } NFATransition;
 
 /**
  * @brief NFA结构
  * 
- * 表示非确定性有限自动机
+ * 表示非确定性有限自动机。构建与显示使用转换列表，
+ * 子集构造等算法使用由它冻结得到的CompactNFA
  */
 typedef struct {
     QList<NFAState> states;               ///< 所有状态列表
-    QSet<QString> alphabet;               ///< 字母表，所有可能的输入符号
+    QSet<SymbolId> alphabet;              ///< 字母表，所有可能的输入符号编号
     QList<NFATransition> transitions;     ///< 转换规则列表
     NFAState startState;                  ///< 起始状态
     QSet<NFAState> acceptStates;          ///< 接受状态集合
     
-    /**
-     * @brief 邻接表：state -> (symbol -> state集合)，用于优化算法
-     * 
-     * 优化后的转换表，提高状态转移查询效率
-     */
-    QHash<NFAState, QHash<QString, QSet<NFAState>>> transitionTable;
-    
     /**
      * @brief 接受状态到正则表达式索引的映射
      * 
@@ -62,6 +58,41 @@ typedef struct {
     QMap<NFAState, int> acceptStateToRegexIndex;
 } NFA;
 
+/**
+ * @brief 正则表达式语法树节点类型
+ */
+enum class RegexNodeType {
+    SYMBOL,            ///< 单个符号（字符或字符类），对应一个位置
+    EPSILON,           ///< 空串"#"，不占位置
+    CONCATENATION,     ///< 连接
+    CHOICE,            ///< 选择（|）
+    CLOSURE,           ///< 闭包（*）
+    POSITIVE_CLOSURE,  ///< 正闭包（+）
+    OPTIONAL           ///< 可选（?）
+};
+
+/**
+ * @brief 正则表达式语法树节点
+ */
+typedef struct {
+    RegexNodeType type;  ///< 节点类型
+    int left;            ///< 左子节点（一元运算的唯一子节点）下标，叶子为-1
+    int right;           ///< 右子节点下标，非二元运算为-1
+    SymbolId symbol;     ///< SYMBOL节点的输入符号编号
+} RegexNode;
+
+/**
+ * @brief 正则表达式语法树
+ * 
+ * 节点按后序存放：子节点的下标总是小于父节点，
+ * 且左子树中的SYMBOL节点都排在右子树之前，
+ * 供DFABuilder按followpos直接构造DFA使用
+ */
+typedef struct {
+    QVector<RegexNode> nodes;  ///< 节点数组
+    int root;                  ///< 根节点下标，解析失败时为-1
+} RegexSyntaxTree;
+
 /**
  * @brief NFA构建器类
  * 
@@ -88,6 +119,28 @@ public:
      */
     NFA buildNFA(const RegexItem &regexItem);
 
+    /**
+     * @brief 从正则表达式构建语法树
+     * 
+     * 与buildNFA使用相同的文法与转义规则，但不做Thompson构造，
+     * 语法树交给DFABuilder::convertRegexesToDFA直接构造DFA
+     * 
+     * @param regexItem 正则表达式项
+     * @return RegexSyntaxTree 构建的语法树，失败时root为-1
+     */
+    RegexSyntaxTree buildSyntaxTree(const RegexItem &regexItem);
+
+    /**
+     * @brief 合并多个NFA
+     * 
+     * 新建总起始状态，用ε转移连接各NFA的起始状态，
+     * 接受状态到正则表达式索引的映射随状态一起偏移
+     * 
+     * @param nfAs 要合并的NFA列表
+     * @return NFA 合并后的NFA，列表为空时返回空NFA
+     */
+    static NFA mergeNFAs(const QList<NFA> &nfAs);
+
     /**
      * @brief 获取构建过程中的错误信息
      * 
@@ -99,6 +152,8 @@ private:
     /**
      * @brief Thompson构造法：构建基本NFA（单个字符）
      * 
+     * 输入文本在此处驻留为符号编号
+     * 
      * @param input 输入字符
      * @return NFA 构建的基本NFA
      */
@@ -159,13 +214,41 @@ private:
     /**
      * @brief 处理字符集
      * 
-     * 构建字符集的NFA
+     * 构建字符集的NFA，整个字符集对应一条字符类转换，支持取反[^...]
      * 
      * @param charSet 字符集
      * @return NFA 字符集的NFA
      */
     NFA buildCharacterSetNFA(const QString &charSet);
 
+    /**
+     * @brief 解析字符集为字符类符号
+     * 
+     * @param charSet 字符集（包含方括号）
+     * @return SymbolId 字符类符号，失败时返回INVALID并设置错误信息
+     */
+    SymbolId parseCharacterSet(const QString &charSet);
+
+    /**
+     * @brief 驻留单个字符符号
+     * 
+     * 不区分大小写时，字母被驻留为同时包含大小写形式的字符类
+     * 
+     * @param input 字符
+     * @return SymbolId 符号编号，符号表已满时返回INVALID
+     */
+    SymbolId internSymbol(const QString &input);
+
+    /**
+     * @brief 对字符区间做大小写折叠
+     * 
+     * 不区分大小写时，为区间中的ASCII字母补上另一种大小写形式；区分大小写时原样返回
+     * 
+     * @param ranges 字符区间列表
+     * @return QList<CharRange> 折叠后的字符区间列表
+     */
+    QList<CharRange> foldCaseRanges(const QList<CharRange> &ranges) const;
+
     /**
      * @brief 解析正则表达式并构建NFA
      * 
@@ -216,6 +299,63 @@ private:
      */
     NFA parsePrimary(const QString &regex, int &pos, QString &error);
 
+    /**
+     * @brief 向语法树追加节点
+     * 
+     * @param tree 语法树
+     * @param type 节点类型
+     * @param left 左子节点下标
+     * @param right 右子节点下标
+     * @param symbol 输入符号编号
+     * @return int 新节点下标
+     */
+    int addSyntaxNode(RegexSyntaxTree &tree, RegexNodeType type, int left, int right,
+                      SymbolId symbol = SymbolTable::EPSILON);
+
+    /**
+     * @brief 解析选择操作并构建语法树节点
+     * 
+     * @param regex 正则表达式字符串
+     * @param pos 当前解析位置，会被修改
+     * @param error 错误信息输出
+     * @param tree 语法树
+     * @return int 节点下标
+     */
+    int parseChoiceNode(const QString &regex, int &pos, QString &error, RegexSyntaxTree &tree);
+
+    /**
+     * @brief 解析连接操作并构建语法树节点
+     * 
+     * @param regex 正则表达式字符串
+     * @param pos 当前解析位置，会被修改
+     * @param error 错误信息输出
+     * @param tree 语法树
+     * @return int 节点下标
+     */
+    int parseConcatenationNode(const QString &regex, int &pos, QString &error, RegexSyntaxTree &tree);
+
+    /**
+     * @brief 解析闭包操作并构建语法树节点
+     * 
+     * @param regex 正则表达式字符串
+     * @param pos 当前解析位置，会被修改
+     * @param error 错误信息输出
+     * @param tree 语法树
+     * @return int 节点下标
+     */
+    int parseClosureNode(const QString &regex, int &pos, QString &error, RegexSyntaxTree &tree);
+
+    /**
+     * @brief 解析基本元素并构建语法树节点
+     * 
+     * @param regex 正则表达式字符串
+     * @param pos 当前解析位置，会被修改
+     * @param error 错误信息输出
+     * @param tree 语法树
+     * @return int 节点下标
+     */
+    int parsePrimaryNode(const QString &regex, int &pos, QString &error, RegexSyntaxTree &tree);
+
     /**
      * @brief 获取下一个可用状态
      * 
@@ -227,19 +367,11 @@ private:
      * @brief 重置状态计数器
      */
     void resetStateCounter();
-    
-    /**
-     * @brief 构建邻接表
-     * 
-     * 从转换规则列表构建优化的邻接表
-     * 
-     * @param nfa 要构建邻接表的NFA，会被修改
-     */
-    void buildTransitionTable(NFA &nfa);
 
 private:
     NFAState m_nextState;  ///< 下一个可用状态计数器
     QString m_errorMessage;  ///< 错误信息
+    bool m_caseInsensitive;  ///< 当前正则表达式是否不区分大小写
 };
 
 #endif // NFABUILDER_H
\ No newline at end of file
@@ -14,7 +14,11 @@
 #include <QList>
 #include <QSet>
 #include <QMap>
+#include <QHash>
+#include <QVector>
+#include <QPair>
 #include <QChar>
+#include <QStringList>
 
 /**
  * @brief 词法单元类型
@@ -119,6 +123,27 @@ typedef struct {
     QSet<NFAState> acceptStates;        ///< 接受状态集合
 } NFA;
 
+/**
+ * @brief Glushkov构造中子表达式的信息
+ * 
+ * 位置集合以64位掩码表示，第p位对应第p个消耗字符的叶子
+ */
+typedef struct {
+    quint64 first;   ///< 可作为第一个字符的位置
+    quint64 last;    ///< 可作为最后一个字符的位置
+    bool nullable;   ///< 是否可匹配空串
+} GlushkovInfo;
+
+/**
+ * @brief 字面量前缀信息
+ * 
+ * 子表达式的任何匹配都以strings中的某个字符串开头
+ */
+typedef struct {
+    QStringList strings;  ///< 前缀集合，为空表示没有字面量要求
+    bool complete;        ///< 子表达式是否恰好只匹配strings中的字符串
+} LiteralInfo;
+
 /**
  * @brief 正则表达式引擎类
  * 
@@ -179,6 +204,49 @@ public:
      */
     QString getErrorMessage() const;
     
+    /**
+     * @brief 设置是否允许位并行后端
+     * 
+     * 允许时compile()在模式的位置数（消耗字符的叶子数）不超过64时
+     * 自动选用Glushkov位置自动机的位并行模拟；默认允许
+     * 
+     * @param enabled 是否允许
+     */
+    void setBitParallelEnabled(bool enabled);
+    
+    /**
+     * @brief 是否正在使用位并行后端
+     * 
+     * @return bool 当前编译结果使用位并行匹配时返回true
+     */
+    bool isBitParallel() const;
+    
+    /**
+     * @brief 设置是否启用惰性DFA
+     * 
+     * 启用时匹配在首次访问时才构造DFA状态并缓存其转换，
+     * 缓存溢出过于频繁时自动退回NFA模拟；默认启用
+     * 
+     * @param enabled 是否启用
+     */
+    void setLazyDFAEnabled(bool enabled);
+    
+    /**
+     * @brief 是否启用惰性DFA
+     * 
+     * @return bool 启用返回true
+     */
+    bool isLazyDFAEnabled() const;
+    
+    /**
+     * @brief 设置惰性DFA缓存上限
+     * 
+     * 缓存的状态集合与转换表总量超过上限时清空缓存后继续构造
+     * 
+     * @param bytes 缓存上限（字节）
+     */
+    void setLazyDFACacheSize(int bytes);
+    
 private:
     /**
      * @brief 词法分析器
@@ -460,6 +528,242 @@ private:
      */
     QSet<NFAState> move(const NFA &nfa, const QSet<NFAState> &states, QChar input);
     
+    /**
+     * @brief 判断转换能否接受字符
+     * 
+     * 统一处理普通字符、.、字符集以及^、$位置条件，NFA模拟与惰性DFA共用
+     * 
+     * @param transition NFA转换
+     * @param c 输入字符
+     * @param atStart 字符是否位于匹配起始位置
+     * @param atEnd 字符是否为输入的最后一个字符
+     * @return bool 能接受返回true
+     */
+    bool transitionMatches(const NFATransition &transition, QChar c, bool atStart, bool atEnd) const;
+    
+    /**
+     * @brief 执行一次匹配
+     * 
+     * 启用惰性DFA时优先使用惰性DFA，放弃时退回NFA模拟
+     * 
+     * @param input 输入字符串
+     * @param startPos 匹配起始位置
+     * @param matchLength 输出参数，匹配长度
+     * @return bool 匹配成功返回true
+     */
+    bool runMatch(const QString &input, int startPos, int &matchLength);
+    
+    /**
+     * @brief 准备惰性DFA
+     * 
+     * 编译完成后按状态建立邻接表，并把输入字符划分为等价类
+     */
+    void prepareLazyDFA();
+    
+    /**
+     * @brief 清空惰性DFA缓存
+     */
+    void resetLazyDFA();
+    
+    /**
+     * @brief 获取字符所属的等价类
+     * 
+     * @param c 输入字符
+     * @return int 等价类编号，0表示未在模式中出现的字符
+     */
+    int lazyCharClass(QChar c) const;
+    
+    /**
+     * @brief 沿邻接表计算闭包
+     * 
+     * @param states 初始状态列表
+     * @param edges 每个状态的epsilon转换目标（正向或反向邻接表）
+     * @return QVector<NFAState> 按编号升序排列的闭包
+     */
+    QVector<NFAState> adjacencyClosure(const QVector<NFAState> &states,
+                                       const QVector<QVector<NFAState>> &edges) const;
+    
+    /**
+     * @brief 查找或加入惰性DFA状态
+     * 
+     * @param states 按编号升序排列的NFA状态集合
+     * @return int DFA状态编号，缓存已满时返回-1
+     */
+    int addLazyState(const QVector<NFAState> &states);
+    
+    /**
+     * @brief 计算并缓存惰性DFA转换
+     * 
+     * 缓存溢出时清空缓存并重新加入当前状态，此时state会被更新为新编号
+     * 
+     * @param state 当前DFA状态（输入输出参数）
+     * @param symbol 输入符号（字符等价类与位置条件的组合）
+     * @return int 目标状态；LAZY_DEAD表示无转换，LAZY_BAIL表示应退回NFA模拟
+     */
+    int computeLazyTransition(int &state, int symbol);
+    
+    /**
+     * @brief 求正向状态在一个字符上的后继集合
+     * 
+     * 搜索状态按线程起点分组，找到匹配后丢弃起点更晚的组并不再开始新线程
+     * 
+     * @param states 当前状态的NFA状态集合
+     * @param c 输入字符
+     * @param atStart 字符是否位于匹配起始位置
+     * @param atEnd 字符是否为输入的最后一个字符
+     * @return QVector<NFAState> 后继集合，为空表示没有转换
+     */
+    QVector<NFAState> lazyForwardStep(const QVector<NFAState> &states, QChar c, bool atStart, bool atEnd) const;
+    
+    /**
+     * @brief 求反向状态在一个字符上的后继集合
+     * 
+     * @param states 当前反向状态的NFA状态集合
+     * @param c 输入字符
+     * @param atEnd 字符是否为输入的最后一个字符
+     * @return QVector<NFAState> 后继集合，为空表示没有转换
+     */
+    QVector<NFAState> lazyReverseStep(const QVector<NFAState> &states, QChar c, bool atEnd) const;
+    
+    /**
+     * @brief 使用惰性DFA匹配
+     * 
+     * @param input 输入字符串
+     * @param startPos 匹配起始位置
+     * @param matchLength 输出参数，匹配长度
+     * @param completed 输出参数，为false表示惰性DFA已放弃，结果无效
+     * @return bool 匹配成功返回true
+     */
+    bool simulateLazyDFA(const QString &input, int startPos, int &matchLength, bool &completed);
+    
+    /**
+     * @brief 判断转换是否为^锚点
+     * 
+     * @param transition NFA转换
+     * @return bool 是^锚点（而不是取反字符集）返回true
+     */
+    bool isStartAnchor(const NFATransition &transition) const;
+    
+    /**
+     * @brief 查找最左起点处的最长匹配
+     * 
+     * 按当前后端选择位并行、惰性DFA（正向求结束位置，反向求起点）或NFA模拟
+     * 
+     * @param input 输入字符串
+     * @param startPos 输出参数，匹配起点
+     * @param matchEnd 输出参数，匹配结束位置（不含）
+     * @return bool 找到非空匹配返回true
+     */
+    bool findLeftmostLongest(const QString &input, int &startPos, int &matchEnd);
+    
+    /**
+     * @brief 记录线程起点的NFA搜索
+     * 
+     * 一遍正向扫描，每个NFA状态保留起点最早的线程，找到匹配后丢弃起点更晚的线程
+     * 
+     * @param input 输入字符串
+     * @param startPos 输出参数，匹配起点
+     * @param matchEnd 输出参数，匹配结束位置（不含）
+     * @return bool 找到非空匹配返回true
+     */
+    bool nfaSearch(const QString &input, int &startPos, int &matchEnd);
+    
+    /**
+     * @brief 使用无锚定惰性DFA求最左匹配的结束位置
+     * 
+     * @param input 输入字符串
+     * @param startBound 输出参数，匹配起点的下界
+     * @param completed 输出参数，为false表示惰性DFA已放弃，结果无效
+     * @return int 最左起点处最长匹配的结束位置，没有匹配返回-1
+     */
+    int lazySearchEnd(const QString &input, int &startBound, bool &completed);
+    
+    /**
+     * @brief 使用反向惰性DFA求最左匹配的起点
+     * 
+     * 从matchEnd向前扫描，状态为空或到达startBound时停止
+     * 
+     * @param input 输入字符串
+     * @param startBound 起点的下界
+     * @param matchEnd 最左匹配的结束位置
+     * @param completed 输出参数，为false表示惰性DFA已放弃，结果无效
+     * @return int 最左的匹配起点，没有返回-1
+     */
+    int lazyLeftmostStart(const QString &input, int startBound, int matchEnd, bool &completed);
+    
+    /**
+     * @brief 准备字面量前缀预筛选
+     * 
+     * 求出所有非空匹配必须以之开头的字面量集合，供搜索时跳过输入
+     */
+    void prepareLiteralPrefix();
+    
+    /**
+     * @brief 求子表达式的字面量前缀集合
+     * 
+     * @param node AST节点
+     * @return LiteralInfo 前缀集合及是否完整
+     */
+    LiteralInfo literalPrefixes(ASTNode *node);
+    
+    /**
+     * @brief 查找下一个可能的匹配起点
+     * 
+     * @param input 输入字符串
+     * @param from 起始查找位置
+     * @return int 不小于from且出现某个字面量前缀的最小位置，没有返回-1
+     */
+    int nextCandidate(const QString &input, int from) const;
+    
+    /**
+     * @brief 准备位并行后端
+     * 
+     * 位置数不超过64时构造Glushkov位置自动机及其按字节拆分的follow查找表
+     */
+    void prepareBitParallel();
+    
+    /**
+     * @brief 递归构造Glushkov位置自动机
+     * 
+     * @param node AST节点
+     * @param positions 位置 -> 叶子节点（输入输出参数）
+     * @param follow 每个位置的follow集合（输入输出参数）
+     * @param overflow 位置数超过64时置为true（输出参数）
+     * @return GlushkovInfo 子树的first、last集合及是否可空
+     */
+    GlushkovInfo buildGlushkov(ASTNode *node, QVector<ASTNode*> &positions,
+                               QVector<quint64> &follow, bool &overflow);
+    
+    /**
+     * @brief 求位置集合的follow并集
+     * 
+     * @param positions 位置集合
+     * @return quint64 各位置follow集合的并
+     */
+    quint64 followOf(quint64 positions) const;
+    
+    /**
+     * @brief 位并行匹配
+     * 
+     * @param input 输入字符串
+     * @param startPos 匹配起始位置
+     * @param matchLength 输出参数，匹配长度
+     * @return bool 匹配成功返回true
+     */
+    bool simulateBitParallel(const QString &input, int startPos, int &matchLength);
+    
+    /**
+     * @brief 位并行搜索最左起点处的最长匹配
+     * 
+     * 活跃位置按线程起点分组，直接得到起点与结束位置
+     * 
+     * @param input 输入字符串
+     * @param startPos 输出参数，匹配起点
+     * @param matchEnd 输出参数，匹配结束位置（不含）
+     * @return bool 找到非空匹配返回true
+     */
+    bool bitParallelSearch(const QString &input, int &startPos, int &matchEnd);
+    
     /**
      * @brief 检查是否为特殊字符
      * 
@@ -504,6 +808,48 @@ private:
     QString m_errorMessage;   ///< 错误信息
     bool m_isCompiled;        ///< 是否已编译
     int m_nextState;          ///< 用于生成新的NFA状态
+    
+    QMap<NFAState, QPair<QSet<QChar>, bool>> m_charSetInfo;  ///< 字符集转换起点 -> (字符集合, 是否取反)
+    QVector<QVector<NFAState>> m_epsilonTargets;             ///< 每个状态的epsilon转换目标
+    QVector<QVector<NFATransition>> m_labelTransitions;      ///< 每个状态的非epsilon转换
+    QVector<QVector<NFAState>> m_reverseEpsilon;             ///< 每个状态的反向epsilon转换来源
+    QVector<QVector<NFATransition>> m_reverseLabel;          ///< 以每个状态为目标的非epsilon转换
+    QVector<NFAState> m_startClosure;                        ///< 起始状态的epsilon闭包（升序）
+    QVector<bool> m_inStartClosure;                          ///< 状态是否属于起始状态闭包
+    bool m_startAccepts;                                     ///< 起始状态闭包是否可接受（空匹配）
+    
+    QStringList m_literalPrefixes;               ///< 匹配必须以之开头的字面量集合
+    QVector<bool> m_prefixFirstLatin1;           ///< Latin-1字符是否为某个前缀的首字符
+    QSet<ushort> m_prefixFirstOther;             ///< 其余前缀首字符
+    bool m_hasPrefilter;                         ///< 是否启用字面量前缀预筛选
+    
+    bool m_bitParallelEnabled;                   ///< 是否允许位并行后端
+    bool m_bitParallel;                          ///< 当前是否使用位并行后端
+    int m_positionCount;                         ///< Glushkov位置数
+    int m_followChunks;                          ///< 位置集合的字节数（查找表个数）
+    quint64 m_firstMask;                         ///< first位置集合
+    quint64 m_lastMask;                          ///< last位置集合
+    quint64 m_caretMask;                         ///< ^位置集合
+    quint64 m_dollarMask;                        ///< $位置集合
+    QVector<quint64> m_followTable;              ///< 按字节拆分的follow查找表
+    QVector<quint64> m_classMask;                ///< 每个字符等价类可接受的位置
+    
+    bool m_lazyEnabled;                          ///< 是否启用惰性DFA
+    int m_lazyCacheLimit;                        ///< 惰性DFA缓存上限（字节）
+    qint64 m_lazyCacheBytes;                     ///< 惰性DFA缓存当前占用（估算）
+    QVector<int> m_latin1Class;                  ///< Latin-1字符 -> 等价类
+    QHash<ushort, int> m_charClass;              ///< 其余出现在模式中的字符 -> 等价类
+    QVector<QChar> m_classRepresentative;        ///< 每个等价类的代表字符
+    int m_lazyContextCount;                      ///< 位置条件组合数（模式含^或$时为4，否则为1）
+    int m_lazySymbolCount;                       ///< 每个DFA状态的转换表宽度
+    QVector<QVector<NFAState>> m_lazyStateSets;  ///< 惰性DFA状态 -> NFA状态集合
+    QHash<QVector<NFAState>, int> m_lazyStateIds; ///< NFA状态集合 -> 惰性DFA状态
+    QVector<bool> m_lazyAccept;                  ///< 惰性DFA状态是否接受
+    QVector<int> m_lazyNext;                     ///< 转换表，LAZY_UNKNOWN表示尚未计算
+    int m_lazyStart;                             ///< 惰性DFA起始状态，-1表示尚未构造
+    int m_lazyUnanchoredStart;                   ///< 无锚定搜索的起始状态，-1表示尚未构造
+    int m_lazyReverseStart;                      ///< 反向扫描的起始状态，-1表示尚未构造
+    int m_lazyCharsSinceFlush;                   ///< 上次清空缓存以来处理的字符数
 };
 
 #endif // REGEXENGINE_H
@@ -20,12 +20,13 @@
  * 
  * 表示单个正则表达式的完整信息，包括名称、模式、编码等
  */
-typedef struct {
+typedef struct RegexItem {
     QString name;          ///< 正则表达式名称
     QString pattern;       ///< 正则表达式模式
     int code;              ///< 单词编码
     bool isMultiWord;      ///< 是否为多单词模式
-    QStringList wordList;  ///< 匹配的完整单词列表
+    QStringList wordList;  ///< 匹配的完整单词列表（不区分大小写时为小写形式）
+    bool caseInsensitive = false;  ///< 是否不区分大小写，构建NFA时把字母转换为大小写字符类
 } RegexItem;
 
 /**
@@ -83,14 +84,15 @@ private:
     /**
      * @brief 验证命名规则
      * 
-     * 验证正则表达式名称是否符合规则，并提取编码和多单词标志
+     * 验证正则表达式名称是否符合规则，并提取编码、多单词标志和大小写标志
      * 
      * @param name 正则表达式名称
      * @param code 输出参数，存储提取的编码
      * @param isMultiWord 输出参数，存储是否为多单词
+     * @param caseInsensitive 输出参数，存储是否不区分大小写
      * @return bool 验证成功返回true，失败返回false
      */
-    bool validateName(const QString &name, int &code, bool &isMultiWord);
+    bool validateName(const QString &name, int &code, bool &isMultiWord, bool &caseInsensitive);
 
     /**
      * @brief 处理转义字符
@@ -132,16 +134,6 @@ private:
      */
     QStringList extractMultiWords(const QString &pattern);
     
-    /**
-     * @brief 生成所有可能的大小写组合
-     * 
-     * 为给定字符串生成所有可能的大小写组合
-     * 
-     * @param pattern 输入字符串
-     * @return QStringList 所有可能的大小写组合
-     */
-    static QStringList generateAllCaseCombinations(const QString &pattern);
-    
     /**
      * @brief 从分组的正则表达式中生成所有可能的单词变体
      * 
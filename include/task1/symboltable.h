@@ -0,0 +1,167 @@
+/*
+ * @file symboltable.h
+ * @id symboltable-h
+ * @brief 实现输入符号驻留表，将自动机转换上的符号文本映射为紧凑的整数编号
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QtGlobal>
+
+/**
+ * @brief 输入符号编号类型
+ * 
+ * NFA/DFA转换上的输入符号统一使用16位整数编号表示，
+ * 比较与哈希均为整数运算，不再涉及字符串
+ */
+typedef quint16 SymbolId;
+
+/**
+ * @brief 字符区间结构体
+ * 
+ * 表示闭区间[low, high]内的所有字符
+ */
+typedef struct {
+    ushort low;   ///< 区间下界（包含）
+    ushort high;  ///< 区间上界（包含）
+} CharRange;
+
+/**
+ * @brief 符号驻留表类
+ * 
+ * 全局唯一的符号表，负责符号文本与编号之间的双向映射。
+ * 编号从0开始连续分配，0固定表示空串"#"（ε转换）。
+ * NFABuilder在构建时驻留符号，后续的合并、子集构造、最小化与代码生成
+ * 全部基于编号进行，仅在显示或输出代码时通过text()还原文本。
+ * 
+ * 除单个字符外，符号也可以是字符类（一组字符区间），
+ * 字符类的文本由区间规范化生成，相同字符集合总是得到相同编号。
+ */
+class SymbolTable
+{
+public:
+    /**
+     * @brief 空串（ε）符号的编号
+     */
+    static constexpr SymbolId EPSILON = 0;
+
+    /**
+     * @brief 无效符号编号，表示查找失败或符号表已满
+     */
+    static constexpr SymbolId INVALID = 0xFFFF;
+
+    /**
+     * @brief 取反字符类的全集上界
+     * 
+     * 生成的词法分析器按字节读取输入，取反字符类在[0, 0xFF]内求补集
+     */
+    static constexpr ushort CLASS_UNIVERSE_MAX = 0xFF;
+
+    /**
+     * @brief 驻留符号文本
+     * 
+     * 若文本已存在则返回已有编号，否则分配新编号
+     * 
+     * @param text 符号文本
+     * @return SymbolId 符号编号，符号表已满时返回INVALID
+     */
+    static SymbolId intern(const QString &text);
+
+    /**
+     * @brief 驻留字符类符号
+     * 
+     * 区间会被排序合并，取反时在[0, CLASS_UNIVERSE_MAX]内求补集；
+     * 只包含一个字符的字符类与该字符的普通符号共用同一编号
+     * 
+     * @param ranges 字符区间列表
+     * @param negated 是否为取反字符类（[^...]）
+     * @return SymbolId 符号编号，字符集为空或符号表已满时返回INVALID
+     */
+    static SymbolId internClass(const QList<CharRange> &ranges, bool negated = false);
+
+    /**
+     * @brief 查找符号文本对应的编号，不分配新编号
+     * 
+     * @param text 符号文本
+     * @return SymbolId 符号编号，不存在时返回INVALID
+     */
+    static SymbolId lookup(const QString &text);
+
+    /**
+     * @brief 获取符号编号对应的文本
+     * 
+     * @param id 符号编号
+     * @return QString 符号文本，编号无效时返回空字符串
+     */
+    static QString text(SymbolId id);
+
+    /**
+     * @brief 获取符号所匹配的字符区间
+     * 
+     * 单字符符号返回只含一个字符的区间，空串符号返回空列表
+     * 
+     * @param id 符号编号
+     * @return QList<CharRange> 已排序且互不相交的字符区间
+     */
+    static QList<CharRange> ranges(SymbolId id);
+
+    /**
+     * @brief 判断符号是否匹配某个字符
+     * 
+     * @param id 符号编号
+     * @param c 字符编码
+     * @return bool 匹配返回true
+     */
+    static bool matches(SymbolId id, ushort c);
+
+    /**
+     * @brief 排序并合并重叠或相邻的区间
+     * 
+     * @param ranges 原始区间列表
+     * @return QList<CharRange> 规范化后的区间列表
+     */
+    static QList<CharRange> normalizeRanges(const QList<CharRange> &ranges);
+
+    /**
+     * @brief 获取已驻留的符号数量
+     * 
+     * @return int 符号数量（包含空串符号）
+     */
+    static int size();
+
+private:
+    /**
+     * @brief 构造函数，预先驻留空串符号
+     */
+    SymbolTable();
+
+    /**
+     * @brief 获取全局符号表实例
+     * 
+     * @return SymbolTable& 符号表实例
+     */
+    static SymbolTable &instance();
+
+    /**
+     * @brief 生成字符类的规范文本
+     * 
+     * 在正向写法与取反写法中选择较短的一种，如"[0-9]"、"[^\n]"
+     * 
+     * @param ranges 规范化后的区间列表
+     * @return QString 字符类文本
+     */
+    static QString classText(const QList<CharRange> &ranges);
+
+    QHash<QString, SymbolId> m_ids;     ///< 文本 -> 编号
+    QList<QString> m_texts;             ///< 编号 -> 文本
+    QList<QList<CharRange>> m_ranges;   ///< 编号 -> 字符区间
+};
+
+#endif // SYMBOLTABLE_H
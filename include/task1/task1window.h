@@ -13,6 +13,7 @@
 #include <QMainWindow>
 #include <QTableWidgetItem>
 #include <QTextEdit>
+#include <QCheckBox>
 #include "regexprocessor.h"
 #include "nfabuilder.h"
 #include "dfabuilder.h"
@@ -24,6 +25,23 @@ QT_BEGIN_NAMESPACE
 namespace Ui { class Task1Window; }
 QT_END_NAMESPACE
 
+/**
+ * @brief 构建缓存项
+ * 
+ * 保存单个正则表达式各阶段的产物，以展开后的模式文本为键；
+ * 模式不变时刷新直接复用，只有模式变化的正则表达式需要重新构建
+ */
+typedef struct {
+    int regexIndex;          ///< 产物中接受状态对应的正则表达式索引
+    bool hasNFA;             ///< 是否已缓存NFA
+    NFA nfa;                 ///< NFA
+    bool hasDFA;             ///< 是否已缓存DFA
+    bool dfaDirect;          ///< 缓存的DFA是否由语法树直接构造
+    DFA dfa;                 ///< DFA
+    bool hasMinimizedDFA;    ///< 是否已缓存最小化DFA（由缓存的DFA得到）
+    DFA minimizedDFA;        ///< 最小化DFA
+} AutomatonCacheEntry;
+
 /**
  * @brief 任务1窗口类
  * 
@@ -320,16 +338,6 @@ private:
      */
     void initTableWidget(QTableWidget *table, const QStringList &headers);
     
-    /**
-     * @brief 合并多个NFA
-     * 
-     * 将多个NFA合并为一个
-     * 
-     * @param nfAs 要合并的NFA列表
-     * @return NFA 合并后的NFA
-     */
-    NFA mergeNFAs(const QList<NFA> &nfAs);
-    
     /**
      * @brief 显示词法分析结果
      * 
@@ -395,6 +403,53 @@ private:
      * 重置所有图表的显示状态
      */
     void resetChartDisplayState();
+    
+    /**
+     * @brief 获取构建缓存项
+     * 
+     * @param item 正则表达式项
+     * @param regexIndex 正则表达式索引，与缓存中不同时改写已缓存产物
+     * @return AutomatonCacheEntry& 缓存项，不存在时新建空项
+     */
+    AutomatonCacheEntry &cacheEntry(const RegexItem &item, int regexIndex);
+    
+    /**
+     * @brief 获取正则表达式项的构建缓存键
+     * 
+     * @param item 正则表达式项
+     * @return QString 由大小写标志与展开后的模式组成的键
+     */
+    static QString cacheKey(const RegexItem &item);
+    
+    /**
+     * @brief 生成NFA
+     * 
+     * 为每个以下划线开头的正则表达式生成NFA并生成总NFA，
+     * 模式未变化的正则表达式复用构建缓存
+     * 
+     * @return int 生成的NFA数量
+     */
+    int buildNFAs();
+    
+    /**
+     * @brief 按当前构造方式生成DFA
+     * 
+     * 根据"直接构造DFA"复选框选择子集构造或followpos直接构造，
+     * 生成各正则表达式的DFA与总DFA，模式未变化的正则表达式复用构建缓存
+     * 
+     * @param elapsedMs 输出参数，构造耗时（毫秒）
+     * @return int 生成的单个DFA数量
+     */
+    int buildDFAs(qint64 &elapsedMs);
+    
+    /**
+     * @brief 生成最小化DFA
+     * 
+     * 最小化各正则表达式的DFA与总DFA，DFA未变化的复用构建缓存
+     * 
+     * @return int 生成的单个最小化DFA数量
+     */
+    int buildMinimizedDFAs();
 
 private:
     Ui::Task1Window *ui;                     ///< UI界面指针
@@ -409,6 +464,7 @@ private:
     LexerTester m_lexerTester;               ///< 词法分析器测试器
 
     QList<RegexItem> m_currentRegexItems;    ///< 正则表达式项列表
+    QString m_currentRegexText;              ///< 生成m_currentRegexItems的规格文本
     QMap<QString, NFA> m_nfaMap;             ///< NFA映射：正则表达式名称 -> NFA
     NFA m_totalNFA;                          ///< 总NFA
     QMap<QString, DFA> m_dfaMap;             ///< DFA映射：正则表达式名称 -> DFA
@@ -416,12 +472,19 @@ private:
     QMap<QString, DFA> m_minimizedDfaMap;    ///< 最小化DFA映射：正则表达式名称 -> 最小化DFA
     DFA m_totalMinimizedDFA;                 ///< 总最小化DFA
 
+    QHash<QString, AutomatonCacheEntry> m_buildCache; ///< 构建缓存：大小写标志与展开后的模式 -> 各阶段产物
+    QString m_nfaSignature;                  ///< 当前m_nfaMap的签名（各项名称、模式与索引）
+    QString m_totalNFAKey;                   ///< 生成总NFA时的签名
+    QString m_totalDFAKey;                   ///< 生成总DFA时的签名（含构造方式）
+    QString m_totalMinimizedDFAKey;          ///< 生成总最小化DFA时所用总DFA的签名
+
     QString m_currentRegexName;              ///< 当前选中的正则表达式名称
     bool m_isTotalView;                      ///< 是否为总表视图
 
     QTableWidget *m_dynamicTableNFA;         ///< 动态NFA表格
     QTableWidget *m_dynamicTableDFA;         ///< 动态DFA表格
     QTableWidget *m_dynamicTableMinDFA;      ///< 动态最小化DFA表格
+    QCheckBox *m_checkBoxDirectDFA;          ///< 是否由语法树直接构造DFA
 
     QList<LexicalResult> m_currentLexicalResults; ///< 词法分析结果
 };
@@ -0,0 +1,219 @@
+/*
+ * @file compactnfa.cpp
+ * @id compactnfa-cpp
+ * @brief 实现NFA到紧凑CSR形式的冻结
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#include "task1/compactnfa.h"
+#include <algorithm>
+#include <tuple>
+
+/**
+ * @brief 构造空的紧凑NFA
+ */
+CompactNFA::CompactNFA()
+    : m_stateCount(0)
+    , m_startState(0)
+    , m_labelOffsets(0)
+    , m_labelSymbols(0)
+    , m_labelTargets(0)
+    , m_epsilonOffsets(0)
+    , m_epsilonTargets(0)
+    , m_acceptInfo(0)
+    , m_originalStates(0)
+    , m_closureWords(0)
+{
+}
+
+/**
+ * @brief 从NFA构建紧凑NFA
+ * 
+ * 先将状态按原编号排序后重新编号，再对转换按(起点, 符号, 终点)排序去重，
+ * 最后一次性分配arena并填充各CSR数组
+ * 
+ * @param nfa 原始NFA
+ * @param symbolMap 符号重新标记表，为空时保持原符号
+ */
+CompactNFA::CompactNFA(const NFA &nfa, const QHash<SymbolId, QList<SymbolId>> &symbolMap)
+    : CompactNFA()
+{
+    // 收集所有状态（包括只出现在转换中的状态），按原编号排序
+    QList<NFAState> originals = nfa.states;
+    originals.append(nfa.startState);
+    for (const NFATransition &transition : nfa.transitions) {
+        originals << transition.fromState << transition.toState;
+    }
+    std::sort(originals.begin(), originals.end());
+    originals.erase(std::unique(originals.begin(), originals.end()), originals.end());
+    
+    QHash<NFAState, int> denseId;
+    denseId.reserve(originals.size());
+    for (int i = 0; i < originals.size(); ++i) {
+        denseId.insert(originals[i], i);
+    }
+    m_stateCount = originals.size();
+    m_startState = denseId.value(nfa.startState);
+    
+    // 收集转换：带标号转换按等价类展开，ε转换单独存放
+    typedef std::tuple<int, SymbolId, int> LabelEdge;
+    typedef std::pair<int, int> EpsilonEdge;
+    QVector<LabelEdge> labelEdges;
+    QVector<EpsilonEdge> epsilonEdges;
+    labelEdges.reserve(nfa.transitions.size());
+    for (const NFATransition &transition : nfa.transitions) {
+        int from = denseId.value(transition.fromState);
+        int to = denseId.value(transition.toState);
+        if (transition.input == SymbolTable::EPSILON) {
+            epsilonEdges.append(EpsilonEdge(from, to));
+        } else if (symbolMap.isEmpty()) {
+            labelEdges.append(LabelEdge(from, transition.input, to));
+        } else {
+            for (SymbolId symbol : symbolMap.value(transition.input)) {
+                labelEdges.append(LabelEdge(from, symbol, to));
+            }
+        }
+    }
+    std::sort(labelEdges.begin(), labelEdges.end());
+    labelEdges.erase(std::unique(labelEdges.begin(), labelEdges.end()), labelEdges.end());
+    std::sort(epsilonEdges.begin(), epsilonEdges.end());
+    epsilonEdges.erase(std::unique(epsilonEdges.begin(), epsilonEdges.end()), epsilonEdges.end());
+    
+    // 划分arena
+    int n = m_stateCount;
+    int labelCount = labelEdges.size();
+    int epsilonCount = epsilonEdges.size();
+    m_labelOffsets = 0;
+    m_labelSymbols = m_labelOffsets + n + 1;
+    m_labelTargets = m_labelSymbols + labelCount;
+    m_epsilonOffsets = m_labelTargets + labelCount;
+    m_epsilonTargets = m_epsilonOffsets + n + 1;
+    m_acceptInfo = m_epsilonTargets + epsilonCount;
+    m_originalStates = m_acceptInfo + n;
+    m_arena.resize(m_originalStates + n);
+    qint32 *arena = m_arena.data();
+    
+    // 填充带标号转换的CSR数组
+    int edge = 0;
+    for (int state = 0; state < n; ++state) {
+        arena[m_labelOffsets + state] = edge;
+        while (edge < labelCount && std::get<0>(labelEdges[edge]) == state) {
+            arena[m_labelSymbols + edge] = std::get<1>(labelEdges[edge]);
+            arena[m_labelTargets + edge] = std::get<2>(labelEdges[edge]);
+            ++edge;
+        }
+    }
+    arena[m_labelOffsets + n] = edge;
+    
+    // 填充ε转换的CSR数组
+    edge = 0;
+    for (int state = 0; state < n; ++state) {
+        arena[m_epsilonOffsets + state] = edge;
+        while (edge < epsilonCount && epsilonEdges[edge].first == state) {
+            arena[m_epsilonTargets + edge] = epsilonEdges[edge].second;
+            ++edge;
+        }
+    }
+    arena[m_epsilonOffsets + n] = edge;
+    
+    // 填充接受信息与原始编号
+    for (int state = 0; state < n; ++state) {
+        NFAState original = originals[state];
+        arena[m_originalStates + state] = original;
+        if (!nfa.acceptStates.contains(original)) {
+            arena[m_acceptInfo + state] = NOT_ACCEPT;
+        } else {
+            arena[m_acceptInfo + state] = nfa.acceptStateToRegexIndex.value(original, -1);
+        }
+    }
+}
+
+/**
+ * @brief 预计算每个状态的ε-闭包位集
+ * 
+ * 使用迭代版Tarjan算法求ε转换图的强连通分量，避免深递归导致栈溢出
+ */
+void CompactNFA::buildEpsilonClosures()
+{
+    const int n = m_stateCount;
+    m_closureWords = (n + 63) / 64;
+    m_closureRow.fill(-1, n);
+    m_closureBits.clear();
+    
+    QVector<int> index(n, -1);      // 访问序号
+    QVector<int> lowLink(n, 0);     // 能回溯到的最小访问序号
+    QVector<bool> onStack(n, false);
+    QVector<int> sccStack;          // Tarjan栈
+    QVector<std::pair<int, const qint32 *>> callStack; // 模拟递归：(状态, 下一条待访问的ε边)
+    int counter = 0;
+    
+    for (int root = 0; root < n; ++root) {
+        if (index[root] != -1) {
+            continue;
+        }
+        
+        index[root] = lowLink[root] = counter++;
+        sccStack.append(root);
+        onStack[root] = true;
+        callStack.append(std::make_pair(root, epsilonBegin(root)));
+        
+        while (!callStack.isEmpty()) {
+            int state = callStack.last().first;
+            const qint32 *&edge = callStack.last().second;
+            
+            if (edge != epsilonEnd(state)) {
+                int next = *edge++;
+                if (index[next] == -1) {
+                    // 未访问：进入下一层
+                    index[next] = lowLink[next] = counter++;
+                    sccStack.append(next);
+                    onStack[next] = true;
+                    callStack.append(std::make_pair(next, epsilonBegin(next)));
+                } else if (onStack[next]) {
+                    lowLink[state] = qMin(lowLink[state], index[next]);
+                }
+                continue;
+            }
+            
+            // 所有ε边处理完毕，返回上一层
+            callStack.removeLast();
+            if (!callStack.isEmpty()) {
+                int parent = callStack.last().first;
+                lowLink[parent] = qMin(lowLink[parent], lowLink[state]);
+            }
+            
+            if (lowLink[state] != index[state]) {
+                continue;
+            }
+            
+            // state是分量的根：弹出整个分量并计算其闭包
+            int row = m_closureBits.size() / qMax(m_closureWords, 1);
+            m_closureBits.resize(m_closureBits.size() + m_closureWords);
+            QVector<int> members;
+            int member;
+            do {
+                member = sccStack.takeLast();
+                onStack[member] = false;
+                m_closureRow[member] = row;
+                members.append(member);
+            } while (member != state);
+            
+            quint64 *bits = m_closureBits.data() + static_cast<qsizetype>(row) * m_closureWords;
+            for (int s : members) {
+                bits[s >> 6] |= Q_UINT64_C(1) << (s & 63);
+                // 后继分量已先完成（逆拓扑序），直接合并其闭包
+                for (const qint32 *it = epsilonBegin(s); it != epsilonEnd(s); ++it) {
+                    int successorRow = m_closureRow[*it];
+                    if (successorRow != row) {
+                        const quint64 *successor = m_closureBits.constData() + static_cast<qsizetype>(successorRow) * m_closureWords;
+                        for (int w = 0; w < m_closureWords; ++w) {
+                            bits[w] |= successor[w];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,278 @@
+/*
+ * @file compiledlexer.cpp
+ * @id compiledlexer-cpp
+ * @brief 实现编译后词法分析器的内存映射加载
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#include "task1/compiledlexer.h"
+#include <QByteArray>
+#include <cstring>
+
+/**
+ * @brief 构造函数
+ */
+CompiledLexer::CompiledLexer()
+    : m_data(nullptr)
+    , m_header(nullptr)
+    , m_byteClasses(nullptr)
+    , m_base(nullptr)
+    , m_defaults(nullptr)
+    , m_next(nullptr)
+    , m_check(nullptr)
+    , m_acceptTokens(nullptr)
+    , m_classCount(0)
+    , m_stateBytes(0)
+    , m_indexBytes(0)
+{
+}
+
+/**
+ * @brief 析构函数
+ * 
+ * 解除内存映射
+ */
+CompiledLexer::~CompiledLexer()
+{
+    unload();
+}
+
+/**
+ * @brief 以内存映射方式加载编译后的词法分析器
+ * 
+ * 只校验文件头（魔数、版本、字节序、各段偏移与大小），
+ * 校验通过后各表指针直接指向映射内存，加载耗时与状态数无关
+ * 
+ * @param path 文件路径
+ * @return bool 加载成功返回true
+ */
+bool CompiledLexer::load(const QString &path)
+{
+    unload();
+    m_errorMessage.clear();
+    
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorMessage = QString("无法打开文件 %1").arg(path);
+        return false;
+    }
+    
+    const qint64 size = m_file.size();
+    if (size < static_cast<qint64>(sizeof(CompiledLexerHeader))) {
+        m_errorMessage = "文件过小，不是有效的词法分析器文件";
+        unload();
+        return false;
+    }
+    
+    m_data = m_file.map(0, size);
+    if (!m_data) {
+        m_errorMessage = QString("无法映射文件 %1").arg(path);
+        unload();
+        return false;
+    }
+    
+    const CompiledLexerHeader *header = reinterpret_cast<const CompiledLexerHeader *>(m_data);
+    if (std::memcmp(header->magic, "BYYLLEX", 8) != 0) {
+        m_errorMessage = "魔数不匹配，不是有效的词法分析器文件";
+        unload();
+        return false;
+    }
+    if (header->byteOrderMark != 0x01020304u) {
+        m_errorMessage = "文件字节序与本机不一致";
+        unload();
+        return false;
+    }
+    if (header->version != FORMAT_VERSION || header->headerSize != sizeof(CompiledLexerHeader)) {
+        m_errorMessage = QString("不支持的文件版本 %1").arg(header->version);
+        unload();
+        return false;
+    }
+    
+    // 各段必须4字节对齐且完整落在文件内
+    const quint64 states = header->stateCount;
+    const quint64 classes = header->classCount;
+    const quint64 packedSize = header->packedSize;
+    const quint64 stateBytes = header->stateBytes;
+    const quint64 indexBytes = header->indexBytes;
+    const quint64 fileSize = static_cast<quint64>(size);
+    bool valid = header->fileSize == fileSize
+                 && states > 0 && classes > 0 && classes <= 256
+                 && header->startState >= 0 && static_cast<quint64>(header->startState) < states
+                 && (stateBytes == 1 || stateBytes == 2 || stateBytes == 4)
+                 && (indexBytes == 1 || indexBytes == 2 || indexBytes == 4)
+                 && header->byteClassOffset % 4 == 0
+                 && header->baseOffset % 4 == 0
+                 && header->defaultOffset % 4 == 0
+                 && header->nextOffset % 4 == 0
+                 && header->checkOffset % 4 == 0
+                 && header->acceptOffset % 4 == 0
+                 && header->byteClassOffset + 256ull <= fileSize
+                 && header->baseOffset + states * indexBytes <= fileSize
+                 && header->defaultOffset + states * stateBytes <= fileSize
+                 && header->nextOffset + packedSize * stateBytes <= fileSize
+                 && header->checkOffset + packedSize * stateBytes <= fileSize
+                 && header->acceptOffset + states * sizeof(qint32) <= fileSize;
+    if (!valid) {
+        m_errorMessage = "文件头中的段信息无效";
+        unload();
+        return false;
+    }
+    
+    m_header = header;
+    m_byteClasses = m_data + header->byteClassOffset;
+    m_base = m_data + header->baseOffset;
+    m_defaults = m_data + header->defaultOffset;
+    m_next = m_data + header->nextOffset;
+    m_check = m_data + header->checkOffset;
+    m_acceptTokens = reinterpret_cast<const qint32 *>(m_data + header->acceptOffset);
+    m_classCount = static_cast<int>(classes);
+    m_stateBytes = static_cast<int>(stateBytes);
+    m_indexBytes = static_cast<int>(indexBytes);
+    return true;
+}
+
+/**
+ * @brief 检查压缩表中的下标与状态编号不会越界
+ * 
+ * 字节等价类小于classCount，base加任意等价类落在next/check内，
+ * 默认状态小于所属状态（保证默认状态链终止），next与check中的状态编号有效
+ * 
+ * @return bool 有效返回true
+ */
+bool CompiledLexer::verify()
+{
+    if (!m_header) {
+        m_errorMessage = "词法分析器未加载";
+        return false;
+    }
+    
+    const int states = static_cast<int>(m_header->stateCount);
+    const qint64 packedSize = m_header->packedSize;
+    
+    for (int c = 0; c < 256; ++c) {
+        if (m_byteClasses[c] >= m_classCount) {
+            m_errorMessage = "压缩转移表无效";
+            return false;
+        }
+    }
+    for (int s = 0; s < states; ++s) {
+        const int defaultState = readState(m_defaults, s);
+        if (static_cast<qint64>(readIndex(m_base, s)) + m_classCount > packedSize
+            || defaultState < -1 || defaultState >= s) {
+            m_errorMessage = "压缩转移表无效";
+            return false;
+        }
+    }
+    for (qint64 i = 0; i < packedSize; ++i) {
+        const int next = readState(m_next, static_cast<int>(i));
+        const int check = readState(m_check, static_cast<int>(i));
+        if (next < -1 || next >= states || check < -1 || check >= states) {
+            m_errorMessage = "压缩转移表无效";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 解除内存映射并关闭文件
+ */
+void CompiledLexer::unload()
+{
+    if (m_data) {
+        m_file.unmap(m_data);
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_data = nullptr;
+    m_header = nullptr;
+    m_byteClasses = nullptr;
+    m_base = nullptr;
+    m_defaults = nullptr;
+    m_next = nullptr;
+    m_check = nullptr;
+    m_acceptTokens = nullptr;
+    m_classCount = 0;
+    m_stateBytes = 0;
+    m_indexBytes = 0;
+}
+
+/**
+ * @brief 是否已加载
+ * 
+ * @return bool 已加载返回true
+ */
+bool CompiledLexer::isLoaded() const
+{
+    return m_header != nullptr;
+}
+
+/**
+ * @brief 获取生成该文件时的规格哈希
+ * 
+ * @return quint64 规格哈希，未加载时返回0
+ */
+quint64 CompiledLexer::specHash() const
+{
+    return m_header ? m_header->specHash : 0;
+}
+
+/**
+ * @brief 获取DFA状态数
+ * 
+ * @return int 状态数，未加载时返回0
+ */
+int CompiledLexer::stateCount() const
+{
+    return m_header ? static_cast<int>(m_header->stateCount) : 0;
+}
+
+/**
+ * @brief 获取字节等价类数
+ * 
+ * @return int 等价类数，未加载时返回0
+ */
+int CompiledLexer::classCount() const
+{
+    return m_classCount;
+}
+
+/**
+ * @brief 获取起始状态
+ * 
+ * @return int 起始状态，未加载时返回DEAD_STATE
+ */
+int CompiledLexer::startState() const
+{
+    return m_header ? m_header->startState : DEAD_STATE;
+}
+
+/**
+ * @brief 获取错误信息
+ * 
+ * @return QString 错误信息
+ */
+QString CompiledLexer::getErrorMessage() const
+{
+    return m_errorMessage;
+}
+
+/**
+ * @brief 计算正则表达式规格文本的哈希
+ * 
+ * @param specText 规格文本
+ * @return quint64 64位FNV-1a哈希值
+ */
+quint64 CompiledLexer::hashSpec(const QString &specText)
+{
+    const QByteArray bytes = specText.toUtf8();
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+    for (int i = 0; i < bytes.size(); ++i) {
+        hash ^= static_cast<uchar>(bytes.at(i));
+        hash *= Q_UINT64_C(1099511628211);
+    }
+    return hash;
+}
@@ -8,8 +8,24 @@
  * @copyright Copyright (c) 2025 郭梓烽
  */
 #include "task1/dfabuilder.h"
+#include "task1/compactnfa.h"
 #include <QDebug>
+#include <QtAlgorithms>
+#include <QThread>
+#include <QThreadPool>
 #include <algorithm>
+#include <atomic>
+#include <climits>
+
+/**
+ * @brief 并行计算后继时每次领取的DFA状态数
+ */
+static const int SUBSET_CHUNK_SIZE = 16;
+
+/**
+ * @brief 一层的状态数达到该值时才启用多线程，层太小时线程调度开销大于收益
+ */
+static const int PARALLEL_MIN_LEVEL_SIZE = 64;
 
 /**
  * @brief 构造函数
@@ -18,6 +34,9 @@
  */
 DFABuilder::DFABuilder()
     : m_nextState(0)
+    , m_keepProvenance(false)
+    , m_threadCount(1)
+    , m_setWords(0)
 {
 }
 
@@ -33,7 +52,12 @@ DFABuilder::~DFABuilder()
 /**
  * @brief 将NFA转换为DFA
  * 
- * 使用子集构造法将非确定有限自动机(NFA)转换为确定有限自动机(DFA)
+ * 使用子集构造法将非确定有限自动机(NFA)转换为确定有限自动机(DFA)。
+ * NFA先按字母表等价类展开并冻结为紧凑CSR形式；DFA状态以ε-闭包位集表示，
+ * 位集连续存放在状态集合池中，并通过64位哈希和开放寻址表去重。
+ * 每个DFA状态只扫描一遍其成员的带标号转换，按等价类分桶求出全部后继。
+ * 状态按层处理，同一层的后继计算可由多个线程并行完成，新状态的登记
+ * 始终按创建顺序串行进行，结果与单线程构造完全一致
  * 
  * @param nfa 要转换的NFA
  * @return DFA 转换后的DFA
@@ -45,109 +69,722 @@ DFA DFABuilder::convertNFAToDFA(const NFA &nfa)
     
     DFA dfa;
     
-    // 构建DFA的字母表：收集NFA中所有非空转换字符
-    dfa.alphabet = nfa.alphabet;
-    // 额外检查NFA的所有转换，确保字母表包含所有必要字符
+    // 计算字母表等价类，DFA的字母表即为等价类集合
+    QSet<SymbolId> symbolSet = nfa.alphabet;
     for (const NFATransition &transition : nfa.transitions) {
-        if (transition.input != "#") {
-            dfa.alphabet.insert(transition.input);
+        if (transition.input != SymbolTable::EPSILON) {
+            symbolSet.insert(transition.input);
         }
     }
+    QList<SymbolId> sortedAlphabet;
+    QHash<SymbolId, QList<SymbolId>> symbolToClasses = computeCharClasses(symbolSet, sortedAlphabet);
+    dfa.alphabet = QSet<SymbolId>(sortedAlphabet.begin(), sortedAlphabet.end());
+    
+    // 冻结为紧凑NFA，转换按等价类展开，并预计算每个状态的ε-闭包
+    CompactNFA compact(nfa, symbolToClasses);
+    if (compact.stateCount() == 0) {
+        m_errorMessage = "NFA没有任何状态";
+        return dfa;
+    }
+    compact.buildEpsilonClosures();
+    const int words = compact.closureWords();
+    resetStateSets(words);
     
-    // 计算起始状态的ε-闭包
-    QSet<NFAState> startNFAStates;
-    startNFAStates.insert(nfa.startState);
-    QSet<NFAState> startClosure = epsilonClosure(nfa, startNFAStates);
+    // 等价类符号 -> 在有序字母表中的下标
+    QVector<int> classIndex(SymbolTable::size(), -1);
+    for (int i = 0; i < sortedAlphabet.size(); ++i) {
+        classIndex[sortedAlphabet[i]] = i;
+    }
+    const int classCount = sortedAlphabet.size();
     
-    // 标记起始状态为已访问
-    QMap<QList<NFAState>, DFAState> stateMap;
-    QList<QList<NFAState>> unprocessedStates;
+    // 接受状态位掩码，用于快速找出集合中编号最小的接受状态
+    QVector<quint64> acceptMask(words, 0);
+    for (int state = 0; state < compact.stateCount(); ++state) {
+        if (compact.isAccept(state)) {
+            acceptMask[state / 64] |= Q_UINT64_C(1) << (state % 64);
+        }
+    }
     
-    // 创建起始DFA状态
-    DFAState startDFAState = getNextState();
-    QList<NFAState> startClosureList(startClosure.begin(), startClosure.end());
-    std::sort(startClosureList.begin(), startClosureList.end());
-    stateMap[startClosureList] = startDFAState;
-    unprocessedStates.append(startClosureList);
+    // 创建起始DFA状态（起始状态的ε-闭包）
+    const quint64 *startBits = compact.epsilonClosure(compact.startState());
+    DFAState startDFAState = addStateSet(startBits, hashStateSet(startBits, words));
     dfa.states.append(startDFAState);
     dfa.startState = startDFAState;
+    markAcceptState(dfa, compact, acceptMask, startDFAState);
+    
+    const int threads = m_threadCount > 0 ? m_threadCount : qMax(1, QThread::idealThreadCount());
+    QVector<StateSuccessors> successors;
+    
+    // 按层处理：同一层的状态[levelBegin, levelEnd)互不依赖，先（可并行地）求出各自的后继集合，
+    // 再按(状态编号, 等价类)顺序合并登记新状态，编号与串行先进先出工作队列完全一致
+    int levelBegin = 0;
+    while (levelBegin < m_nextState) {
+        const int levelEnd = m_nextState;
+        const int levelSize = levelEnd - levelBegin;
+        if (successors.size() < levelSize) {
+            successors.resize(levelSize);
+        }
+        
+        // 工作线程从共享计数器按块领取状态；去重表在此阶段只读，已知集合直接解析为状态编号
+        std::atomic<int> nextIndex(0);
+        auto worker = [&]() {
+            QVector<quint64> targets(classCount * words, 0);
+            QVector<int> classStamp(classCount, 0);
+            QVector<int> touched;
+            int begin;
+            while ((begin = nextIndex.fetch_add(SUBSET_CHUNK_SIZE)) < levelSize) {
+                const int end = qMin(begin + SUBSET_CHUNK_SIZE, levelSize);
+                for (int i = begin; i < end; ++i) {
+                    computeSuccessors(compact, classIndex.constData(), levelBegin + i,
+                                      targets.data(), classStamp.data(), touched, successors[i]);
+                }
+            }
+        };
+        
+        if (threads > 1 && levelSize >= PARALLEL_MIN_LEVEL_SIZE) {
+            QThreadPool pool;
+            pool.setMaxThreadCount(threads);
+            for (int t = 0; t < threads; ++t) {
+                pool.start(worker);
+            }
+            pool.waitForDone();
+        } else {
+            worker();
+        }
+        
+        // 串行合并：未知集合按确定顺序登记为新状态
+        for (int i = 0; i < levelSize; ++i) {
+            const StateSuccessors &result = successors[i];
+            for (const SuccessorEdge &edge : result.edges) {
+                DFAState targetDFAState = edge.state;
+                if (targetDFAState == -1) {
+                    const quint64 *bits = result.bits.constData() + edge.offset;
+                    targetDFAState = findStateSet(bits, edge.hash);
+                    if (targetDFAState == -1) {
+                        targetDFAState = addStateSet(bits, edge.hash);
+                        dfa.states.append(targetDFAState);
+                        markAcceptState(dfa, compact, acceptMask, targetDFAState);
+                    }
+                }
+                
+                // 添加DFA转换
+                DFATransition transition;
+                transition.fromState = levelBegin + i;
+                transition.input = sortedAlphabet[edge.classIndex];
+                transition.toState = targetDFAState;
+                dfa.transitions.append(transition);
+            }
+        }
+        
+        levelBegin = levelEnd;
+    }
     
-    // 检查起始状态是否为接受状态
-    for (NFAState nfaState : startClosure) {
-        if (nfa.acceptStates.contains(nfaState)) {
-            dfa.acceptStates.insert(startDFAState);
-            // 设置起始状态的正则表达式索引
-            if (nfa.acceptStateToRegexIndex.contains(nfaState)) {
-                int regexIndex = nfa.acceptStateToRegexIndex[nfaState];
-                dfa.acceptStateToRegexIndex[startDFAState] = regexIndex;
+    // 记录状态来源（可选，换回原始NFA状态编号，按位顺序取出仍然有序）
+    if (m_keepProvenance) {
+        dfa.provenanceOffsets.reserve(m_nextState + 1);
+        dfa.provenanceOffsets.append(0);
+        for (DFAState state = 0; state < m_nextState; ++state) {
+            for (int w = 0; w < words; ++w) {
+                quint64 word = m_setPool[state * words + w];
+                while (word != 0) {
+                    dfa.provenanceStates.append(compact.originalState(w * 64 + qCountTrailingZeroBits(word)));
+                    word &= word - 1;
+                }
             }
-            break;
+            dfa.provenanceOffsets.append(dfa.provenanceStates.size());
         }
     }
     
-    // 处理所有未处理的状态
-    while (!unprocessedStates.isEmpty()) {
-        QList<NFAState> currentNFAStatesList = unprocessedStates.takeFirst();
-        DFAState currentDFAState = stateMap[currentNFAStatesList];
-        QSet<NFAState> currentNFAStates(currentNFAStatesList.begin(), currentNFAStatesList.end());
+    resetStateSets(0);
+    return dfa;
+}
+
+/**
+ * @brief 由正则表达式语法树直接构造DFA
+ * 
+ * 位置编号：所有树的SYMBOL节点按树的顺序依次编号，其后是每棵树的结束标记位置。
+ * 语法树按后序存放且左子树的位置总是小于右子树，因此firstpos/lastpos列表
+ * 只需按子节点顺序拼接即保持有序。followpos以位集保存，DFA状态的位置集合
+ * 复用子集构造的集合池与去重表
+ * 
+ * @param trees 语法树列表
+ * @param regexIndices 每棵树对应的正则表达式索引
+ * @return DFA 构造得到的DFA
+ */
+DFA DFABuilder::convertRegexesToDFA(const QList<RegexSyntaxTree> &trees, const QList<int> &regexIndices)
+{
+    resetStateCounter();
+    m_errorMessage.clear();
+    
+    DFA dfa;
+    if (trees.isEmpty()) {
+        m_errorMessage = "没有任何正则表达式";
+        return dfa;
+    }
+    
+    // 为SYMBOL节点分配位置，收集字母表
+    QList<QVector<int>> nodePositions;
+    QVector<SymbolId> positionSymbol;
+    QSet<SymbolId> symbolSet;
+    for (const RegexSyntaxTree &tree : trees) {
+        if (tree.root < 0) {
+            m_errorMessage = "语法树为空";
+            return dfa;
+        }
+        QVector<int> positions(tree.nodes.size(), -1);
+        for (int i = 0; i < tree.nodes.size(); ++i) {
+            if (tree.nodes[i].type == RegexNodeType::SYMBOL) {
+                positions[i] = positionSymbol.size();
+                positionSymbol.append(tree.nodes[i].symbol);
+                symbolSet.insert(tree.nodes[i].symbol);
+            }
+        }
+        nodePositions.append(positions);
+    }
+    const int endBase = positionSymbol.size();
+    const int positionCount = endBase + trees.size();
+    const int words = (positionCount + 63) / 64;
+    
+    auto setBit = [](quint64 *bits, int position) {
+        bits[position / 64] |= Q_UINT64_C(1) << (position % 64);
+    };
+    
+    // 逐棵树计算nullable/firstpos/lastpos，并累积followpos；起始集合为各树firstpos之并
+    QVector<quint64> followPos(positionCount * words, 0);
+    QVector<quint64> startBits(words, 0);
+    for (int t = 0; t < trees.size(); ++t) {
+        const QVector<RegexNode> &nodes = trees[t].nodes;
+        const QVector<int> &positions = nodePositions[t];
+        QVector<bool> nullable(nodes.size(), false);
+        QVector<QVector<int>> firstPos(nodes.size());
+        QVector<QVector<int>> lastPos(nodes.size());
         
-        // 对每个输入字符
-        for (const QString &input : dfa.alphabet) {
-            if (input == "#") continue; // 跳过空串
-            
-            // 计算move(currentNFAStates, input)
-            QSet<NFAState> moveResult = move(nfa, currentNFAStates, input);
-            
-            // 计算moveResult的ε-闭包
-            QSet<NFAState> closureResult = epsilonClosure(nfa, moveResult);
-            
-            if (closureResult.isEmpty()) {
-                continue; // 没有转换，跳过
+        for (int i = 0; i < nodes.size(); ++i) {
+            const RegexNode &node = nodes[i];
+            switch (node.type) {
+            case RegexNodeType::SYMBOL:
+                firstPos[i].append(positions[i]);
+                lastPos[i].append(positions[i]);
+                break;
+            case RegexNodeType::EPSILON:
+                nullable[i] = true;
+                break;
+            case RegexNodeType::CHOICE:
+                nullable[i] = nullable[node.left] || nullable[node.right];
+                firstPos[i] = firstPos[node.left] + firstPos[node.right];
+                lastPos[i] = lastPos[node.left] + lastPos[node.right];
+                break;
+            case RegexNodeType::CONCATENATION:
+                nullable[i] = nullable[node.left] && nullable[node.right];
+                firstPos[i] = nullable[node.left] ? firstPos[node.left] + firstPos[node.right]
+                                                  : firstPos[node.left];
+                lastPos[i] = nullable[node.right] ? lastPos[node.left] + lastPos[node.right]
+                                                  : lastPos[node.right];
+                // lastpos(左) 中每个位置之后可以接 firstpos(右)
+                for (int position : lastPos[node.left]) {
+                    quint64 *row = followPos.data() + position * words;
+                    for (int next : firstPos[node.right]) {
+                        setBit(row, next);
+                    }
+                }
+                break;
+            case RegexNodeType::CLOSURE:
+            case RegexNodeType::POSITIVE_CLOSURE:
+            case RegexNodeType::OPTIONAL:
+                nullable[i] = node.type != RegexNodeType::POSITIVE_CLOSURE || nullable[node.left];
+                firstPos[i] = firstPos[node.left];
+                lastPos[i] = lastPos[node.left];
+                if (node.type != RegexNodeType::OPTIONAL) {
+                    // 循环：lastpos中每个位置之后可以回到firstpos
+                    for (int position : lastPos[i]) {
+                        quint64 *row = followPos.data() + position * words;
+                        for (int next : firstPos[i]) {
+                            setBit(row, next);
+                        }
+                    }
+                }
+                break;
             }
-            
-            DFAState targetDFAState;
-            
-            // 检查这个闭包是否已经映射到DFA状态
-            QList<NFAState> closureResultList(closureResult.begin(), closureResult.end());
-            std::sort(closureResultList.begin(), closureResultList.end());
-            if (stateMap.contains(closureResultList)) {
-                targetDFAState = stateMap[closureResultList];
-            } else {
-                // 创建新的DFA状态
-                targetDFAState = getNextState();
-                stateMap[closureResultList] = targetDFAState;
-                unprocessedStates.append(closureResultList);
-                dfa.states.append(targetDFAState);
-                
-                // 检查是否为接受状态
-            for (NFAState nfaState : closureResult) {
-                if (nfa.acceptStates.contains(nfaState)) {
-                    dfa.acceptStates.insert(targetDFAState);
-                    // 设置接受状态的正则表达式索引
-                    if (nfa.acceptStateToRegexIndex.contains(nfaState)) {
-                        int regexIndex = nfa.acceptStateToRegexIndex[nfaState];
-                        dfa.acceptStateToRegexIndex[targetDFAState] = regexIndex;
+        }
+        
+        // 树末尾接结束标记位置
+        const int root = trees[t].root;
+        const int endPosition = endBase + t;
+        for (int position : lastPos[root]) {
+            setBit(followPos.data() + position * words, endPosition);
+        }
+        for (int position : firstPos[root]) {
+            setBit(startBits.data(), position);
+        }
+        if (nullable[root]) {
+            setBit(startBits.data(), endPosition);
+        }
+    }
+    
+    // 计算字母表等价类，并把每个位置的符号展开为其覆盖的等价类下标
+    QList<SymbolId> sortedAlphabet;
+    QHash<SymbolId, QList<SymbolId>> symbolToClasses = computeCharClasses(symbolSet, sortedAlphabet);
+    dfa.alphabet = QSet<SymbolId>(sortedAlphabet.begin(), sortedAlphabet.end());
+    const int classCount = sortedAlphabet.size();
+    
+    QHash<SymbolId, int> classIndex;
+    for (int i = 0; i < classCount; ++i) {
+        classIndex.insert(sortedAlphabet[i], i);
+    }
+    QVector<int> positionClassBegin(endBase + 1, 0);
+    QVector<int> positionClasses;
+    for (int position = 0; position < endBase; ++position) {
+        for (SymbolId classSymbol : symbolToClasses.value(positionSymbol[position])) {
+            positionClasses.append(classIndex.value(classSymbol));
+        }
+        positionClassBegin[position + 1] = positionClasses.size();
+    }
+    
+    // 含结束标记的集合为接受状态，优先级最高（见setTokenPriority）的正则表达式决定索引，
+    // 优先级相同时取编号最小的结束标记（排在前面的树）
+    auto markAccept = [&](DFAState state) {
+        const quint64 *bits = m_setPool.constData() + state * words;
+        bool accept = false;
+        int bestIndex = -1;
+        int bestRank = INT_MAX;
+        for (int position = endBase; position < positionCount; ++position) {
+            if (bits[position / 64] & (Q_UINT64_C(1) << (position % 64))) {
+                const int tree = position - endBase;
+                const int regexIndex = tree < regexIndices.size() ? regexIndices[tree] : -1;
+                const int rank = regexRank(regexIndex);
+                if (!accept || rank < bestRank) {
+                    bestIndex = regexIndex;
+                    bestRank = rank;
+                }
+                accept = true;
+            }
+        }
+        if (accept) {
+            dfa.acceptStates.insert(state);
+            if (bestIndex >= 0) {
+                dfa.acceptStateToRegexIndex[state] = bestIndex;
+            }
+        }
+    };
+    
+    resetStateSets(words);
+    DFAState startDFAState = addStateSet(startBits.constData(), hashStateSet(startBits.constData(), words));
+    dfa.states.append(startDFAState);
+    dfa.startState = startDFAState;
+    markAccept(startDFAState);
+    
+    // 先进先出处理：状态编号即处理顺序
+    QVector<quint64> targets(classCount * words, 0);
+    QVector<int> classStamp(classCount, 0);
+    QVector<int> touched;
+    for (DFAState state = 0; state < m_nextState; ++state) {
+        // 集合中每个位置按其等价类并入followpos
+        touched.clear();
+        const quint64 *bits = m_setPool.constData() + state * words;
+        for (int w = 0; w < words; ++w) {
+            quint64 word = bits[w];
+            while (word != 0) {
+                int position = w * 64 + qCountTrailingZeroBits(word);
+                word &= word - 1;
+                if (position >= endBase) {
+                    continue;
+                }
+                const quint64 *row = followPos.constData() + position * words;
+                for (int k = positionClassBegin[position]; k < positionClassBegin[position + 1]; ++k) {
+                    int cls = positionClasses[k];
+                    if (classStamp[cls] != state + 1) {
+                        classStamp[cls] = state + 1;
+                        touched.append(cls);
+                    }
+                    quint64 *target = targets.data() + cls * words;
+                    for (int i = 0; i < words; ++i) {
+                        target[i] |= row[i];
                     }
-                    break;
                 }
             }
+        }
+        
+        // 按字母表顺序登记后继，保证编号确定
+        std::sort(touched.begin(), touched.end());
+        for (int cls : touched) {
+            quint64 *target = targets.data() + cls * words;
+            quint64 hash = hashStateSet(target, words);
+            DFAState targetDFAState = findStateSet(target, hash);
+            if (targetDFAState == -1) {
+                targetDFAState = addStateSet(target, hash);
+                dfa.states.append(targetDFAState);
+                markAccept(targetDFAState);
             }
             
-            // 添加DFA转换
             DFATransition transition;
-            transition.fromState = currentDFAState;
-            transition.input = input;
+            transition.fromState = state;
+            transition.input = sortedAlphabet[cls];
             transition.toState = targetDFAState;
             dfa.transitions.append(transition);
+            
+            std::fill(target, target + words, 0);
         }
     }
     
+    resetStateSets(0);
+    return dfa;
+}
 
+/**
+ * @brief 设置子集构造时是否记录状态来源
+ * 
+ * @param keep 为true时填充DFA::provenanceOffsets/provenanceStates
+ */
+void DFABuilder::setKeepProvenance(bool keep)
+{
+    m_keepProvenance = keep;
+}
+
+/**
+ * @brief 子集构造时是否记录状态来源
+ * 
+ * @return bool 为true时填充状态来源
+ */
+bool DFABuilder::keepProvenance() const
+{
+    return m_keepProvenance;
+}
+
+/**
+ * @brief 按需计算DFA的状态来源
+ * 
+ * DFA的转换符号是由NFA符号细分出的等价类，取等价类的首字符即可判断NFA转换是否覆盖它。
+ * 不可达的状态没有来源，对应区间为空
+ * 
+ * @param nfa DFA对应的NFA
+ * @param dfa 要填充状态来源的DFA
+ */
+void DFABuilder::computeProvenance(const NFA &nfa, DFA &dfa) const
+{
+    dfa.provenanceOffsets.clear();
+    dfa.provenanceStates.clear();
     
-    // 保存状态映射
-    dfa.stateMap = stateMap;
+    CompactNFA compact(nfa);
+    if (compact.stateCount() == 0 || dfa.states.isEmpty()) {
+        return;
+    }
+    compact.buildEpsilonClosures();
+    const int words = compact.closureWords();
     
-    return dfa;
+    DFAState stateCount = 0;
+    for (DFAState state : dfa.states) {
+        stateCount = qMax(stateCount, state + 1);
+    }
+    QVector<QList<DFATransition>> outgoing(stateCount);
+    for (const DFATransition &transition : dfa.transitions) {
+        if (transition.fromState >= 0 && transition.fromState < stateCount) {
+            outgoing[transition.fromState].append(transition);
+        }
+    }
+    
+    // 每个DFA状态的NFA状态集合位集，visited标记是否已求出
+    QVector<quint64> sets(static_cast<qsizetype>(stateCount) * words, 0);
+    QVector<bool> visited(stateCount, false);
+    QList<DFAState> queue;
+    const quint64 *startBits = compact.epsilonClosure(compact.startState());
+    std::copy(startBits, startBits + words, sets.begin() + static_cast<qsizetype>(dfa.startState) * words);
+    visited[dfa.startState] = true;
+    queue.append(dfa.startState);
+    
+    for (int head = 0; head < queue.size(); ++head) {
+        const DFAState from = queue[head];
+        for (const DFATransition &transition : std::as_const(outgoing[from])) {
+            const DFAState to = transition.toState;
+            if (to < 0 || to >= stateCount || visited[to]) {
+                continue;
+            }
+            const QList<CharRange> ranges = SymbolTable::ranges(transition.input);
+            if (ranges.isEmpty()) {
+                continue;
+            }
+            const ushort c = ranges.first().low;
+            
+            quint64 *target = sets.data() + static_cast<qsizetype>(to) * words;
+            const quint64 *source = sets.constData() + static_cast<qsizetype>(from) * words;
+            for (int w = 0; w < words; ++w) {
+                quint64 word = source[w];
+                while (word != 0) {
+                    const int state = w * 64 + qCountTrailingZeroBits(word);
+                    word &= word - 1;
+                    for (int edge = compact.labelBegin(state); edge < compact.labelEnd(state); ++edge) {
+                        if (SymbolTable::matches(compact.labelSymbol(edge), c)) {
+                            const quint64 *closure = compact.epsilonClosure(compact.labelTarget(edge));
+                            for (int i = 0; i < words; ++i) {
+                                target[i] |= closure[i];
+                            }
+                        }
+                    }
+                }
+            }
+            visited[to] = true;
+            queue.append(to);
+        }
+    }
+    
+    dfa.provenanceOffsets.reserve(stateCount + 1);
+    dfa.provenanceOffsets.append(0);
+    for (DFAState state = 0; state < stateCount; ++state) {
+        for (int w = 0; w < words; ++w) {
+            quint64 word = sets[static_cast<qsizetype>(state) * words + w];
+            while (word != 0) {
+                dfa.provenanceStates.append(compact.originalState(w * 64 + qCountTrailingZeroBits(word)));
+                word &= word - 1;
+            }
+        }
+        dfa.provenanceOffsets.append(dfa.provenanceStates.size());
+    }
+}
+
+/**
+ * @brief 获取一个DFA状态对应的NFA状态集合
+ * 
+ * @param dfa DFA
+ * @param state DFA状态
+ * @return QList<NFAState> 升序的NFA状态，未记录状态来源时为空
+ */
+QList<NFAState> DFABuilder::provenanceOf(const DFA &dfa, DFAState state)
+{
+    QList<NFAState> result;
+    if (state < 0 || state + 1 >= dfa.provenanceOffsets.size()) {
+        return result;
+    }
+    for (int i = dfa.provenanceOffsets[state]; i < dfa.provenanceOffsets[state + 1]; ++i) {
+        result.append(dfa.provenanceStates[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief 设置子集构造使用的线程数
+ * 
+ * @param count 线程数，1为单线程，小于等于0表示使用QThread::idealThreadCount()
+ */
+void DFABuilder::setThreadCount(int count)
+{
+    m_threadCount = count;
+}
+
+/**
+ * @brief 获取子集构造使用的线程数
+ * 
+ * @return int 线程数设置
+ */
+int DFABuilder::threadCount() const
+{
+    return m_threadCount;
+}
+
+/**
+ * @brief 设置多个正则表达式同时接受时的优先级
+ * 
+ * 多单词项的优先级为其下标，其余项为项数加下标，
+ * 因此单词列表中的"int"总是优先于同样能匹配它的标识符模式
+ * 
+ * @param regexItems 正则表达式项列表
+ */
+void DFABuilder::setTokenPriority(const QList<RegexItem> &regexItems)
+{
+    const int count = regexItems.size();
+    m_regexRank = QVector<int>(count, 0);
+    for (int i = 0; i < count; ++i) {
+        m_regexRank[i] = regexItems[i].isMultiWord ? i : count + i;
+    }
+}
+
+/**
+ * @brief 获取正则表达式的接受优先级
+ * 
+ * @param regexIndex 正则表达式索引，-1表示未映射
+ * @return int 优先级，值越小越优先
+ */
+int DFABuilder::regexRank(int regexIndex) const
+{
+    if (regexIndex < 0) {
+        return INT_MAX;
+    }
+    if (regexIndex < m_regexRank.size()) {
+        return m_regexRank[regexIndex];
+    }
+    // 超出已设置范围的索引排在所有已设置的项之后
+    return m_regexRank.size() * 2 + regexIndex;
+}
+
+/**
+ * @brief 标注多单词正则表达式的接受状态
+ * 
+ * 单词中的"\x"按正则表达式的转义规则读作字符x。
+ * 同一正则表达式的不同单词可能到达同一个DFA状态（如直接构造法中它们共用一个结束位置），
+ * 因此对每个多单词项求DFA与其单词前缀树的乘积：沿单词路径的状态都复制一份，
+ * 路径上的转换改指向副本，单词结束处的副本再记录单词下标。
+ * 副本与原状态语言相同，多余的副本由最小化合并
+ * 
+ * @param dfa 要标注的DFA
+ * @param regexItems 正则表达式项列表
+ */
+void DFABuilder::labelWordAcceptStates(DFA &dfa, const QList<RegexItem> &regexItems) const
+{
+    dfa.acceptStateToWordIndex.clear();
+    
+    bool hasWords = false;
+    for (const RegexItem &item : regexItems) {
+        hasWords = hasWords || (item.isMultiWord && !item.wordList.isEmpty());
+    }
+    if (!hasWords || dfa.states.isEmpty()) {
+        return;
+    }
+    
+    QHash<DFAState, QList<DFATransition>> table;
+    DFAState nextState = 0;
+    for (DFAState state : dfa.states) {
+        nextState = qMax(nextState, state + 1);
+    }
+    for (const DFATransition &transition : dfa.transitions) {
+        table[transition.fromState].append(transition);
+    }
+    
+    // 复制状态的接受属性与出边
+    auto cloneState = [&](DFAState original, const QList<DFATransition> &edges) {
+        DFAState clone = nextState++;
+        dfa.states.append(clone);
+        if (dfa.acceptStates.contains(original)) {
+            dfa.acceptStates.insert(clone);
+        }
+        if (dfa.acceptStateToRegexIndex.contains(original)) {
+            dfa.acceptStateToRegexIndex.insert(clone, dfa.acceptStateToRegexIndex.value(original));
+        }
+        if (dfa.acceptStateToWordIndex.contains(original)) {
+            dfa.acceptStateToWordIndex.insert(clone, dfa.acceptStateToWordIndex.value(original));
+        }
+        if (clone + 1 == dfa.provenanceOffsets.size()) {
+            const QList<NFAState> nfaStates = provenanceOf(dfa, original);
+            for (NFAState nfaState : nfaStates) {
+                dfa.provenanceStates.append(nfaState);
+            }
+            dfa.provenanceOffsets.append(dfa.provenanceStates.size());
+        }
+        QList<DFATransition> &cloneEdges = table[clone];
+        for (DFATransition transition : edges) {
+            transition.fromState = clone;
+            cloneEdges.append(transition);
+        }
+        return clone;
+    };
+    
+    // 起始状态有入边时，入边改指向起始状态的副本，保证从起始状态出发的路径只对应完整的词素
+    bool startReentered = false;
+    for (const DFATransition &transition : dfa.transitions) {
+        startReentered = startReentered || transition.toState == dfa.startState;
+    }
+    if (startReentered) {
+        DFAState startCopy = cloneState(dfa.startState, table.value(dfa.startState));
+        for (auto it = table.begin(); it != table.end(); ++it) {
+            for (DFATransition &transition : it.value()) {
+                if (transition.toState == dfa.startState) {
+                    transition.toState = startCopy;
+                }
+            }
+        }
+    }
+    
+    for (int regexIndex = 0; regexIndex < regexItems.size(); ++regexIndex) {
+        const RegexItem &item = regexItems[regexIndex];
+        if (!item.isMultiWord) {
+            continue;
+        }
+        
+        // 单词前缀树，不区分大小写时按小写字符分支
+        QVector<QMap<ushort, int>> children(1);
+        QVector<int> wordAt(1, -1);
+        for (int wordIndex = 0; wordIndex < item.wordList.size(); ++wordIndex) {
+            const QString &word = item.wordList[wordIndex];
+            int node = 0;
+            for (int i = 0; i < word.length(); ++i) {
+                if (word.at(i) == '\\' && i + 1 < word.length()) {
+                    ++i;
+                }
+                ushort c = item.caseInsensitive ? word.at(i).toLower().unicode() : word.at(i).unicode();
+                int child = children[node].value(c, -1);
+                if (child < 0) {
+                    child = children.size();
+                    children.append(QMap<ushort, int>());
+                    wordAt.append(-1);
+                    children[node].insert(c, child);
+                }
+                node = child;
+            }
+            if (node > 0 && wordAt[node] < 0) {
+                wordAt[node] = wordIndex;
+            }
+        }
+        
+        // 乘积状态(DFA状态, 前缀树结点) -> 对应的DFA状态，(起始状态, 根)即起始状态本身
+        const QHash<DFAState, QList<DFATransition>> original = table;
+        QHash<QPair<DFAState, int>, DFAState> product;
+        QList<QPair<DFAState, int>> worklist;
+        product.insert(qMakePair(dfa.startState, 0), dfa.startState);
+        worklist.append(qMakePair(dfa.startState, 0));
+        
+        while (!worklist.isEmpty()) {
+            QPair<DFAState, int> current = worklist.takeLast();
+            const DFAState self = product.value(current);
+            const QList<DFATransition> originalEdges = original.value(current.first);
+            
+            for (auto child = children[current.second].constBegin(); child != children[current.second].constEnd(); ++child) {
+                QSet<ushort> chars = {child.key()};
+                if (item.caseInsensitive) {
+                    chars.insert(QChar(child.key()).toUpper().unicode());
+                }
+                
+                for (const DFATransition &edge : originalEdges) {
+                    bool hit = false;
+                    for (ushort c : std::as_const(chars)) {
+                        hit = hit || SymbolTable::matches(edge.input, c);
+                    }
+                    if (!hit) {
+                        continue;
+                    }
+                    
+                    // 符号还匹配单词以外的字符时不能改指向，否则那些字符也会被当作该单词
+                    bool covered = true;
+                    for (const CharRange &range : SymbolTable::ranges(edge.input)) {
+                        for (uint c = range.low; covered && c <= range.high; ++c) {
+                            covered = chars.contains(static_cast<ushort>(c));
+                        }
+                    }
+                    if (!covered) {
+                        continue;
+                    }
+                    
+                    QPair<DFAState, int> key(edge.toState, child.value());
+                    if (!product.contains(key)) {
+                        DFAState clone = cloneState(edge.toState, original.value(edge.toState));
+                        int wordIndex = wordAt[child.value()];
+                        if (wordIndex >= 0 && dfa.acceptStates.contains(clone)
+                            && dfa.acceptStateToRegexIndex.value(clone, -1) == regexIndex) {
+                            dfa.acceptStateToWordIndex.insert(clone, wordIndex);
+                        }
+                        product.insert(key, clone);
+                        worklist.append(key);
+                    }
+                    for (DFATransition &transition : table[self]) {
+                        if (transition.input == edge.input) {
+                            transition.toState = product.value(key);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    dfa.transitions.clear();
+    for (DFAState state : dfa.states) {
+        dfa.transitions.append(table.value(state));
+    }
 }
 
 /**
@@ -161,65 +798,291 @@ QString DFABuilder::getErrorMessage() const
 }
 
 /**
- * @brief 计算ε-闭包
+ * @brief 计算字母表等价类
  * 
- * 计算给定状态集合的ε-闭包，即从这些状态出发通过ε转换可达的所有状态
+ * NFA中的符号（单字符或字符类）可能互相重叠。收集所有符号的区间端点，
+ * 把字符空间切分为基本区间；覆盖符号集合相同的基本区间属于同一等价类
  * 
- * @param nfa 输入的NFA
- * @param states 初始状态集合
- * @return QSet<NFAState> ε-闭包结果
+ * @param symbolSet 出现过的所有非空符号
+ * @param classes 输出参数，按首字符升序排列的等价类符号
+ * @return QHash<SymbolId, QList<SymbolId>> 原始符号 -> 其覆盖的等价类符号
  */
-QSet<NFAState> DFABuilder::epsilonClosure(const NFA &nfa, const QSet<NFAState> &states)
+QHash<SymbolId, QList<SymbolId>> DFABuilder::computeCharClasses(const QSet<SymbolId> &symbolSet, QList<SymbolId> &classes)
 {
-    QSet<NFAState> closure = states;
-    QList<NFAState> toProcess(states.begin(), states.end());
+    classes.clear();
     
-    while (!toProcess.isEmpty()) {
-        NFAState currentState = toProcess.takeFirst();
-        
-        // 使用邻接表查找所有通过ε转换可达的状态
-        if (nfa.transitionTable.contains(currentState)) {
-            const QHash<QString, QSet<NFAState>> &transitions = nfa.transitionTable[currentState];
-            if (transitions.contains("#")) {
-                const QSet<NFAState> &epsilonStates = transitions["#"];
-                for (NFAState nextState : epsilonStates) {
-                    if (!closure.contains(nextState)) {
-                        closure.insert(nextState);
-                        toProcess.append(nextState);
-                    }
+    // 按编号排序，保证覆盖集合有序
+    QList<SymbolId> symbols(symbolSet.begin(), symbolSet.end());
+    std::sort(symbols.begin(), symbols.end());
+    
+    // 区间端点：每个区间贡献low和high+1
+    QHash<SymbolId, QList<CharRange>> symbolRanges;
+    QList<uint> bounds;
+    for (SymbolId symbol : symbols) {
+        QList<CharRange> ranges = SymbolTable::ranges(symbol);
+        for (const CharRange &range : ranges) {
+            bounds << range.low << static_cast<uint>(range.high) + 1;
+        }
+        symbolRanges.insert(symbol, ranges);
+    }
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    
+    // 计算每个基本区间[bounds[i], bounds[i+1])被哪些符号覆盖
+    int intervalCount = bounds.size() > 0 ? bounds.size() - 1 : 0;
+    QList<QList<SymbolId>> coverage(intervalCount);
+    for (SymbolId symbol : symbols) {
+        for (const CharRange &range : symbolRanges[symbol]) {
+            int index = std::lower_bound(bounds.begin(), bounds.end(), static_cast<uint>(range.low)) - bounds.begin();
+            for (; index < intervalCount && bounds[index] <= range.high; ++index) {
+                coverage[index].append(symbol);
+            }
+        }
+    }
+    
+    // 覆盖集合相同的基本区间合并为一个等价类
+    QMap<QList<SymbolId>, int> signatureToClass;
+    QList<QList<CharRange>> classRanges;
+    QList<int> intervalClass(intervalCount, -1);
+    for (int i = 0; i < intervalCount; ++i) {
+        if (coverage[i].isEmpty()) {
+            continue;
+        }
+        int classIndex = signatureToClass.value(coverage[i], -1);
+        if (classIndex == -1) {
+            classIndex = classRanges.size();
+            signatureToClass.insert(coverage[i], classIndex);
+            classRanges.append(QList<CharRange>());
+        }
+        classRanges[classIndex].append({static_cast<ushort>(bounds[i]), static_cast<ushort>(bounds[i + 1] - 1)});
+        intervalClass[i] = classIndex;
+    }
+    
+    // 驻留等价类符号，并记录每个原始符号覆盖的等价类
+    for (const QList<CharRange> &ranges : classRanges) {
+        classes.append(SymbolTable::internClass(ranges));
+    }
+    QHash<SymbolId, QList<SymbolId>> symbolToClasses;
+    for (SymbolId symbol : symbols) {
+        QList<SymbolId> &covered = symbolToClasses[symbol];
+        for (const CharRange &range : symbolRanges[symbol]) {
+            int index = std::lower_bound(bounds.begin(), bounds.end(), static_cast<uint>(range.low)) - bounds.begin();
+            for (; index < intervalCount && bounds[index] <= range.high; ++index) {
+                SymbolId classSymbol = classes[intervalClass[index]];
+                if (!covered.contains(classSymbol)) {
+                    covered.append(classSymbol);
                 }
             }
         }
     }
     
-    return closure;
+    return symbolToClasses;
+}
+
+/**
+ * @brief 标记接受状态
+ * 
+ * 集合与接受掩码求交，取优先级最高的正则表达式作为索引，
+ * 优先级相同时取编号最小的接受NFA状态
+ * 
+ * @param dfa 正在构建的DFA
+ * @param nfa 紧凑NFA
+ * @param acceptMask 接受状态位掩码
+ * @param state 新创建的DFA状态
+ */
+void DFABuilder::markAcceptState(DFA &dfa, const CompactNFA &nfa, const QVector<quint64> &acceptMask, DFAState state)
+{
+    const quint64 *bits = m_setPool.constData() + state * m_setWords;
+    bool accept = false;
+    int bestIndex = -1;
+    int bestRank = INT_MAX;
+    for (int w = 0; w < m_setWords; ++w) {
+        quint64 word = bits[w] & acceptMask[w];
+        while (word != 0) {
+            const int regexIndex = nfa.regexIndex(w * 64 + qCountTrailingZeroBits(word));
+            const int rank = regexRank(regexIndex);
+            if (!accept || rank < bestRank) {
+                bestIndex = regexIndex;
+                bestRank = rank;
+            }
+            accept = true;
+            word &= word - 1;
+        }
+    }
+    if (accept) {
+        dfa.acceptStates.insert(state);
+        if (bestIndex >= 0) {
+            dfa.acceptStateToRegexIndex[state] = bestIndex;
+        }
+    }
 }
 
 /**
- * @brief 计算move操作
+ * @brief 计算状态集合位集的64位哈希
  * 
- * 计算从给定状态集合出发，通过特定输入字符转换可达的所有状态
+ * @param bits 位集
+ * @param words 位集字数
+ * @return quint64 哈希值
+ */
+quint64 DFABuilder::hashStateSet(const quint64 *bits, int words)
+{
+    quint64 hash = Q_UINT64_C(0x9E3779B97F4A7C15) ^ static_cast<quint64>(words);
+    for (int w = 0; w < words; ++w) {
+        hash ^= bits[w];
+        hash *= Q_UINT64_C(0xFF51AFD7ED558CCD);
+        hash ^= hash >> 32;
+    }
+    hash ^= hash >> 33;
+    hash *= Q_UINT64_C(0xC4CEB9FE1A85EC53);
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * @brief 查找DFA状态集合
+ * 
+ * 在开放寻址表（线性探测）中按哈希查找相同的位集；只读操作，
+ * 并行计算后继时多个线程可同时调用
  * 
- * @param nfa 输入的NFA
- * @param states 初始状态集合
- * @param input 输入字符
- * @return QSet<NFAState> move操作结果
+ * @param bits 状态集合位集（m_setWords个字）
+ * @param hash 位集的哈希值
+ * @return DFAState 对应的DFA状态，不存在时返回-1
  */
-QSet<NFAState> DFABuilder::move(const NFA &nfa, const QSet<NFAState> &states, const QString &input)
+DFAState DFABuilder::findStateSet(const quint64 *bits, quint64 hash) const
 {
-    QSet<NFAState> result;
+    const int mask = m_setSlots.size() - 1;
+    const int *slots = m_setSlots.constData();
+    int slot = static_cast<int>(hash & static_cast<quint64>(mask));
+    while (slots[slot] != -1) {
+        DFAState state = slots[slot];
+        if (m_setHashes.at(state) == hash
+            && std::equal(bits, bits + m_setWords, m_setPool.constData() + state * m_setWords)) {
+            return state;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+/**
+ * @brief 登记新的DFA状态集合
+ * 
+ * 分配新的DFA状态编号，把位集追加到集合池并写入开放寻址表；
+ * 调用前需确认集合尚未登记
+ * 
+ * @param bits 状态集合位集（m_setWords个字）
+ * @param hash 位集的哈希值
+ * @return DFAState 新的DFA状态
+ */
+DFAState DFABuilder::addStateSet(const quint64 *bits, quint64 hash)
+{
+    DFAState state = getNextState();
+    m_setHashes.append(hash);
+    for (int w = 0; w < m_setWords; ++w) {
+        m_setPool.append(bits[w]);
+    }
     
-    for (NFAState state : states) {
-        // 使用邻接表查找所有通过input转换可达的状态
-        if (nfa.transitionTable.contains(state)) {
-            const QHash<QString, QSet<NFAState>> &transitions = nfa.transitionTable[state];
-            if (transitions.contains(input)) {
-                result.unite(transitions[input]);
+    // 装载因子保持在1/2以下
+    if (m_nextState * 2 > m_setSlots.size()) {
+        m_setSlots = QVector<int>(m_setSlots.size() * 2, -1);
+        const int mask = m_setSlots.size() - 1;
+        for (DFAState existing = 0; existing < state; ++existing) {
+            int slot = static_cast<int>(m_setHashes[existing] & static_cast<quint64>(mask));
+            while (m_setSlots[slot] != -1) {
+                slot = (slot + 1) & mask;
             }
+            m_setSlots[slot] = existing;
         }
     }
     
-    return result;
+    const int mask = m_setSlots.size() - 1;
+    int slot = static_cast<int>(hash & static_cast<quint64>(mask));
+    while (m_setSlots[slot] != -1) {
+        slot = (slot + 1) & mask;
+    }
+    m_setSlots[slot] = state;
+    
+    return state;
+}
+
+/**
+ * @brief 计算一个DFA状态的全部后继
+ * 
+ * 扫描集合中每个NFA状态的带标号转换，把目标的ε-闭包并入对应等价类的行，
+ * 然后按等价类顺序输出后继：已登记的集合直接记录状态编号，
+ * 其余集合连同哈希一起保存，留给合并阶段登记。
+ * 只读访问共享数据，可在工作线程中调用
+ * 
+ * @param nfa 紧凑NFA
+ * @param classIndex 等价类符号 -> 字母表下标
+ * @param state 要展开的DFA状态
+ * @param targets 工作区：每个等价类一行位集，调用前后均为全零
+ * @param classStamp 工作区：等价类最近一次出现时所属的状态编号加1
+ * @param touched 工作区：出现过的等价类下标
+ * @param result 输出参数，该状态的后继
+ */
+void DFABuilder::computeSuccessors(const CompactNFA &nfa, const int *classIndex, DFAState state,
+                                   quint64 *targets, int *classStamp, QVector<int> &touched,
+                                   StateSuccessors &result) const
+{
+    const int words = m_setWords;
+    const quint64 *bits = m_setPool.constData() + state * words;
+    result.edges.clear();
+    result.bits.clear();
+    touched.clear();
+    
+    for (int w = 0; w < words; ++w) {
+        quint64 word = bits[w];
+        while (word != 0) {
+            int nfaState = w * 64 + qCountTrailingZeroBits(word);
+            word &= word - 1;
+            for (int edge = nfa.labelBegin(nfaState); edge < nfa.labelEnd(nfaState); ++edge) {
+                int cls = classIndex[nfa.labelSymbol(edge)];
+                if (classStamp[cls] != state + 1) {
+                    classStamp[cls] = state + 1;
+                    touched.append(cls);
+                }
+                const quint64 *row = nfa.epsilonClosure(nfa.labelTarget(edge));
+                quint64 *target = targets + cls * words;
+                for (int k = 0; k < words; ++k) {
+                    target[k] |= row[k];
+                }
+            }
+        }
+    }
+    
+    // 按字母表顺序输出，保证合并阶段的编号确定
+    std::sort(touched.begin(), touched.end());
+    for (int cls : touched) {
+        quint64 *target = targets + cls * words;
+        SuccessorEdge edge;
+        edge.classIndex = cls;
+        edge.hash = hashStateSet(target, words);
+        edge.state = findStateSet(target, edge.hash);
+        edge.offset = -1;
+        if (edge.state == -1) {
+            edge.offset = result.bits.size();
+            for (int k = 0; k < words; ++k) {
+                result.bits.append(target[k]);
+            }
+        }
+        result.edges.append(edge);
+        
+        std::fill(target, target + words, 0);
+    }
+}
+
+/**
+ * @brief 重置状态集合池与去重表
+ * 
+ * @param words 每个状态集合位集的字数
+ */
+void DFABuilder::resetStateSets(int words)
+{
+    m_setWords = words;
+    m_setPool.clear();
+    m_setHashes.clear();
+    m_setSlots = QVector<int>(words > 0 ? 64 : 0, -1);
 }
 
 /**
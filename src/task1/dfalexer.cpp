@@ -0,0 +1,268 @@
+/*
+ * @file dfalexer.cpp
+ * @id dfalexer-cpp
+ * @brief 实现进程内词法分析器，包括按最长匹配识别单词与大输入的分块推测并行识别
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#include "task1/dfalexer.h"
+#include "task1/lexergenerator.h"
+#include "task1/compiledlexer.h"
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+
+/**
+ * @brief 并行识别时每块的字节数
+ */
+static const qint64 PARALLEL_CHUNK_BYTES = 1 << 20;
+
+/**
+ * @brief 构造函数
+ */
+DFALexer::DFALexer()
+    : m_built(false)
+    , m_threadCount(1)
+{
+}
+
+/**
+ * @brief 析构函数
+ */
+DFALexer::~DFALexer()
+{
+}
+
+/**
+ * @brief 由最小化DFA构建词法分析器
+ * 
+ * 转移表用DFATablePacker展开为按字节等价类索引的稠密表，
+ * 接受状态的token编码与生成的词法分析器一致（见LexerGenerator::computeAcceptTokens）
+ * 
+ * @param regexItems 正则表达式项列表
+ * @param minimizedDFA 最小化的DFA
+ * @return bool 构建成功返回true
+ */
+bool DFALexer::build(const QList<RegexItem> &regexItems, const DFA &minimizedDFA)
+{
+    m_errorMessage.clear();
+    m_built = false;
+    
+    DFATablePacker packer;
+    if (!packer.buildDenseTable(minimizedDFA, m_table)) {
+        m_errorMessage = packer.getErrorMessage();
+        return false;
+    }
+    
+    QVector<bool> isAccept;
+    QVector<int> tokens;
+    LexerGenerator::computeAcceptTokens(regexItems, minimizedDFA, isAccept, tokens);
+    m_acceptTokens = QVector<qint32>(m_table.stateCount, CompiledLexer::NOT_ACCEPT);
+    for (int state = 0; state < m_table.stateCount; ++state) {
+        if (isAccept[state]) {
+            m_acceptTokens[state] = tokens[state];
+        }
+    }
+    
+    m_built = true;
+    return true;
+}
+
+/**
+ * @brief 识别输入中的全部单词
+ * 
+ * 单线程时从头顺序识别。多线程时输入切成PARALLEL_CHUNK_BYTES字节的块，
+ * 工作线程从共享计数器领取块，从块首（跳过空白后）推测识别，直到单词起点不小于块尾；
+ * 之后按块依次拼接：扫描位置只由起点决定，上一块实际结束的位置若是本块推测结果中的单词起点，
+ * 其后的单词即为正确结果，否则从该位置顺序重新识别，直到落到推测结果的单词起点或越过本块。
+ * 最长匹配可能回退到任意远的位置，块边界处的DFA状态无法单独确定，因此以单词起点作为汇合点
+ * 
+ * @param source 输入字节
+ * @return QVector<LexedToken> 按偏移递增排列的单词
+ */
+QVector<LexedToken> DFALexer::tokenize(const QByteArray &source) const
+{
+    QVector<LexedToken> tokens;
+    if (!m_built) {
+        return tokens;
+    }
+    
+    const uchar *data = reinterpret_cast<const uchar *>(source.constData());
+    const qint64 size = source.size();
+    const int threads = m_threadCount > 0 ? m_threadCount : qMax(1, QThread::idealThreadCount());
+    const qint64 chunkCount = (size + PARALLEL_CHUNK_BYTES - 1) / PARALLEL_CHUNK_BYTES;
+    
+    if (threads <= 1 || chunkCount < 2) {
+        qint64 pos = skipBlank(data, size, 0);
+        while (pos < size) {
+            pos = lexStep(data, size, pos, tokens);
+        }
+        return tokens;
+    }
+    
+    // 各块推测识别，块0从输入开头开始，结果即为正确结果
+    QVector<Chunk> chunks(chunkCount);
+    for (qint64 i = 0; i < chunkCount; ++i) {
+        chunks[i].begin = i * PARALLEL_CHUNK_BYTES;
+        chunks[i].limit = qMin(size, (i + 1) * PARALLEL_CHUNK_BYTES);
+    }
+    std::atomic<qint64> nextChunk(0);
+    auto worker = [&]() {
+        qint64 i;
+        while ((i = nextChunk.fetch_add(1)) < chunkCount) {
+            lexChunk(data, size, chunks[i]);
+        }
+    };
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (int t = 0; t < threads; ++t) {
+        pool.start(worker);
+    }
+    pool.waitForDone();
+    
+    // 按块依次拼接
+    tokens = std::move(chunks[0].tokens);
+    qint64 pos = chunks[0].end;
+    for (qint64 i = 1; i < chunkCount; ++i) {
+        Chunk &chunk = chunks[i];
+        while (pos < chunk.limit) {
+            auto it = std::lower_bound(chunk.tokens.cbegin(), chunk.tokens.cend(), pos,
+                                       [](const LexedToken &token, qint64 value) {
+                return token.offset < value;
+            });
+            if (it != chunk.tokens.cend() && it->offset == pos) {
+                // 与推测结果汇合，其后的单词直接采用
+                for (; it != chunk.tokens.cend(); ++it) {
+                    tokens.append(*it);
+                }
+                pos = chunk.end;
+                break;
+            }
+            pos = lexStep(data, size, pos, tokens);
+        }
+        chunk.tokens = QVector<LexedToken>();
+    }
+    return tokens;
+}
+
+/**
+ * @brief 设置识别使用的线程数
+ * 
+ * @param count 线程数，1为单线程，小于等于0表示使用QThread::idealThreadCount()
+ */
+void DFALexer::setThreadCount(int count)
+{
+    m_threadCount = count;
+}
+
+/**
+ * @brief 获取识别使用的线程数
+ * 
+ * @return int 线程数设置
+ */
+int DFALexer::threadCount() const
+{
+    return m_threadCount;
+}
+
+/**
+ * @brief 获取错误信息
+ * 
+ * @return QString 错误信息
+ */
+QString DFALexer::getErrorMessage() const
+{
+    return m_errorMessage;
+}
+
+/**
+ * @brief 从start开始按最长匹配识别一个单词
+ * 
+ * @param data 输入起始地址
+ * @param size 输入字节数
+ * @param start 单词起点
+ * @param code 输出参数，token编码
+ * @return qint64 单词之后的位置，无法识别时返回-1
+ */
+qint64 DFALexer::lexToken(const uchar *data, qint64 size, qint64 start, int &code) const
+{
+    const quint8 *byteClasses = m_table.byteClasses.constData();
+    const qint32 *transitions = m_table.transitions.constData();
+    const int classCount = m_table.classCount;
+    
+    qint64 lastAcceptPos = -1;
+    int state = m_table.startState;
+    for (qint64 pos = start; pos < size; ++pos) {
+        state = transitions[state * classCount + byteClasses[data[pos]]];
+        if (state == -1) {
+            break;
+        }
+        if (m_acceptTokens[state] != CompiledLexer::NOT_ACCEPT) {
+            code = m_acceptTokens[state];
+            lastAcceptPos = pos + 1;
+        }
+    }
+    return lastAcceptPos;
+}
+
+/**
+ * @brief 识别一个单词（无法识别时跳过该字节）并跳过其后的空白字符
+ * 
+ * @param data 输入起始地址
+ * @param size 输入字节数
+ * @param pos 扫描位置
+ * @param tokens 识别出的单词追加到此列表
+ * @return qint64 下一扫描位置
+ */
+qint64 DFALexer::lexStep(const uchar *data, qint64 size, qint64 pos, QVector<LexedToken> &tokens) const
+{
+    int code = 0;
+    const qint64 end = lexToken(data, size, pos, code);
+    if (end != -1) {
+        tokens.append({code, pos, end - pos});
+        pos = end;
+    } else {
+        // 跳过无法识别的字节
+        ++pos;
+    }
+    return skipBlank(data, size, pos);
+}
+
+/**
+ * @brief 从块首推测识别一个块
+ * 
+ * 单词可以越过块尾，识别到单词起点不小于块尾为止
+ * 
+ * @param data 输入起始地址
+ * @param size 输入字节数
+ * @param chunk 块，识别结果写入tokens与end
+ */
+void DFALexer::lexChunk(const uchar *data, qint64 size, Chunk &chunk) const
+{
+    qint64 pos = skipBlank(data, size, chunk.begin);
+    while (pos < chunk.limit) {
+        pos = lexStep(data, size, pos, chunk.tokens);
+    }
+    chunk.end = pos;
+}
+
+/**
+ * @brief 跳过空白字符
+ * 
+ * 空白字符与isspace一致：'\t'~'\r'与空格
+ * 
+ * @param data 输入起始地址
+ * @param size 输入字节数
+ * @param pos 扫描位置
+ * @return qint64 第一个非空白字符的位置
+ */
+qint64 DFALexer::skipBlank(const uchar *data, qint64 size, qint64 pos)
+{
+    while (pos < size && (data[pos] == ' ' || (data[pos] >= '\t' && data[pos] <= '\r'))) {
+        ++pos;
+    }
+    return pos;
+}
@@ -9,6 +9,10 @@
  */
 #include "task1/dfaminimizer.h"
 #include <QDebug>
+#include <QHash>
+#include <QVector>
+#include <QPair>
+#include <algorithm>
 
 /**
  * @brief 构造函数
@@ -31,21 +35,24 @@ DFAMinimizer::~DFAMinimizer()
 /**
  * @brief 最小化DFA
  * 
- * 使用Hopcroft算法对输入的DFA进行最小化
+ * 去掉不可达状态后，使用Hopcroft算法对输入的DFA进行最小化
  * 
- * @param dfa 要最小化的DFA
+ * @param input 要最小化的DFA
  * @return DFA 最小化后的DFA
  */
-DFA DFAMinimizer::minimizeDFA(const DFA &dfa)
+DFA DFAMinimizer::minimizeDFA(const DFA &input)
 {
     m_errorMessage.clear();
     
     // 如果DFA为空，直接返回
-    if (dfa.states.isEmpty()) {
+    if (input.states.isEmpty()) {
         m_errorMessage = "输入DFA为空";
         return DFA();
     }
     
+    // 不可达的状态与任何可达状态都不等价时会各自留成一块，先去掉
+    const DFA dfa = removeUnreachableStates(input);
+    
     // 使用Hopcroft算法获取等价类划分
     QList<QSet<DFAState>> partitions = hopcroftAlgorithm(dfa);
     
@@ -71,32 +78,28 @@ DFA DFAMinimizer::minimizeDFA(const DFA &dfa)
     // 设置新的状态集合
     for (int i = 0; i < partitions.size(); ++i) {
         minimizedDFA.states.append(i);
-        
-        // 构建新的stateMap：收集该等价类中所有原始DFA状态对应的NFA状态集合
-        QSet<NFAState> combinedNfaStates;
-        
-        // 创建临时映射来快速查找原始DFA状态对应的NFA状态集合
-        QMap<DFAState, QList<NFAState>> tempDfaToNfaMap;
-        for (auto it = dfa.stateMap.constBegin(); it != dfa.stateMap.constEnd(); ++it) {
-            tempDfaToNfaMap[it.value()] = it.key();
-        }
-        
-        for (DFAState originalState : partitions[i]) {
-            // 如果找到了对应的NFA状态集合，就合并到combinedNfaStates中
-            if (tempDfaToNfaMap.contains(originalState)) {
-                const QList<NFAState> &nfaStates = tempDfaToNfaMap[originalState];
-                for (NFAState nfaState : nfaStates) {
-                    combinedNfaStates.insert(nfaState);
+    }
+    
+    // 合并状态来源：每个等价类的NFA状态集合为其中所有原始DFA状态来源的并集
+    // （构建DFA时未记录状态来源则跳过，需要时由DFABuilder::computeProvenance按需计算）
+    if (!dfa.provenanceOffsets.isEmpty()) {
+        minimizedDFA.provenanceOffsets.reserve(partitions.size() + 1);
+        minimizedDFA.provenanceOffsets.append(0);
+        for (int i = 0; i < partitions.size(); ++i) {
+            QVector<NFAState> combinedNfaStates;
+            for (DFAState originalState : partitions[i]) {
+                if (originalState < 0 || originalState + 1 >= dfa.provenanceOffsets.size()) {
+                    continue;
+                }
+                for (int k = dfa.provenanceOffsets[originalState]; k < dfa.provenanceOffsets[originalState + 1]; ++k) {
+                    combinedNfaStates.append(dfa.provenanceStates[k]);
                 }
             }
+            std::sort(combinedNfaStates.begin(), combinedNfaStates.end());
+            combinedNfaStates.erase(std::unique(combinedNfaStates.begin(), combinedNfaStates.end()), combinedNfaStates.end());
+            minimizedDFA.provenanceStates.append(combinedNfaStates);
+            minimizedDFA.provenanceOffsets.append(minimizedDFA.provenanceStates.size());
         }
-        
-        // 将合并后的NFA状态集合转换为列表并排序
-        QList<NFAState> combinedNfaStatesList = combinedNfaStates.values();
-        std::sort(combinedNfaStatesList.begin(), combinedNfaStatesList.end());
-        
-        // 设置最小化DFA的stateMap
-        minimizedDFA.stateMap[combinedNfaStatesList] = i;
     }
     
     // 设置新的接受状态集合，添加边界检查
@@ -110,6 +113,9 @@ DFA DFAMinimizer::minimizeDFA(const DFA &dfa)
                 int regexIndex = dfa.acceptStateToRegexIndex[state];
                 minimizedDFA.acceptStateToRegexIndex[newState] = regexIndex;
             }
+            if (dfa.acceptStateToWordIndex.contains(state)) {
+                minimizedDFA.acceptStateToWordIndex[newState] = dfa.acceptStateToWordIndex[state];
+            }
         } else {
             // 记录错误，但继续执行
             m_errorMessage += QString("警告：接受状态 %1 不在状态映射中\n").arg(state);
@@ -129,14 +135,12 @@ DFA DFAMinimizer::minimizeDFA(const DFA &dfa)
     }
     
     // 构建邻接表来加速转换查找
-    QHash<DFAState, QHash<QString, DFAState>> transitionTable;
+    QHash<DFAState, QHash<SymbolId, DFAState>> transitionTable;
     for (const DFATransition &t : dfa.transitions) {
         transitionTable[t.fromState][t.input] = t.toState;
     }
     
     // 构建新的转换表
-    QSet<QString> processedTransitions;
-    
     // 遍历所有等价类和输入字符，确保生成所有必要的转换
     for (int i = 0; i < partitions.size(); ++i) {
         DFAState newState = i;
@@ -145,25 +149,19 @@ DFA DFAMinimizer::minimizeDFA(const DFA &dfa)
         DFAState representative = *partitions[i].begin();
         
         // 为每个输入字符生成转换
-        for (const QString &input : dfa.alphabet) {
-            if (input == "#") continue;
-            
+        for (SymbolId input : dfa.alphabet) {
             // 使用邻接表快速查找转换
             if (transitionTable.contains(representative) && transitionTable[representative].contains(input)) {
                 DFAState originalToState = transitionTable[representative][input];
                 // 获取转换后的新状态
                 DFAState newToState = stateMap[originalToState];
                 
-                // 检查是否已经处理过该转换
-                QString key = QString::number(newState) + "|" + input + "|" + QString::number(newToState);
-                if (!processedTransitions.contains(key)) {
-                    DFATransition newTransition;
-                    newTransition.fromState = newState;
-                    newTransition.input = input;
-                    newTransition.toState = newToState;
-                    minimizedDFA.transitions.append(newTransition);
-                    processedTransitions.insert(key);
-                }
+                // 每个等价类只取一个代表状态，(newState, input)不会重复
+                DFATransition newTransition;
+                newTransition.fromState = newState;
+                newTransition.input = input;
+                newTransition.toState = newToState;
+                minimizedDFA.transitions.append(newTransition);
             }
         }
     }
@@ -181,257 +179,262 @@ QString DFAMinimizer::getErrorMessage() const
     return m_errorMessage;
 }
 
-// 为DFA构建逆向邻接表（用于Hopcroft算法）
-QHash<QString, QHash<DFAState, QSet<DFAState>>> buildReverseTransitionTable(const DFA &dfa)
-{
-    QHash<QString, QHash<DFAState, QSet<DFAState>>> reverseTable;
-    
-    for (const DFATransition &transition : dfa.transitions) {
-        reverseTable[transition.input][transition.toState].insert(transition.fromState);
-    }
-    
-    return reverseTable;
-}
-
-// 为DFA构建正向邻接表
-QHash<DFAState, QHash<QString, DFAState>> buildForwardTransitionTable(const DFA &dfa)
-{
-    QHash<DFAState, QHash<QString, DFAState>> forwardTable;
-    
-    for (const DFATransition &transition : dfa.transitions) {
-        forwardTable[transition.fromState][transition.input] = transition.toState;
-    }
-    
-    return forwardTable;
-}
-
 /**
  * @brief 实现Hopcroft算法
  * 
- * 使用Hopcroft算法对DFA进行等价类划分
+ * 使用可细分划分（refinable partition）实现，时间复杂度O(m·log n)：
+ * 1. 所有状态存放在elements数组中，每个块占据一段连续区间[first, end)，
+ *    location记录状态在数组中的位置，blockOf记录状态所属的块
+ * 2. 标记状态时把它交换到所在块的前部，mid为已标记部分的末尾，
+ *    块中全部被标记时不分裂，否则已标记部分成为新块
+ * 3. 工作集合中的元素是(块, 符号)对，块分裂后若(块, 符号)仍在工作集合中则加入新块，
+ *    否则只加入两部分中较小的一个
+ * 
+ * 转换函数可以是部分的（缺少的转换视为到隐含的死状态），因此初始时所有块都加入工作集合
  * 
  * @param dfa 输入DFA
- * @return QList<QSet<DFAState>> 等价类划分结果
+ * @return QList<QSet<DFAState>> 等价类划分结果，按块中最小状态编号排序
  */
 QList<QSet<DFAState>> DFAMinimizer::hopcroftAlgorithm(const DFA &dfa)
 {
-    QList<QSet<DFAState>> P; // 划分集合
-    QList<QSet<DFAState>> W; // 工作集合
+    const int stateCount = dfa.states.size();
     
-    // 初始划分：接受状态和非接受状态
-    QSet<DFAState> F = dfa.acceptStates;
-    QSet<DFAState> Q_F(dfa.states.begin(), dfa.states.end());
-    QSet<DFAState> tempF = F;
-    Q_F.subtract(tempF);
-    
-    if (!F.isEmpty()) {
-        P.append(F);
-        W.append(F);
+    // 状态与符号都映射为连续下标
+    QHash<DFAState, int> stateIndex;
+    stateIndex.reserve(stateCount);
+    for (int i = 0; i < stateCount; ++i) {
+        stateIndex.insert(dfa.states[i], i);
     }
-    if (!Q_F.isEmpty()) {
-        P.append(Q_F);
-        W.append(Q_F);
+    QHash<SymbolId, int> symbolIndex;
+    for (SymbolId symbol : dfa.alphabet) {
+        symbolIndex.insert(symbol, symbolIndex.size());
     }
-    
-    // 构建逆向邻接表：input -> (toState -> fromStates)
-    QHash<QString, QHash<DFAState, QSet<DFAState>>> reverseTransitionTable = buildReverseTransitionTable(dfa);
-    
-    // 开始划分过程
-    while (!W.isEmpty()) {
-        QSet<DFAState> A = W.takeFirst();
-        
-        // 对每个输入字符
-        for (const QString &c : dfa.alphabet) {
-            if (c == "#") continue; // 跳过空串
-            
-            // 计算所有通过c转换到A中状态的状态集合X
-            QSet<DFAState> X;
-            
-            // 使用逆向邻接表快速查找
-            if (reverseTransitionTable.contains(c)) {
-                const QHash<DFAState, QSet<DFAState>> &transitions = reverseTransitionTable[c];
-                for (DFAState toState : A) {
-                    if (transitions.contains(toState)) {
-                        X.unite(transitions[toState]);
-                    }
-                }
-            }
-            
-            if (X.isEmpty()) continue;
-            
-            // 创建一个临时列表来存储新的划分
-            QList<QSet<DFAState>> tempP;
-            
-            // 遍历当前P的副本，避免在循环中修改正在迭代的集合
-            for (const QSet<DFAState> &Y : P) {
-                QSet<DFAState> Y1; // Y ∩ X
-                QSet<DFAState> Y2; // Y \ X
-                for (DFAState state : Y) {
-                    if (X.contains(state)) {
-                        Y1.insert(state);
-                    } else {
-                        Y2.insert(state);
-                    }
-                }
-                
-                if (!Y1.isEmpty() && !Y2.isEmpty()) {
-                    tempP.append(Y1);
-                    tempP.append(Y2);
-                    
-                    // 更新工作集合W
-                    if (W.contains(Y)) {
-                        W.removeAll(Y);
-                        W.append(Y1);
-                        W.append(Y2);
-                    } else {
-                        if (Y1.size() <= Y2.size()) {
-                            W.append(Y1);
-                        } else {
-                            W.append(Y2);
-                        }
-                    }
-                } else {
-                    tempP.append(Y);
-                }
-            }
-            
-            // 使用临时列表更新P
-            P = tempP;
+    for (const DFATransition &transition : dfa.transitions) {
+        if (!symbolIndex.contains(transition.input)) {
+            symbolIndex.insert(transition.input, symbolIndex.size());
         }
     }
+    const int symbolCount = symbolIndex.size();
     
-    // 特殊处理：对于可选符号（如 '+' 和 '-'），确保它们不会在同一个状态中重复出现
-    // 这是对标准Hopcroft算法的增强，用于处理正则表达式中的?量词语义
-    P = enhanceHopcroftForOptionalSymbols(dfa, P);
-    
-    return P;
-}
-
-QList<QSet<DFAState>> DFAMinimizer::enhanceHopcroftForOptionalSymbols(const DFA &dfa, const QList<QSet<DFAState>> &partitions)
-{
-    QList<QSet<DFAState>> enhancedPartitions = partitions;
-    
-    // 检查是否存在可选符号问题
-    // 对于正则表达式 (\+|\-)?digit+，我们需要确保状态不能同时接收 '+' 和 '-' 并转换到自身
+    // 逆向邻接表（CSR）：目标状态 -> (符号, 源状态)，同一目标的入边按符号排序
+    QVector<int> inOffset(stateCount + 1, 0);
+    for (const DFATransition &transition : dfa.transitions) {
+        int to = stateIndex.value(transition.toState, -1);
+        if (to >= 0 && stateIndex.contains(transition.fromState)) {
+            inOffset[to + 1]++;
+        }
+    }
+    for (int i = 0; i < stateCount; ++i) {
+        inOffset[i + 1] += inOffset[i];
+    }
+    QVector<QPair<int, int>> inEdges(inOffset[stateCount]);
+    QVector<int> fill = inOffset;
+    for (const DFATransition &transition : dfa.transitions) {
+        int to = stateIndex.value(transition.toState, -1);
+        int from = stateIndex.value(transition.fromState, -1);
+        if (to >= 0 && from >= 0) {
+            inEdges[fill[to]++] = qMakePair(symbolIndex.value(transition.input), from);
+        }
+    }
+    for (int i = 0; i < stateCount; ++i) {
+        std::sort(inEdges.begin() + inOffset[i], inEdges.begin() + inOffset[i + 1]);
+    }
     
-    // 识别可能包含可选符号问题的状态
-    QSet<QString> optionalSymbols = {"+", "-"};
+    // 初始划分：非接受状态为一块，接受状态按(正则表达式下标, 单词下标)分块，
+    // 使不同token的接受状态不会被合并，最小化后acceptStateToRegexIndex仍然准确
+    QVector<int> elements(stateCount);
+    QVector<int> location(stateCount);
+    QVector<int> blockOf(stateCount);
+    QVector<int> first;
+    QVector<int> mid;
+    QVector<int> end;
+    QMap<QPair<int, int>, QVector<int>> acceptGroups;
+    QVector<int> nonAcceptStates;
+    for (int i = 0; i < stateCount; ++i) {
+        DFAState state = dfa.states[i];
+        if (dfa.acceptStates.contains(state)) {
+            QPair<int, int> token(dfa.acceptStateToRegexIndex.value(state, -1),
+                                  dfa.acceptStateToWordIndex.value(state, -1));
+            acceptGroups[token].append(i);
+        } else {
+            nonAcceptStates.append(i);
+        }
+    }
+    QList<QVector<int>> initialBlocks = acceptGroups.values();
+    initialBlocks.append(nonAcceptStates);
+    int position = 0;
+    for (const QVector<int> &members : std::as_const(initialBlocks)) {
+        if (members.isEmpty()) {
+            continue;
+        }
+        first.append(position);
+        mid.append(position);
+        for (int i : members) {
+            elements[position] = i;
+            location[i] = position;
+            blockOf[i] = first.size() - 1;
+            position++;
+        }
+        end.append(position);
+    }
     
-    // 构建正向邻接表加速转换查找
-    QHash<DFAState, QHash<QString, DFAState>> transitionTable = buildForwardTransitionTable(dfa);
+    // 工作集合：(块, 符号)对，inWorklist[块 * symbolCount + 符号]标记是否已在其中
+    QVector<QPair<int, int>> worklist;
+    QVector<bool> inWorklist(first.size() * symbolCount, false);
+    for (int b = 0; b < first.size(); ++b) {
+        for (int a = 0; a < symbolCount; ++a) {
+            worklist.append(qMakePair(b, a));
+            inWorklist[b * symbolCount + a] = true;
+        }
+    }
     
-    // 关键修复：检查每个划分中的状态是否具有语义冲突
-    for (int i = 0; i < enhancedPartitions.size(); ++i) {
-        const QSet<DFAState> &partition = enhancedPartitions[i];
-        
-        if (partition.size() <= 1) continue; // 单个状态不需要划分
-        
-        // 检查该划分中的状态是否具有语义冲突
-        // 冲突条件：状态可以接收可选符号并转换到自身，或者状态可以接收可选符号但转换到不同的状态
-        QSet<DFAState> statesWithOptionalTransitions;
-        QSet<DFAState> statesWithoutOptionalTransitions;
+    QVector<int> predecessors;
+    QVector<int> touchedBlocks;
+    while (!worklist.isEmpty()) {
+        QPair<int, int> splitter = worklist.takeLast();
+        const int splitterBlock = splitter.first;
+        const int symbol = splitter.second;
+        inWorklist[splitterBlock * symbolCount + symbol] = false;
         
-        for (DFAState state : partition) {
-            bool hasOptionalTransition = false;
-            
-            // 检查状态是否有任何可选符号的转换
-            for (const QString &symbol : optionalSymbols) {
-                if (transitionTable.contains(state) && transitionTable[state].contains(symbol)) {
-                    hasOptionalTransition = true;
-                    break;
-                }
-            }
-            
-            if (hasOptionalTransition) {
-                statesWithOptionalTransitions.insert(state);
-            } else {
-                statesWithoutOptionalTransitions.insert(state);
+        // 收集经symbol转换到splitterBlock的所有状态；DFA中每个状态在一个符号上至多一条出边，因此不会重复
+        predecessors.clear();
+        for (int p = first[splitterBlock]; p < end[splitterBlock]; ++p) {
+            const int target = elements[p];
+            auto edgeBegin = inEdges.constBegin() + inOffset[target];
+            auto edgeEnd = inEdges.constBegin() + inOffset[target + 1];
+            auto it = std::lower_bound(edgeBegin, edgeEnd, qMakePair(symbol, -1));
+            for (; it != edgeEnd && it->first == symbol; ++it) {
+                predecessors.append(it->second);
             }
         }
         
-        // 如果划分中包含有可选符号转换和无可选符号转换的状态，需要进一步划分
-        if (!statesWithOptionalTransitions.isEmpty() && !statesWithoutOptionalTransitions.isEmpty()) {
-            enhancedPartitions.removeAt(i);
-            enhancedPartitions.insert(i, statesWithOptionalTransitions);
-            enhancedPartitions.insert(i + 1, statesWithoutOptionalTransitions);
-            i++; // 跳过新添加的划分
+        // 标记：把状态交换到所在块的已标记部分末尾
+        touchedBlocks.clear();
+        for (int state : std::as_const(predecessors)) {
+            const int block = blockOf[state];
+            if (mid[block] == first[block]) {
+                touchedBlocks.append(block);
+            }
+            const int from = location[state];
+            const int to = mid[block];
+            const int other = elements[to];
+            elements[to] = state;
+            location[state] = to;
+            elements[from] = other;
+            location[other] = from;
+            mid[block]++;
         }
-    }
-    
-    // 进一步处理：确保接受状态不会与具有可选符号自循环的状态合并
-    for (int i = 0; i < enhancedPartitions.size(); ++i) {
-        const QSet<DFAState> &partition = enhancedPartitions[i];
         
-        if (partition.size() <= 1) continue;
-        
-        // 检查划分中是否同时包含接受状态和具有可选符号自循环的状态
-        bool hasAcceptState = false;
-        bool hasOptionalSelfLoopState = false;
-        QSet<DFAState> acceptStates;
-        QSet<DFAState> nonAcceptStates;
-        
-        for (DFAState state : partition) {
-            if (dfa.acceptStates.contains(state)) {
-                hasAcceptState = true;
-                acceptStates.insert(state);
-            } else {
-                nonAcceptStates.insert(state);
+        // 分裂被部分标记的块
+        for (int block : std::as_const(touchedBlocks)) {
+            if (mid[block] == end[block]) {
+                mid[block] = first[block];
+                continue;
+            }
+            
+            // 已标记部分[first, mid)成为新块，原块保留[mid, end)
+            const int newBlock = first.size();
+            first.append(first[block]);
+            mid.append(first[block]);
+            end.append(mid[block]);
+            first[block] = mid[block];
+            for (int p = first[newBlock]; p < end[newBlock]; ++p) {
+                blockOf[elements[p]] = newBlock;
             }
             
-            // 检查是否有可选符号的自循环
-            for (const QString &symbol : optionalSymbols) {
-                if (transitionTable.contains(state) && transitionTable[state].contains(symbol)) {
-                    if (transitionTable[state][symbol] == state) {
-                        hasOptionalSelfLoopState = true;
-                        break;
-                    }
+            inWorklist.resize(first.size() * symbolCount);
+            const int oldSize = end[block] - first[block];
+            const int newSize = end[newBlock] - first[newBlock];
+            for (int a = 0; a < symbolCount; ++a) {
+                int add = newBlock;
+                if (!inWorklist[block * symbolCount + a] && oldSize < newSize) {
+                    add = block;
+                }
+                if (!inWorklist[add * symbolCount + a]) {
+                    inWorklist[add * symbolCount + a] = true;
+                    worklist.append(qMakePair(add, a));
                 }
             }
         }
-        
-        // 如果接受状态与具有可选符号自循环的状态在同一划分中，需要分离
-        if (hasAcceptState && hasOptionalSelfLoopState && !acceptStates.isEmpty() && !nonAcceptStates.isEmpty()) {
-            enhancedPartitions.removeAt(i);
-            enhancedPartitions.insert(i, acceptStates);
-            enhancedPartitions.insert(i + 1, nonAcceptStates);
-            i++; // 跳过新添加的划分
+    }
+    
+    // 按块中最小状态编号排序输出，起始状态通常因此成为0号状态
+    QVector<int> blockOrder(first.size());
+    QVector<int> minState(first.size(), stateCount);
+    for (int b = 0; b < first.size(); ++b) {
+        blockOrder[b] = b;
+        for (int p = first[b]; p < end[b]; ++p) {
+            minState[b] = qMin(minState[b], elements[p]);
+        }
+    }
+    std::sort(blockOrder.begin(), blockOrder.end(), [&minState](int x, int y) {
+        return minState[x] < minState[y];
+    });
+    
+    QList<QSet<DFAState>> P;
+    P.reserve(first.size());
+    for (int b : std::as_const(blockOrder)) {
+        QSet<DFAState> block;
+        block.reserve(end[b] - first[b]);
+        for (int p = first[b]; p < end[b]; ++p) {
+            block.insert(dfa.states[elements[p]]);
         }
+        P.append(block);
     }
     
-    return enhancedPartitions;
+    return P;
 }
 
-QSet<DFAState> DFAMinimizer::move(const DFA &dfa, const QSet<DFAState> &states, const QString &input)
+/**
+ * @brief 去掉从起始状态不可达的状态及其出边
+ * 
+ * @param dfa 输入DFA
+ * @return DFA 只含可达状态的DFA，状态编号与接受状态映射不变
+ */
+DFA DFAMinimizer::removeUnreachableStates(const DFA &dfa)
 {
-    QSet<DFAState> result;
-    
-    // 构建邻接表来加速转换查找
-    QHash<DFAState, QHash<QString, DFAState>> transitionTable;
-    for (const DFATransition &t : dfa.transitions) {
-        transitionTable[t.fromState][t.input] = t.toState;
+    QHash<DFAState, QList<DFAState>> successors;
+    for (const DFATransition &transition : dfa.transitions) {
+        successors[transition.fromState].append(transition.toState);
     }
     
-    for (DFAState state : states) {
-        if (transitionTable.contains(state) && transitionTable[state].contains(input)) {
-            result.insert(transitionTable[state][input]);
+    QSet<DFAState> reachable;
+    QList<DFAState> pending;
+    reachable.insert(dfa.startState);
+    pending.append(dfa.startState);
+    while (!pending.isEmpty()) {
+        const DFAState state = pending.takeLast();
+        for (DFAState target : successors.value(state)) {
+            if (!reachable.contains(target)) {
+                reachable.insert(target);
+                pending.append(target);
+            }
         }
     }
-    
-    return result;
-}
-
-bool DFAMinimizer::isAcceptState(const DFA &dfa, DFAState state)
-{
-    return dfa.acceptStates.contains(state);
-}
-
-DFAState DFAMinimizer::getSetRepresentative(const QSet<DFAState> &states)
-{
-    if (states.isEmpty()) {
-        return -1;
+    if (reachable.size() == dfa.states.size()) {
+        return dfa;
     }
     
-    return *states.constBegin();
+    DFA result = dfa;
+    result.states.clear();
+    for (DFAState state : dfa.states) {
+        if (reachable.contains(state)) {
+            result.states.append(state);
+        }
+    }
+    result.transitions.clear();
+    for (const DFATransition &transition : dfa.transitions) {
+        if (reachable.contains(transition.fromState)) {
+            result.transitions.append(transition);
+        }
+    }
+    result.acceptStates.clear();
+    for (DFAState state : dfa.acceptStates) {
+        if (reachable.contains(state)) {
+            result.acceptStates.insert(state);
+        }
+    }
+    return result;
 }
 
 QMap<DFAState, DFAState> DFAMinimizer::createStateMap(const QList<QSet<DFAState>> &partitions)
@@ -0,0 +1,286 @@
+/*
+ * @file dfatablepacker.cpp
+ * @id dfatablepacker-cpp
+ * @brief 实现DFA转移表的字节等价类归并与行位移压缩
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#include "task1/dfatablepacker.h"
+#include "task1/symboltable.h"
+#include <QMap>
+#include <QList>
+#include <algorithm>
+
+/**
+ * @brief 构造函数
+ */
+DFATablePacker::DFATablePacker()
+{
+}
+
+/**
+ * @brief 析构函数
+ */
+DFATablePacker::~DFATablePacker()
+{
+}
+
+/**
+ * @brief 构建稠密转移表
+ * 
+ * 先按字节展开为每个字节一列的表，再把列完全相同的字节归为同一等价类
+ * 
+ * @param dfa 最小化DFA
+ * @param table 输出参数，稠密转移表
+ * @return bool 构建成功返回true
+ */
+bool DFATablePacker::buildDenseTable(const DFA &dfa, DenseDFATable &table)
+{
+    m_errorMessage.clear();
+    
+    const int numStates = dfa.states.size();
+    if (numStates == 0) {
+        m_errorMessage = "最小化DFA为空";
+        return false;
+    }
+    if (dfa.startState < 0 || dfa.startState >= numStates) {
+        m_errorMessage = QString("起始状态 %1 超出状态编号范围").arg(dfa.startState);
+        return false;
+    }
+    
+    // 按字节展开的转移表：byteTable[c * numStates + state]，即每个字节一列
+    QVector<qint32> byteTable(256 * numStates, -1);
+    for (const DFATransition &transition : dfa.transitions) {
+        if (transition.fromState < 0 || transition.fromState >= numStates
+            || transition.toState < 0 || transition.toState >= numStates) {
+            m_errorMessage = QString("转换 %1 -> %2 的状态编号不连续").arg(transition.fromState).arg(transition.toState);
+            return false;
+        }
+        for (const CharRange &range : SymbolTable::ranges(transition.input)) {
+            if (range.low > 0xFF) {
+                break; // 按字节匹配
+            }
+            const int high = qMin<int>(range.high, 0xFF);
+            for (int c = range.low; c <= high; ++c) {
+                byteTable[c * numStates + transition.fromState] = transition.toState;
+            }
+        }
+    }
+    
+    // 列相同的字节归为同一等价类
+    QMap<QVector<qint32>, int> columnToClass;
+    QList<QVector<qint32>> classColumns;
+    table.byteClasses = QVector<quint8>(256, 0);
+    for (int c = 0; c < 256; ++c) {
+        QVector<qint32> column = byteTable.mid(c * numStates, numStates);
+        int classIndex = columnToClass.value(column, -1);
+        if (classIndex == -1) {
+            classIndex = classColumns.size();
+            columnToClass.insert(column, classIndex);
+            classColumns.append(column);
+        }
+        table.byteClasses[c] = static_cast<quint8>(classIndex);
+    }
+    
+    table.stateCount = numStates;
+    table.classCount = classColumns.size();
+    table.startState = dfa.startState;
+    table.transitions = QVector<qint32>(numStates * table.classCount, -1);
+    for (int state = 0; state < numStates; ++state) {
+        for (int classIndex = 0; classIndex < table.classCount; ++classIndex) {
+            table.transitions[state * table.classCount + classIndex] = classColumns[classIndex][state];
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 压缩稠密转移表
+ * 
+ * 1. 按状态顺序挑选默认状态：在最近处理过的DEFAULT_CANDIDATES个状态中
+ *    找与当前行不同列数最少的一个，只有不同列数少于当前行的非出错列数时才采用
+ * 2. 每行只保留需要存放的列（有默认状态时为与之不同的列，否则为非出错列）
+ * 3. 按需存放列数从多到少，为每行找最小的base使其所有列都落在空位上
+ * 
+ * @param dense 稠密转移表
+ * @return PackedDFATable 行位移压缩的转移表
+ */
+PackedDFATable DFATablePacker::pack(const DenseDFATable &dense) const
+{
+    const int numStates = dense.stateCount;
+    const int classCount = dense.classCount;
+    
+    PackedDFATable packed;
+    packed.stateCount = numStates;
+    packed.classCount = classCount;
+    packed.startState = dense.startState;
+    packed.byteClasses = dense.byteClasses;
+    packed.base = QVector<qint32>(numStates, 0);
+    packed.defaults = QVector<qint32>(numStates, -1);
+    
+    auto row = [&dense, classCount](int state) {
+        return dense.transitions.constData() + state * classCount;
+    };
+    
+    // 1. 挑选默认状态，candidates按最近使用顺序排列
+    QVector<int> depth(numStates, 0);
+    QList<int> candidates;
+    QVector<QVector<int>> entries(numStates);
+    for (int state = 0; state < numStates; ++state) {
+        const qint32 *current = row(state);
+        int bestCost = 0;
+        for (int k = 0; k < classCount; ++k) {
+            bestCost += (current[k] != -1) ? 1 : 0;
+        }
+    
+        int best = -1;
+        for (int candidate : std::as_const(candidates)) {
+            if (depth[candidate] >= MAX_DEFAULT_DEPTH) {
+                continue;
+            }
+            const qint32 *other = row(candidate);
+            int cost = 0;
+            for (int k = 0; k < classCount && cost < bestCost; ++k) {
+                cost += (current[k] != other[k]) ? 1 : 0;
+            }
+            if (cost < bestCost) {
+                best = candidate;
+                bestCost = cost;
+            }
+        }
+    
+        // 2. 需要存放的列
+        if (best >= 0) {
+            packed.defaults[state] = best;
+            depth[state] = depth[best] + 1;
+            const qint32 *other = row(best);
+            for (int k = 0; k < classCount; ++k) {
+                if (current[k] != other[k]) {
+                    entries[state].append(k);
+                }
+            }
+        } else {
+            for (int k = 0; k < classCount; ++k) {
+                if (current[k] != -1) {
+                    entries[state].append(k);
+                }
+            }
+        }
+    
+        candidates.prepend(state);
+        if (candidates.size() > DEFAULT_CANDIDATES) {
+            candidates.removeLast();
+        }
+    }
+    
+    // 3. 首次适配叠放，列多的行先放
+    QVector<int> order(numStates);
+    for (int state = 0; state < numStates; ++state) {
+        order[state] = state;
+    }
+    std::stable_sort(order.begin(), order.end(), [&entries](int a, int b) {
+        return entries[a].size() > entries[b].size();
+    });
+    
+    int firstFree = 0;
+    int maxBase = 0;
+    for (int state : std::as_const(order)) {
+        const QVector<int> &columns = entries[state];
+        if (columns.isEmpty()) {
+            continue; // base为0，check中没有属于该状态的位置，直接查默认状态
+        }
+    
+        while (firstFree < packed.check.size() && packed.check[firstFree] != -1) {
+            ++firstFree;
+        }
+        int base = qMax(0, firstFree - columns.first());
+        for (;; ++base) {
+            bool fits = true;
+            for (int k : columns) {
+                if (base + k < packed.check.size() && packed.check[base + k] != -1) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits) {
+                break;
+            }
+        }
+    
+        while (packed.check.size() < base + classCount) {
+            packed.check.append(-1);
+            packed.next.append(-1);
+        }
+        const qint32 *current = row(state);
+        for (int k : columns) {
+            packed.check[base + k] = state;
+            packed.next[base + k] = current[k];
+        }
+        packed.base[state] = base;
+        maxBase = qMax(maxBase, base);
+    }
+    
+    // 任何状态的base加任意等价类都不越界
+    while (packed.check.size() < maxBase + classCount) {
+        packed.check.append(-1);
+        packed.next.append(-1);
+    }
+    
+    packed.stateBytes = integerBytes(-1, numStates - 1);
+    packed.indexBytes = integerBytes(0, maxBase);
+    return packed;
+}
+
+/**
+ * @brief 在压缩表上查找状态转移
+ * 
+ * @param table 压缩转移表
+ * @param state 当前状态（必须有效）
+ * @param c 输入字节
+ * @return int 下一状态，出错时返回-1
+ */
+int DFATablePacker::nextState(const PackedDFATable &table, int state, uchar c)
+{
+    const int classIndex = table.byteClasses[c];
+    for (int s = state; s >= 0; s = table.defaults[s]) {
+        const int slot = table.base[s] + classIndex;
+        if (table.check[slot] == s) {
+            return table.next[slot];
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 计算存放某个取值范围的整数所需的字节数
+ * 
+ * @param minValue 最小值
+ * @param maxValue 最大值
+ * @return int 字节数：1、2或4
+ */
+int DFATablePacker::integerBytes(qint64 minValue, qint64 maxValue)
+{
+    if (minValue >= 0) {
+        if (maxValue <= 0xFF) {
+            return 1;
+        }
+        return maxValue <= 0xFFFF ? 2 : 4;
+    }
+    if (minValue >= -128 && maxValue <= 127) {
+        return 1;
+    }
+    return (minValue >= -32768 && maxValue <= 32767) ? 2 : 4;
+}
+
+/**
+ * @brief 获取错误信息
+ * 
+ * @return QString 错误信息
+ */
+QString DFATablePacker::getErrorMessage() const
+{
+    return m_errorMessage;
+}
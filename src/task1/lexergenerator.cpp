@@ -12,7 +12,12 @@
 #include <QMap>
 #include <QFile>
 #include <QIODevice>
+#include <QByteArray>
 #include <QTextStream>
+#include <cstring>
+#include <algorithm>
+#include "../../include/task1/compiledlexer.h"
+#include "../../include/task1/dfatablepacker.h"
 #define ERROR_STATE -1
 
 /**
@@ -40,7 +45,7 @@ LexerGenerator::~LexerGenerator()
  * 
  * @param regexItems 正则表达式项列表
  * @param minimizedDFA 最小化DFA
- * @param method 生成方法（直接匹配或状态转移）
+ * @param method 生成方法（直接匹配、状态转移、表驱动或直接编码）
  * @return QString 生成的词法分析器代码
  */
 QString LexerGenerator::generateLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA, GenerationMethod method)
@@ -64,7 +69,10 @@ QString LexerGenerator::generateLexer(const QList<RegexItem> &regexItems, const
     case GenerationMethod::DIRECT_MATCH:
         return generateDirectMatchLexer(regexItems, minimizedDFA);
     case GenerationMethod::STATE_TRANSITION:
-        return generateStateTransitionLexer(regexItems, minimizedDFA);
+    case GenerationMethod::TABLE_DRIVEN:
+        return generateStateTransitionLexer(regexItems, minimizedDFA, method);
+    case GenerationMethod::DIRECT_CODED:
+        return generateDirectCodedLexer(regexItems, minimizedDFA);
     default:
         m_errorMessage = "无效的生成方法";
         return "";
@@ -84,10 +92,12 @@ QString LexerGenerator::getErrorMessage() const
 /**
  * @brief 生成直接匹配法的词法分析器
  * 
- * 生成基于直接匹配方法的词法分析器代码
+ * 生成基于直接匹配方法的词法分析器代码：不建转移表，
+ * 每个状态的转移条件在switch中直接展开为字符区间判断。
+ * 接受状态的token编码与状态转移法相同（见computeAcceptTokens）
  * 
  * @param regexItems 正则表达式项列表
- * @param minimizedDFA 最小化DFA（此处未使用）
+ * @param minimizedDFA 最小化DFA
  * @return QString 生成的词法分析器代码
  */
 QString LexerGenerator::generateDirectMatchLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA)
@@ -96,160 +106,93 @@ QString LexerGenerator::generateDirectMatchLexer(const QList<RegexItem> &regexIt
 
     // 生成头文件
     code += "#include <iostream>\n";
-    code += "#include <fstream>\n";
-    code += "#include <string>\n";
+    code += "#include <cstdio>\n";
+    code += "#include <cstdlib>\n";
+    code += "#include <cstring>\n";
     code += "#include <vector>\n";
     code += "#include <cctype>\n";
+    code += "#include <algorithm>\n";
     code += "using namespace std;\n\n";
 
-    // 生成词法单元结构
+    // 生成源文件读入与输出函数
+    code += generateSourceLoader();
+    code += generateTokenOutput();
+
+    // 生成词法单元结构，单词以源文件中的(偏移, 长度)表示
     code += "struct Token {\n";
     code += "    int code;\n";
-    code += "    string lexeme;\n";
+    code += "    size_t offset;\n";
+    code += "    size_t length;\n";
     code += "};\n\n";
 
+    // 接受状态与token编码，与状态转移法相同：由computeAcceptTokens按接受状态映射，
+    // 多单词项的单词、与单词列表重叠的一般模式都由最小化DFA区分
+    code += "const int NUM_STATES = " + QString::number(minimizedDFA.states.size()) + ";\n";
+    code += generateAcceptStatesMap(regexItems, minimizedDFA);
+    code += "\n";
+
+    // 按起始状态归类转移，每个状态的转移条件直接展开为字符区间判断
+    QMap<DFAState, QList<DFATransition>> transitionsByState;
+    for (const DFATransition &transition : minimizedDFA.transitions) {
+        transitionsByState[transition.fromState].append(transition);
+    }
+
     // 生成词法分析函数
-    code += "vector<Token> lexicalAnalysis(const string &source) {\n";
+    code += "vector<Token> lexicalAnalysis(const unsigned char *source, size_t sourceLen) {\n";
     code += "    vector<Token> tokens;\n";
-    code += "    size_t pos = 0;\n";
-    code += "    size_t sourceLen = source.length();\n\n";
+    code += "    size_t pos = 0;\n\n";
 
     code += "    while (pos < sourceLen) {\n";
     code += "        // 跳过空白字符\n";
-    code += "        if (isspace(static_cast<unsigned char>(source[pos]))) {\n";
-    code += "            pos++;";
+    code += "        if (isspace(source[pos])) {\n";
+    code += "            pos++;\n";
     code += "            continue;\n";
     code += "        }\n\n";
 
-    code += "        bool matched = false;\n";
-    code += "        size_t maxMatchLen = 0;\n";
-    code += "        int tokenCode = -1;\n";
-    code += "        string matchedLexeme;\n\n";
-
-    // 生成每个正则表达式的匹配逻辑
-    for (const RegexItem &item : regexItems) {
-        code += QString("        // 匹配 %1\n").arg(item.name);
-        code += "        {\n";
-        code += "            string currentLexeme;\n";
-        code += "            bool currentMatched = false;\n\n";
-
-        // 多单词情况，直接匹配单词列表
-        if (item.isMultiWord) {
-            int index = 0;
-            for (const QString &word : item.wordList) {
-                QString escapedWord = word;
-                escapedWord.replace("\"", "\\\"");
-                escapedWord.replace("\\", "\\\\");
-
-                code += QString("            if (source.compare(pos, %1, \"%2\") == 0) {\n").arg(word.length()).arg(escapedWord);
-                code += QString("                currentLexeme = \"%1\";\n").arg(escapedWord);
-                code += "                currentMatched = true;\n";
-                code += "                if (currentLexeme.length() > maxMatchLen) {\n";
-                code += "                    maxMatchLen = currentLexeme.length();\n";
-                code += QString("                    tokenCode = %1;\n").arg(item.code + index);
-                code += "                    matchedLexeme = currentLexeme;\n";
-                code += "                    matched = true;\n";
-                code += "                }\n";
-                code += "            }\n";
-                index++;
-            }
-        } else {
-            // 单单词情况，生成动态匹配逻辑，不依赖硬编码
-            code += "            size_t currentPos = pos;\n";
-            code += "            size_t matchLen = 0;\n";
-            code += "            bool isMatch = false;\n\n";
-            
-            // 基于DFA的动态匹配逻辑
-            code += "            // 基于DFA状态转移的动态匹配\n";
-            code += "            int state = " + QString::number(minimizedDFA.startState) + ";\n";
-            code += "            int lastAcceptPos = pos;\n";
-            code += "            int lastAcceptState = -1;\n\n";
-            code += "            // 模拟DFA状态转移\n";
-            code += "            for (size_t i = pos; i < sourceLen; ++i) {\n";
-            code += "                char c = source[i];\n";
-            code += "                bool foundTransition = false;\n\n";
-            
-            // 为当前状态生成所有可能的转移检查
-            for (const auto &transition : minimizedDFA.transitions) {
-                // 这里需要为每个转移生成对应的检查代码
-                // 由于状态转移是基于输入字符的，我们需要生成对应的条件判断
-                QString input = transition.input;
-                
-                // 保存原始输入
-                QString originalInput = transition.input;
-                
-                // 处理特殊字符
-                if (input == "\\n") {
-                    input = "'\\n'";
-                } else if (input == "\\t") {
-                    input = "'\\t'";
-                } else if (input == "\\r") {
-                    input = "'\\r'";
-                } else if (input == "\\0") {
-                    input = "'\\0'";
-                } else if (input.length() == 1) {
-                    input = "'" + input + "'";
-                } else {
-                    input = "\"" + input + "\"";
-                }
-                
-                code += QString("            // 检查从状态%1通过输入%2到状态%3的转移\n").arg(transition.fromState).arg(input).arg(transition.toState);
-                code += QString("            if (state == %1 && (").arg(transition.fromState);
-                
-                // 根据输入类型生成不同的检查条件
-                if (originalInput.length() == 1) {
-                    // 单字符匹配
-                    code += QString("c == %1").arg(input);
-                } else {
-                    // 多字符匹配，需要比较子字符串
-                    code += QString("source.compare(i, %1, \"%2\") == 0").arg(originalInput.length()).arg(originalInput);
-                }
-                
-                code += "            ) {\n";
-                code += QString("                state = %1;\n").arg(transition.toState);
-                code += "                lastAcceptPos = i + " + QString::number(originalInput.length()) + ";\n";
-                code += "                foundTransition = true;\n";
-                
-                // 检查是否为接受状态
-                if (minimizedDFA.acceptStates.contains(transition.toState)) {
-                    code += "                lastAcceptState = " + QString::number(transition.toState) + ";\n";
-                }
-                
-                code += "            }\n";
+    code += "        // 从起始状态模拟最小化DFA，记录最后一个接受状态（最长匹配）\n";
+    code += "        int state = " + QString::number(minimizedDFA.startState) + ";\n";
+    code += "        int lastAcceptState = -1;\n";
+    code += "        size_t lastAcceptPos = pos;\n";
+    code += "        for (size_t i = pos; i < sourceLen; ++i) {\n";
+    code += "            unsigned char c = source[i];\n";
+    code += "            int nextState = -1;\n";
+    code += "            switch (state) {\n";
+    for (auto it = transitionsByState.constBegin(); it != transitionsByState.constEnd(); ++it) {
+        QString branches;
+        for (const DFATransition &transition : it.value()) {
+            // 转移符号是字符类（一组区间），生成对应的区间判断条件
+            QString condition = generateCharCondition(SymbolTable::ranges(transition.input), "c");
+            if (condition.isEmpty()) {
+                continue;
             }
-            
-            // 处理无转移情况
-            code += "            if (!foundTransition) {\n";
-            code += "                break;\n";
-            code += "            }\n";
-            
-            code += "            // 检查当前状态是否为接受状态\n";
-            code += "            if (lastAcceptState != -1) {\n";
-            code += "                isMatch = true;\n";
-            code += "            }\n";
-            code += "            }\n\n";
-            
-            // 设置匹配结果
-            code += "            if (isMatch && lastAcceptPos > pos) {\n";
-            code += "                matchLen = lastAcceptPos - pos;\n";
-            code += "                currentLexeme = source.substr(pos, matchLen);\n";
-            code += "                currentMatched = true;\n";
-            code += "                if (matchLen > maxMatchLen) {\n";
-            code += "                    maxMatchLen = matchLen;\n";
-            code += QString("                    tokenCode = %1;\n").arg(item.code);
-            code += "                    matchedLexeme = currentLexeme;\n";
-            code += "                    matched = true;\n";
-            code += "                }\n";
-            code += "            }\n";
-        }
-
-        code += "        }\n";
+            branches += QString("                %1if (%2) {\n").arg(branches.isEmpty() ? "" : "} else ").arg(condition);
+            branches += QString("                    nextState = %1;\n").arg(transition.toState);
+        }
+        if (branches.isEmpty()) {
+            continue;
+        }
+        code += QString("            case %1:\n").arg(it.key());
+        code += branches;
+        code += "                }\n";
+        code += "                break;\n";
     }
+    code += "            default:\n";
+    code += "                break;\n";
+    code += "            }\n";
+    code += "            if (nextState == -1) {\n";
+    code += "                break;\n";
+    code += "            }\n";
+    code += "            state = nextState;\n";
+    code += "            if (isAcceptState[state]) {\n";
+    code += "                lastAcceptState = state;\n";
+    code += "                lastAcceptPos = i + 1;\n";
+    code += "            }\n";
+    code += "        }\n\n";
 
-    code += "\n";
-    code += "        if (matched) {\n";
-    code += "            tokens.push_back({tokenCode, matchedLexeme});\n";
-    code += "            pos += maxMatchLen;\n";
+    code += "        if (lastAcceptState != -1) {\n";
+    code += "            // 接受状态按token区分，编码（含多单词编码）可直接查表\n";
+    code += "            tokens.push_back({acceptTokens[lastAcceptState], pos, lastAcceptPos - pos});\n";
+    code += "            pos = lastAcceptPos;\n";
     code += "        } else {\n";
     code += "            // 跳过无法识别的字符\n";
     code += "            pos++;\n";
@@ -260,33 +203,23 @@ QString LexerGenerator::generateDirectMatchLexer(const QList<RegexItem> &regexIt
 
     // 生成主函数
     code += "int main(int argc, char *argv[]) {\n";
-    code += "    string source;\n";
-    code += "    ifstream file;\n\n";
-    code += "    if (argc > 1) {\n";
-    code += "        // 从文件读取源文件\n";
-    code += "        file.open(argv[1]);\n";
-    code += "        if (file.is_open()) {\n";
-    code += "            string line;\n";
-    code += "            while (getline(file, line)) {\n";
-    code += "                source += line + '\n';\n";
-    code += "            }\n";
-    code += "            file.close();\n";
-    code += "        } else {\n";
-    code += "            cerr << \"Error: Could not open file '\" << argv[1] << \'.\" << endl;\n";
-    code += "            return 1;\n";
-    code += "        }\n";
-    code += "    } else {\n";
-    code += "        // 从标准输入读取源文件\n";
-    code += "        string line;\n";
-    code += "        while (getline(cin, line)) {\n";
-    code += "            source += line + '\n';\n";
-    code += "        }\n";
+    code += "    // 读取源文件，未指定文件时读标准输入\n";
+    code += "    const char *path;\n";
+    code += "    if (!parseOptions(argc, argv, path)) {\n";
+    code += "        return 1;\n";
+    code += "    }\n";
+    code += "    if (!loadSource(path)) {\n";
+    code += "        cerr << \"Error: Could not open file '\" << (path != nullptr ? path : \"<stdin>\") << \"'.\" << endl;\n";
+    code += "        return 1;\n";
     code += "    }\n\n";
-    code += "    vector<Token> tokens = lexicalAnalysis(source);\n\n";
-    code += "    // 输出格式：单词\t编码\n";
+    code += "    vector<Token> tokens = lexicalAnalysis(src, srcEnd - src);\n\n";
+    code += "    // 输出格式：单词\\t编码\n";
+    code += "    beginOutput();\n";
     code += "    for (const auto &token : tokens) {\n";
-    code += "        cout << token.lexeme << '\t' << token.code << endl;\n";
-    code += "    }\n\n";
+    code += "        emitToken(token.offset, token.length, token.code);\n";
+    code += "    }\n";
+    code += "    flushOutput();\n\n";
+    code += "    releaseSource();\n";
     code += "    return 0;\n";
     code += "}\n";
 
@@ -300,243 +233,886 @@ QString LexerGenerator::generateDirectMatchLexer(const QList<RegexItem> &regexIt
  * 
  * @param regexItems 正则表达式项列表
  * @param minimizedDFA 最小化DFA
+ * @param method 生成方法，STATE_TRANSITION或TABLE_DRIVEN
  * @return QString 生成的词法分析器代码
  */
-QString LexerGenerator::generateStateTransitionLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA)
+QString LexerGenerator::generateStateTransitionLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA,
+                                                    GenerationMethod method)
 {
-    QString code;
+    QString code = generateStreamPrologue();
+    
+    // 生成状态转移表
+    if (method == GenerationMethod::TABLE_DRIVEN) {
+        QString tableCode = generateTableDrivenTransitions(minimizedDFA);
+        if (tableCode.isEmpty()) {
+            return "";
+        }
+        code += tableCode;
+    } else {
+        code += generateStateTransitionTable(minimizedDFA);
+    }
+    code += "\n";
 
+    // 生成接受状态映射
+    code += generateAcceptStatesMap(regexItems, minimizedDFA);
+    code += "\n";
+
+    // 生成自环扫描函数，进入有自环加速的状态后一次跳过整段自环
+    const QMap<DFAState, SelfLoopRun> runs = collectSelfLoopRuns(minimizedDFA);
+    if (!runs.isEmpty()) {
+        QMap<DFAState, QString> scannerNames;
+        code += generateSelfLoopScanners(runs, scannerNames);
+        code += "const bool hasSelfLoopRun[NUM_STATES] = {";
+        for (int state = 0; state < minimizedDFA.states.size(); ++state) {
+            code += state > 0 ? ", " : "";
+            code += runs.contains(state) ? "true" : "false";
+        }
+        code += "};\n\n";
+        code += "inline const unsigned char *skipSelfLoopRun(int state, const unsigned char *p, const unsigned char *end) {\n";
+        code += "\tswitch (state) {\n";
+        for (auto it = scannerNames.constBegin(); it != scannerNames.constEnd(); ++it) {
+            code += QString("\tcase %1: return %2(p, end);\n").arg(it.key()).arg(it.value());
+        }
+        code += "\tdefault: return p;\n";
+        code += "\t}\n";
+        code += "}\n\n";
+    }
+
+    // 生成词法分析函数
+    code += "// 从start开始按最长匹配识别一个单词，返回单词之后的位置并由code带回编码，无法识别时返回nullptr\n";
+    code += "const unsigned char *lexToken(const unsigned char *start, int &code) {\n";
+    code += "\tconst unsigned char *lastAcceptPos = nullptr;\n";
+    code += "\tint state = " + QString::number(minimizedDFA.startState) + ";\n";
+    code += "\tint lastAcceptState = -1;\n\n";
+    code += "\tfor (const unsigned char *p = start; p < srcEnd; ++p) {\n";
+    code += "\t\tint nextState = getNextState(state, *p);\n";
+    code += "\t\tif (nextState == ERROR_STATE) {\n";
+    code += "\t\t\tbreak;\n";
+    code += "\t\t}\n";
+    code += "\t\tstate = nextState;\n";
+    if (!runs.isEmpty()) {
+        code += "\t\tif (hasSelfLoopRun[state]) {\n";
+        code += "\t\t\tp = skipSelfLoopRun(state, p + 1, srcEnd) - 1;\n";
+        code += "\t\t}\n";
+    }
+    code += "\t\tif (isAcceptState[state]) {\n";
+    code += "\t\t\tlastAcceptState = state;\n";
+    code += "\t\t\tlastAcceptPos = p + 1;\n";
+    code += "\t\t}\n";
+    code += "\t}\n\n";
+    code += "\tif (lastAcceptState != -1) {\n";
+    code += "\t\t// 接受状态按token区分，编码（含多单词编码）可直接查表\n";
+    code += "\t\tcode = acceptTokens[lastAcceptState];\n";
+    code += "\t}\n";
+    code += "\t// 回退到最后一个接受状态只需返回其位置\n";
+    code += "\treturn lastAcceptPos;\n";
+    code += "}\n\n";
+
+    // 生成主函数
+    code += generateStreamMain();
+    
+    return code;
+}
+
+/**
+ * @brief 生成流式输入的公共部分
+ * 
+ * @return QString 头文件、全局变量与scanBlank函数代码
+ */
+QString LexerGenerator::generateStreamPrologue()
+{
+    QString code;
+    
     // 生成头文件
     code += "#include <iostream>\n";
-    code += "#include <fstream>\n";
-    code += "#include <string>\n";
+    code += "#include <cstdio>\n";
+    code += "#include <cstdlib>\n";
     code += "#include <cstring>\n";
+    code += "#include <vector>\n";
     code += "#include <cctype>\n";
+    code += "#include <algorithm>\n";
+    code += "#include <thread>\n";
     code += "using namespace std;\n\n";
+    
+    // 生成源文件读入与输出函数
+    code += generateSourceLoader();
+    code += generateTokenOutput();
+    
+    // 生成SIMD支持代码
+    code += generateSimdSupport();
+    
+    // 生成跳过空白字符的扫描函数，空白字符与isspace一致：'\t'~'\r'与空格
+    SelfLoopRun blank;
+    blank.ranges = {{'\t', '\r'}, {' ', ' '}};
+    blank.stopSet = false;
+    code += generateRunScanner("scanBlank", blank);
+    
+    return code;
+}
 
-    // 生成全局变量
-    code += "ifstream in;\n";
-    code += "string buf;\n";
-    code += "int read_cnt = 0;\n\n";
-
-    // 生成跳过空白字符函数
-    code += "void skipBlank() {\n";
-    code += "\tchar c;\n";
-    code += "\twhile ((c = in.get()) != EOF) {\n";
-    code += "\t\tif (isspace(static_cast<unsigned char>(c))) {\n";
-    code += "\t\t\tread_cnt++;\n";
+/**
+ * @brief 生成源文件读入函数
+ * 
+ * 普通文件用mmap整体映射（非POSIX平台或映射失败时退回按64KB起倍增的大块读入），
+ * 标准输入按大块读入；词法分析器用原始指针扫描，单词以源文件中的(偏移, 长度)表示
+ * 
+ * @return QString 生成的src/srcEnd全局变量与loadSource、releaseSource函数代码
+ */
+QString LexerGenerator::generateSourceLoader()
+{
+    QString code;
+    
+    code += "#if defined(__unix__) || defined(__APPLE__)\n";
+    code += "#include <sys/mman.h>\n";
+    code += "#include <sys/stat.h>\n";
+    code += "#include <fcntl.h>\n";
+    code += "#include <unistd.h>\n";
+    code += "#define LEXER_USE_MMAP 1\n";
+    code += "#endif\n\n";
+    code += "// 源文件内容：src指向首字节，srcEnd指向末字节之后\n";
+    code += "const unsigned char *src = nullptr;\n";
+    code += "const unsigned char *srcEnd = nullptr;\n";
+    code += "size_t mappedSize = 0;\n\n";
+    code += "// 以大块读入整个流，缓冲区按需倍增\n";
+    code += "bool readStream(FILE *fp) {\n";
+    code += "\tsize_t capacity = 1 << 16;\n";
+    code += "\tsize_t size = 0;\n";
+    code += "\tunsigned char *data = static_cast<unsigned char *>(malloc(capacity));\n";
+    code += "\tif (data == nullptr) {\n";
+    code += "\t\treturn false;\n";
+    code += "\t}\n";
+    code += "\tsize_t n;\n";
+    code += "\twhile ((n = fread(data + size, 1, capacity - size, fp)) > 0) {\n";
+    code += "\t\tsize += n;\n";
+    code += "\t\tif (size == capacity) {\n";
+    code += "\t\t\tunsigned char *grown = static_cast<unsigned char *>(realloc(data, capacity * 2));\n";
+    code += "\t\t\tif (grown == nullptr) {\n";
+    code += "\t\t\t\tfree(data);\n";
+    code += "\t\t\t\treturn false;\n";
+    code += "\t\t\t}\n";
+    code += "\t\t\tdata = grown;\n";
+    code += "\t\t\tcapacity *= 2;\n";
+    code += "\t\t}\n";
+    code += "\t}\n";
+    code += "\tsrc = data;\n";
+    code += "\tsrcEnd = data + size;\n";
+    code += "\treturn !ferror(fp);\n";
+    code += "}\n\n";
+    code += "// 读入源文件：普通文件用mmap整体映射，否则（或path为空时读标准输入）按大块读入\n";
+    code += "bool loadSource(const char *path) {\n";
+    code += "\tif (path == nullptr) {\n";
+    code += "\t\treturn readStream(stdin);\n";
+    code += "\t}\n";
+    code += "#ifdef LEXER_USE_MMAP\n";
+    code += "\tint fd = open(path, O_RDONLY);\n";
+    code += "\tif (fd < 0) {\n";
+    code += "\t\treturn false;\n";
+    code += "\t}\n";
+    code += "\tstruct stat st;\n";
+    code += "\tif (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {\n";
+    code += "\t\tvoid *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);\n";
+    code += "\t\tif (data != MAP_FAILED) {\n";
+    code += "\t\t\tmadvise(data, st.st_size, MADV_SEQUENTIAL);\n";
+    code += "\t\t\tclose(fd);\n";
+    code += "\t\t\tsrc = static_cast<const unsigned char *>(data);\n";
+    code += "\t\t\tsrcEnd = src + st.st_size;\n";
+    code += "\t\t\tmappedSize = st.st_size;\n";
+    code += "\t\t\treturn true;\n";
+    code += "\t\t}\n";
+    code += "\t}\n";
+    code += "\tclose(fd);\n";
+    code += "#endif\n";
+    code += "\tFILE *fp = fopen(path, \"rb\");\n";
+    code += "\tif (fp == nullptr) {\n";
+    code += "\t\treturn false;\n";
+    code += "\t}\n";
+    code += "\tbool ok = readStream(fp);\n";
+    code += "\tfclose(fp);\n";
+    code += "\treturn ok;\n";
+    code += "}\n\n";
+    code += "void releaseSource() {\n";
+    code += "#ifdef LEXER_USE_MMAP\n";
+    code += "\tif (mappedSize > 0) {\n";
+    code += "\t\tmunmap(const_cast<unsigned char *>(src), mappedSize);\n";
+    code += "\t\treturn;\n";
+    code += "\t}\n";
+    code += "#endif\n";
+    code += "\tfree(const_cast<unsigned char *>(src));\n";
+    code += "}\n\n";
+    
+    return code;
+}
+
+/**
+ * @brief 生成单词输出函数
+ * 
+ * 单词先格式化到64KB的输出缓冲区，写满时才用一次fwrite写出，不再逐个单词刷新标准输出；
+ * 可选的二进制单词流以变长整数记录编码与(偏移, 长度)，行号由首次查询时建立的换行符偏移表二分得到
+ * 
+ * @return QString 生成的输出缓冲区、emitToken、flushOutput与命令行解析函数代码
+ */
+QString LexerGenerator::generateTokenOutput()
+{
+    QString code;
+    
+    code += "// 输出缓冲区：单词先格式化到缓冲区，写满时用一次fwrite写出\n";
+    code += "const size_t OUTPUT_BUFFER_SIZE = 1 << 16;\n";
+    code += "const size_t OUTPUT_RECORD_RESERVE = 64;\n";
+    code += "char outBuf[OUTPUT_BUFFER_SIZE];\n";
+    code += "size_t outLen = 0;\n\n";
+    code += "// 输出选项：-b输出二进制单词流，-n附带行号；-j指定并行识别的线程数，小于等于0表示取硬件线程数\n";
+    code += "bool binaryOutput = false;\n";
+    code += "bool lineNumbers = false;\n";
+    code += "int threadCount = 1;\n";
+    code += "size_t lastTokenEnd = 0;\n";
+    code += "size_t lastLine = 1;\n\n";
+    code += "void flushOutput() {\n";
+    code += "\tif (outLen > 0) {\n";
+    code += "\t\tfwrite(outBuf, 1, outLen, stdout);\n";
+    code += "\t\toutLen = 0;\n";
+    code += "\t}\n";
+    code += "}\n\n";
+    code += "void writeDecimal(unsigned long long value) {\n";
+    code += "\tchar digits[20];\n";
+    code += "\tint count = 0;\n";
+    code += "\tdo {\n";
+    code += "\t\tdigits[count++] = static_cast<char>('0' + value % 10);\n";
+    code += "\t\tvalue /= 10;\n";
+    code += "\t} while (value > 0);\n";
+    code += "\twhile (count > 0) {\n";
+    code += "\t\toutBuf[outLen++] = digits[--count];\n";
+    code += "\t}\n";
+    code += "}\n\n";
+    code += "// 无符号LEB128变长整数：每字节低7位为数据，最高位表示后面还有字节\n";
+    code += "void writeVarint(unsigned long long value) {\n";
+    code += "\twhile (value >= 0x80) {\n";
+    code += "\t\toutBuf[outLen++] = static_cast<char>(value | 0x80);\n";
+    code += "\t\tvalue >>= 7;\n";
+    code += "\t}\n";
+    code += "\toutBuf[outLen++] = static_cast<char>(value);\n";
+    code += "}\n\n";
+    code += "// 换行符偏移表，首次查询行号时才扫描源文件建立\n";
+    code += "vector<size_t> newlineOffsets;\n";
+    code += "bool newlineIndexBuilt = false;\n\n";
+    code += "size_t lineOf(size_t offset) {\n";
+    code += "\tif (!newlineIndexBuilt) {\n";
+    code += "\t\tconst unsigned char *p = src;\n";
+    code += "\t\twhile ((p = static_cast<const unsigned char *>(memchr(p, '\\n', srcEnd - p))) != nullptr) {\n";
+    code += "\t\t\tnewlineOffsets.push_back(p - src);\n";
+    code += "\t\t\t++p;\n";
+    code += "\t\t}\n";
+    code += "\t\tnewlineIndexBuilt = true;\n";
+    code += "\t}\n";
+    code += "\treturn upper_bound(newlineOffsets.begin(), newlineOffsets.end(), offset) - newlineOffsets.begin() + 1;\n";
+    code += "}\n\n";
+    code += "// 二进制单词流以\"LXT1\"和标志字节（第0位：含行号）开头\n";
+    code += "void beginOutput() {\n";
+    code += "\tif (binaryOutput) {\n";
+    code += "\t\tmemcpy(outBuf, \"LXT1\", 4);\n";
+    code += "\t\toutBuf[4] = lineNumbers ? 1 : 0;\n";
+    code += "\t\toutLen = 5;\n";
+    code += "\t}\n";
+    code += "}\n\n";
+    code += "// 输出一个词法单元，单词为源文件中[offset, offset + length)的字节\n";
+    code += "// 文本格式：[行号\\t]单词\\t编码\\n，与LexerTester解析的三列格式一致\n";
+    code += "// 二进制格式：每个单词依次为编码（zigzag）、与上一单词末尾的距离、长度[、与上一单词的行号差]，均为变长整数\n";
+    code += "void emitToken(size_t offset, size_t length, int code) {\n";
+    code += "\tif (outLen + OUTPUT_RECORD_RESERVE > OUTPUT_BUFFER_SIZE) {\n";
+    code += "\t\tflushOutput();\n";
+    code += "\t}\n";
+    code += "\tif (binaryOutput) {\n";
+    code += "\t\twriteVarint((static_cast<unsigned int>(code) << 1) ^ static_cast<unsigned int>(code >> 31));\n";
+    code += "\t\twriteVarint(offset - lastTokenEnd);\n";
+    code += "\t\twriteVarint(length);\n";
+    code += "\t\tif (lineNumbers) {\n";
+    code += "\t\t\tsize_t line = lineOf(offset);\n";
+    code += "\t\t\twriteVarint(line - lastLine);\n";
+    code += "\t\t\tlastLine = line;\n";
+    code += "\t\t}\n";
+    code += "\t\tlastTokenEnd = offset + length;\n";
+    code += "\t\treturn;\n";
+    code += "\t}\n\n";
+    code += "\tconst char *lexeme = reinterpret_cast<const char *>(src) + offset;\n";
+    code += "\tif (outLen + length + OUTPUT_RECORD_RESERVE > OUTPUT_BUFFER_SIZE) {\n";
+    code += "\t\tflushOutput();\n";
+    code += "\t}\n";
+    code += "\tif (lineNumbers) {\n";
+    code += "\t\twriteDecimal(lineOf(offset));\n";
+    code += "\t\toutBuf[outLen++] = '\\t';\n";
+    code += "\t}\n";
+    code += "\tif (length + OUTPUT_RECORD_RESERVE > OUTPUT_BUFFER_SIZE) {\n";
+    code += "\t\tflushOutput();\n";
+    code += "\t\tfwrite(lexeme, 1, length, stdout);\n";
+    code += "\t\tlength = 0;\n";
+    code += "\t}\n";
+    code += "\tmemcpy(outBuf + outLen, lexeme, length);\n";
+    code += "\toutLen += length;\n";
+    code += "\toutBuf[outLen++] = '\\t';\n";
+    code += "\tif (code < 0) {\n";
+    code += "\t\toutBuf[outLen++] = '-';\n";
+    code += "\t\twriteDecimal(-static_cast<long long>(code));\n";
+    code += "\t} else {\n";
+    code += "\t\twriteDecimal(code);\n";
+    code += "\t}\n";
+    code += "\toutBuf[outLen++] = '\\n';\n";
+    code += "}\n\n";
+    code += "// 解析命令行：[-b] [-n] [-j 线程数] [源文件]，未指定源文件时path为nullptr\n";
+    code += "bool parseOptions(int argc, char *argv[], const char *&path) {\n";
+    code += "\tpath = nullptr;\n";
+    code += "\tfor (int i = 1; i < argc; ++i) {\n";
+    code += "\t\tif (strcmp(argv[i], \"-b\") == 0) {\n";
+    code += "\t\t\tbinaryOutput = true;\n";
+    code += "\t\t} else if (strcmp(argv[i], \"-n\") == 0) {\n";
+    code += "\t\t\tlineNumbers = true;\n";
+    code += "\t\t} else if (strcmp(argv[i], \"-j\") == 0 && i + 1 < argc) {\n";
+    code += "\t\t\tthreadCount = atoi(argv[++i]);\n";
+    code += "\t\t} else if (path == nullptr) {\n";
+    code += "\t\t\tpath = argv[i];\n";
     code += "\t\t} else {\n";
-    code += "\t\t\tin.unget();\n";
-    code += "\t\t\tbreak;\n";
+    code += "\t\t\tcerr << \"Usage: \" << argv[0] << \" [-b] [-n] [-j threads] [source_file]\" << endl;\n";
+    code += "\t\t\treturn false;\n";
     code += "\t\t}\n";
     code += "\t}\n";
+    code += "\treturn true;\n";
     code += "}\n\n";
+    
+    return code;
+}
 
-    // 生成状态转移表
-    code += generateStateTransitionTable(minimizedDFA);
-    code += "\n";
+/**
+ * @brief 生成流式输入的主函数
+ * 
+ * lexStep识别并输出一个单词后跳过空白字符，顺序识别与并行拼接都以它逐个推进
+ * 
+ * @return QString lexStep、并行词法分析与main函数代码
+ */
+QString LexerGenerator::generateStreamMain()
+{
+    QString code;
+    
+    code += "// 识别并输出p处的一个单词，返回跳过其后空白字符的位置\n";
+    code += "const unsigned char *lexStep(const unsigned char *p) {\n";
+    code += "\tint code;\n";
+    code += "\tconst unsigned char *end = lexToken(p, code);\n";
+    code += "\tif (end != nullptr) {\n";
+    code += "\t\temitToken(p - src, end - p, code);\n";
+    code += "\t\tp = end;\n";
+    code += "\t}\n";
+    code += "\telse {\n";
+    code += "\t\t// 跳过无法识别的字符\n";
+    code += "\t\t++p;\n";
+    code += "\t}\n";
+    code += "\treturn scanBlank(p, srcEnd);\n";
+    code += "}\n\n";
+    code += generateParallelLexing();
+    code += "int main(int argc, char *argv[]) {\n";
+    code += "\t// 读取源文件，未指定文件时读标准输入\n";
+    code += "\tconst char *path;\n";
+    code += "\tif (!parseOptions(argc, argv, path)) {\n";
+    code += "\t\treturn 1;\n";
+    code += "\t}\n";
+    code += "\tif (!loadSource(path)) {\n";
+    code += "\t\tcerr << \"Error: Could not open file '\" << (path != nullptr ? path : \"<stdin>\") << \"'.\" << endl;\n";
+    code += "\t\treturn 1;\n";
+    code += "\t}\n\n";
+    code += "\t// 主循环：输入足够大且指定了多个线程时分块并行识别，否则跳过初始空白字符后顺序识别\n";
+    code += "\tbeginOutput();\n";
+    code += "\tsize_t threads = threadCount != 1 ? parallelThreadCount() : 1;\n";
+    code += "\tif (threads > 1) {\n";
+    code += "\t\tlexParallel(threads);\n";
+    code += "\t} else {\n";
+    code += "\t\tconst unsigned char *p = scanBlank(src, srcEnd);\n";
+    code += "\t\twhile (p < srcEnd) {\n";
+    code += "\t\t\tp = lexStep(p);\n";
+    code += "\t\t}\n";
+    code += "\t}\n";
+    code += "\tflushOutput();\n\n";
+    code += "\treleaseSource();\n";
+    code += "\treturn 0;\n";
+    code += "}\n";
+    
+    return code;
+}
 
-    // 生成接受状态映射
-    code += generateAcceptStatesMap(regexItems, minimizedDFA);
-    code += "\n";
+/**
+ * @brief 生成分块并行的词法分析函数
+ * 
+ * 输入切成PARALLEL_CHUNK_BYTES字节的块，每轮取线程数个相邻的块：主线程顺序识别第0块并直接输出，
+ * 其余块由std::thread从块首（跳过空白后）推测识别并暂存单词，之后按块依次拼接——
+ * 上一块实际结束的位置若是本块推测结果中的单词起点，其后的单词即为正确结果，
+ * 否则从该位置顺序重新识别，直到落到推测结果的单词起点或越过本块。
+ * 最长匹配可能回退到任意远的位置，块边界处的DFA状态无法单独确定，
+ * 因此以单词起点（DFA回到起始状态的位置）而不是块边界处的状态作为汇合点
+ * 
+ * @return QString 生成的Token/Chunk结构与lexChunk、parallelThreadCount、lexParallel函数代码
+ */
+QString LexerGenerator::generateParallelLexing()
+{
+    QString code;
+    
+    code += "// 推测识别的单词，单词为源文件中[offset, offset + length)的字节\n";
+    code += "struct Token {\n";
+    code += "\tint code;\n";
+    code += "\tsize_t offset;\n";
+    code += "\tsize_t length;\n";
+    code += "};\n\n";
+    code += "// 一个块的推测识别结果：从块首跳过空白处开始识别，直到单词起点不小于limit\n";
+    code += "struct Chunk {\n";
+    code += "\tconst unsigned char *begin;\n";
+    code += "\tconst unsigned char *limit;\n";
+    code += "\tconst unsigned char *end;\n";
+    code += "\tvector<Token> tokens;\n";
+    code += "};\n\n";
+    code += "// 每块PARALLEL_CHUNK_BYTES字节，每轮各线程各识别一块，各块的单词缓冲区在轮与轮之间复用\n";
+    code += "const size_t PARALLEL_CHUNK_BYTES = 1 << 20;\n\n";
+    code += "void lexChunk(Chunk *chunk) {\n";
+    code += "\tconst unsigned char *p = scanBlank(chunk->begin, srcEnd);\n";
+    code += "\twhile (p < chunk->limit) {\n";
+    code += "\t\tint code;\n";
+    code += "\t\tconst unsigned char *end = lexToken(p, code);\n";
+    code += "\t\tif (end != nullptr) {\n";
+    code += "\t\t\tchunk->tokens.push_back({code, static_cast<size_t>(p - src), static_cast<size_t>(end - p)});\n";
+    code += "\t\t\tp = end;\n";
+    code += "\t\t}\n";
+    code += "\t\telse {\n";
+    code += "\t\t\t// 跳过无法识别的字符\n";
+    code += "\t\t\t++p;\n";
+    code += "\t\t}\n";
+    code += "\t\tp = scanBlank(p, srcEnd);\n";
+    code += "\t}\n";
+    code += "\tchunk->end = p;\n";
+    code += "}\n\n";
+    code += "// 线程数为-j指定的线程数（小于等于0时取硬件线程数）与输入可切出的块数中较小者\n";
+    code += "size_t parallelThreadCount() {\n";
+    code += "\tsize_t threads = threadCount > 0 ? threadCount : thread::hardware_concurrency();\n";
+    code += "\treturn min(threads, static_cast<size_t>(srcEnd - src) / PARALLEL_CHUNK_BYTES);\n";
+    code += "}\n\n";
+    code += "// 每轮取threads个相邻的块，第0块由主线程顺序识别并输出，其余块各由一个线程从块首推测识别。\n";
+    code += "// 识别位置只由扫描起点决定：顺序扫描一旦落到某块推测结果中的单词起点，之后的单词便与推测结果完全相同，\n";
+    code += "// 因此按块依次拼接时，从上一块实际结束的位置顺序重新识别，直到与推测结果汇合\n";
+    code += "void lexParallel(size_t threads) {\n";
+    code += "\tvector<Chunk> chunks(threads);\n";
+    code += "\tconst unsigned char *p = scanBlank(src, srcEnd);\n";
+    code += "\tconst unsigned char *next = src;\n";
+    code += "\twhile (next < srcEnd) {\n";
+    code += "\t\tsize_t count = 0;\n";
+    code += "\t\tfor (; count < threads && next < srcEnd; ++count) {\n";
+    code += "\t\t\tchunks[count].begin = next;\n";
+    code += "\t\t\tchunks[count].limit = next + min(PARALLEL_CHUNK_BYTES, static_cast<size_t>(srcEnd - next));\n";
+    code += "\t\t\tchunks[count].tokens.clear();\n";
+    code += "\t\t\tnext = chunks[count].limit;\n";
+    code += "\t\t}\n";
+    code += "\t\tvector<thread> workers;\n";
+    code += "\t\tfor (size_t i = 1; i < count; ++i) {\n";
+    code += "\t\t\tworkers.emplace_back(lexChunk, &chunks[i]);\n";
+    code += "\t\t}\n\n";
+    code += "\t\twhile (p < chunks[0].limit) {\n";
+    code += "\t\t\tp = lexStep(p);\n";
+    code += "\t\t}\n";
+    code += "\t\tfor (size_t i = 1; i < count; ++i) {\n";
+    code += "\t\t\tworkers[i - 1].join();\n";
+    code += "\t\t\tconst Chunk &chunk = chunks[i];\n";
+    code += "\t\t\twhile (p < chunk.limit) {\n";
+    code += "\t\t\t\tconst size_t offset = p - src;\n";
+    code += "\t\t\t\tvector<Token>::const_iterator it = lower_bound(chunk.tokens.cbegin(), chunk.tokens.cend(), offset,\n";
+    code += "\t\t\t\t\t[](const Token &token, size_t value) { return token.offset < value; });\n";
+    code += "\t\t\t\tif (it != chunk.tokens.cend() && it->offset == offset) {\n";
+    code += "\t\t\t\t\t// 与推测结果汇合，其后的单词直接输出\n";
+    code += "\t\t\t\t\tfor (; it != chunk.tokens.cend(); ++it) {\n";
+    code += "\t\t\t\t\t\temitToken(it->offset, it->length, it->code);\n";
+    code += "\t\t\t\t\t}\n";
+    code += "\t\t\t\t\tp = chunk.end;\n";
+    code += "\t\t\t\t\tbreak;\n";
+    code += "\t\t\t\t}\n";
+    code += "\t\t\t\tp = lexStep(p);\n";
+    code += "\t\t\t}\n";
+    code += "\t\t}\n";
+    code += "\t}\n";
+    code += "}\n\n";
+    
+    return code;
+}
 
-    // 生成token映射表
-    code += "// Token映射表\n";
-    code += "#include <unordered_map>\n\n";
-    code += "unordered_map<string, int> tokenCodeMap;\n\n";
-    code += "void initializeTokenCodeMap() {\n";
+/**
+ * @brief 生成直接编码法的词法分析器
+ * 
+ * 仿照re2c，每个最小化DFA状态生成一段带标号的代码：
+ * 接受状态的accept_N标号记录最近的接受位置与token编码后落入state_N，
+ * state_N取扫描指针处的字节，按区间比较（区间较多时二分）直接goto到后继状态，
+ * 没有状态变量，也没有逐字符的getNextState调用
+ * 
+ * @param regexItems 正则表达式项列表
+ * @param minimizedDFA 最小化DFA
+ * @return QString 生成的词法分析器代码
+ */
+QString LexerGenerator::generateDirectCodedLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA)
+{
+    DFATablePacker packer;
+    DenseDFATable dense;
+    if (!packer.buildDenseTable(minimizedDFA, dense)) {
+        m_errorMessage = packer.getErrorMessage();
+        return "";
+    }
     
-    // 为每个正则表达式项生成映射
-    for (const RegexItem &item : regexItems) {
-        if (item.isMultiWord) {
-            // 多单词情况（关键字、符号等）
-            int currentCode = item.code;
-            
-            // 使用QMap来确保同一单词的不同大小写形式映射到同一个编码
-            QMap<QString, int> lowercaseToCodeMap;
-            
-            for (const QString &word : item.wordList) {
-                QString lowercaseWord = word.toLower();
-                if (!lowercaseToCodeMap.contains(lowercaseWord)) {
-                    lowercaseToCodeMap[lowercaseWord] = currentCode++;
-                }
+    QVector<bool> isAccept;
+    QVector<int> tokens;
+    computeAcceptTokens(regexItems, minimizedDFA, isAccept, tokens);
+    
+    // 从起始状态出发，按字节顺序把后继相同的相邻字节合并为区间，跳过出错状态；
+    // 只为实际有转移进入的标号生成代码，不可达的状态不生成
+    const int numStates = dense.stateCount;
+    QVector<QList<DirectCodedRange>> stateRanges(numStates);
+    QVector<bool> stateLabelUsed(numStates, false);
+    QVector<bool> acceptLabelUsed(numStates, false);
+    QVector<bool> visited(numStates, false);
+    QList<int> pending;
+    stateLabelUsed[dense.startState] = true;
+    visited[dense.startState] = true;
+    pending.append(dense.startState);
+    while (!pending.isEmpty()) {
+        int state = pending.takeFirst();
+        const qint32 *row = dense.transitions.constData() + state * dense.classCount;
+        for (int c = 0; c < 256; ++c) {
+            int target = row[dense.byteClasses[c]];
+            if (target == -1) {
+                continue;
             }
-            
-            // 生成映射条目
-            for (auto it = lowercaseToCodeMap.constBegin(); it != lowercaseToCodeMap.constEnd(); ++it) {
-                // 正确处理转义字符
-                QString tokenValue = it.key();
-                // 处理转义序列，如\*应转换为*
-                if (tokenValue.length() == 2 && tokenValue.startsWith("\\")) {
-                    tokenValue = tokenValue.right(1);
-                }
-                // 只需要转义双引号和反斜杠，不需要转义其他特殊字符
-                tokenValue.replace("\"", "\\\"");
-                tokenValue.replace("\\", "\\\\");
-                code += QString("    tokenCodeMap[\"%1\"] = %2;\n").arg(tokenValue).arg(it.value());
+            QList<DirectCodedRange> &ranges = stateRanges[state];
+            if (!ranges.isEmpty() && ranges.last().high == c - 1 && ranges.last().target == target) {
+                ranges.last().high = c;
+            } else {
+                ranges.append({c, c, target});
+            }
+            if (isAccept[target]) {
+                acceptLabelUsed[target] = true;
+            } else {
+                stateLabelUsed[target] = true;
+            }
+            if (!visited[target]) {
+                visited[target] = true;
+                pending.append(target);
             }
         }
     }
     
-    // 额外添加特殊字符映射，确保*和+等特殊字符能被正确识别
-    // 这些特殊字符可能被配置为单单词项，所以需要额外处理
-    for (const RegexItem &item : regexItems) {
-        if (!item.isMultiWord) {
-            // 处理单字符情况（操作符等）
-            if (item.pattern.length() == 1) {
-                QString tokenValue = item.pattern;
-                // 只需要转义双引号和反斜杠，不需要转义其他特殊字符
-                tokenValue.replace("\"", "\\\"");
-                tokenValue.replace("\\", "\\\\");
-                code += QString("    tokenCodeMap[\"%1\"] = %2;\n").arg(tokenValue).arg(item.code);
+    QString code = generateStreamPrologue();
+    
+    // 生成自环扫描函数（只为可达的状态生成）
+    QMap<DFAState, SelfLoopRun> runs = collectSelfLoopRuns(minimizedDFA);
+    for (auto it = runs.begin(); it != runs.end();) {
+        if (visited[it.key()]) {
+            ++it;
+        } else {
+            it = runs.erase(it);
+        }
+    }
+    QMap<DFAState, QString> scannerNames;
+    code += generateSelfLoopScanners(runs, scannerNames);
+    
+    // 生成词法分析函数
+    code += "// 从start开始按最长匹配识别一个单词，返回单词之后的位置并由code带回编码，无法识别时返回nullptr\n";
+    code += "const unsigned char *lexToken(const unsigned char *start, int &code) {\n";
+    code += "\tconst unsigned char *p = start;\n";
+    code += "\tconst unsigned char *lastAcceptPos = nullptr;\n";
+    code += "\tint lastAcceptToken = -1;\n";
+    code += "\tunsigned char c;\n";
+    code += "\tgoto state_" + QString::number(dense.startState) + ";\n\n";
+    
+    for (int state = 0; state < numStates; ++state) {
+        if (!acceptLabelUsed[state] && !stateLabelUsed[state]) {
+            continue; // 不可达的状态
+        }
+        // 有自环加速的状态在进入时一次跳过整段自环：接受状态在accept_N处扫描，
+        // 其余状态在state_N处扫描
+        const QString scanner = scannerNames.value(state);
+        if (acceptLabelUsed[state]) {
+            code += "accept_" + QString::number(state) + ":\n";
+            if (!scanner.isEmpty()) {
+                code += "\tp = " + scanner + "(p, srcEnd);\n";
             }
-            // 处理可能包含转义字符的情况
-            else if (item.pattern.length() == 2 && item.pattern.startsWith("\\")) {
-                // 处理转义字符，如\*
-                QString tokenValue = item.pattern.right(1);
-                // 只需要转义双引号和反斜杠，不需要转义其他特殊字符
-                tokenValue.replace("\"", "\\\"");
-                tokenValue.replace("\\", "\\\\");
-                code += QString("    tokenCodeMap[\"%1\"] = %2;\n").arg(tokenValue).arg(item.code);
+            code += "\tlastAcceptToken = " + QString::number(tokens[state]) + ";\n";
+            code += "\tlastAcceptPos = p;\n";
+        }
+        if (stateLabelUsed[state]) {
+            code += "state_" + QString::number(state) + ":\n";
+            if (!scanner.isEmpty() && !isAccept[state]) {
+                code += "\tp = " + scanner + "(p, srcEnd);\n";
             }
         }
+        
+        // 扫描后当前字节必然不在自环上，只有不经扫描直接进入state_N（起始状态）时才需要自环分支
+        QList<DirectCodedRange> ranges = stateRanges[state];
+        if (!scanner.isEmpty() && !(isAccept[state] && stateLabelUsed[state])) {
+            ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [state](const DirectCodedRange &range) {
+                return range.target == state;
+            }), ranges.end());
+        }
+        if (ranges.isEmpty()) {
+            code += "\tgoto done;\n\n";
+            continue;
+        }
+        code += "\tif (p == srcEnd) {\n";
+        code += "\t\tgoto done;\n";
+        code += "\t}\n";
+        code += "\tc = *p;\n";
+        code += generateDirectCodedDispatch(ranges, 0, ranges.size() - 1, isAccept, 1);
+        code += "\tgoto done;\n\n";
     }
     
-
-    
+    code += "done:\n";
+    code += "\t// 回退到最后一个接受状态只需返回其位置\n";
+    code += "\tcode = lastAcceptToken;\n";
+    code += "\treturn lastAcceptPos;\n";
     code += "}\n\n";
     
-    // 生成关键字检查函数
-    code += "// 关键字列表\n";
-    code += "bool isKeyword(const string &lexeme) {\n";
-    code += "    static const string keywords[] = {";
+    // 生成主函数
+    code += generateStreamMain();
     
-    // 收集关键字
-    QStringList keywords;
-    for (const RegexItem &item : regexItems) {
-        if (item.isMultiWord && item.name.contains("keyword", Qt::CaseInsensitive)) {
-            for (const QString &word : item.wordList) {
-                QString escapedWord = word;
-                escapedWord.replace("\"", "\\\"");
-                escapedWord.replace("\\", "\\\\");
-                keywords << "\"" + escapedWord + "\"";
+    return code;
+}
+
+/**
+ * @brief 生成直接编码法中一个状态的区间分派代码
+ * 
+ * 区间不超过DIRECT_CODED_LINEAR_LIMIT个时逐个比较，
+ * 否则以中间区间的下界为界二分，比较次数为区间数的对数
+ * 
+ * @param ranges 按字节升序排列且互不相交的区间
+ * @param first 本次处理的第一个区间下标
+ * @param last 本次处理的最后一个区间下标
+ * @param isAccept 每个状态是否为接受状态
+ * @param depth 缩进层数
+ * @return QString 生成的分派代码，匹配时扫描指针前移并goto到后继状态
+ */
+QString LexerGenerator::generateDirectCodedDispatch(const QList<DirectCodedRange> &ranges, int first, int last,
+                                                    const QVector<bool> &isAccept, int depth)
+{
+    const QString indent(depth, '\t');
+    QString code;
+    
+    if (last - first + 1 > DIRECT_CODED_LINEAR_LIMIT) {
+        int middle = (first + last + 1) / 2;
+        code += indent + "if (c < " + charLiteral(ranges[middle].low) + ") {\n";
+        code += generateDirectCodedDispatch(ranges, first, middle - 1, isAccept, depth + 1);
+        code += indent + "} else {\n";
+        code += generateDirectCodedDispatch(ranges, middle, last, isAccept, depth + 1);
+        code += indent + "}\n";
+        return code;
+    }
+    
+    for (int i = first; i <= last; ++i) {
+        const DirectCodedRange &range = ranges[i];
+        if (range.low == range.high) {
+            code += indent + "if (c == " + charLiteral(range.low) + ") {\n";
+        } else {
+            code += indent + "if (c >= " + charLiteral(range.low) + " && c <= " + charLiteral(range.high) + ") {\n";
+        }
+        code += indent + "\t++p;\n";
+        code += indent + "\tgoto " + (isAccept[range.target] ? "accept_" : "state_") + QString::number(range.target) + ";\n";
+        code += indent + "}\n";
+    }
+    return code;
+}
+
+/**
+ * @brief 找出可以做自环加速的状态
+ * 
+ * @param minimizedDFA 最小化DFA
+ * @return QMap<DFAState, SelfLoopRun> 状态 -> 自环字节集合
+ */
+QMap<DFAState, SelfLoopRun> LexerGenerator::collectSelfLoopRuns(const DFA &minimizedDFA)
+{
+    QMap<DFAState, QList<CharRange>> loopRanges;
+    for (const DFATransition &transition : minimizedDFA.transitions) {
+        if (transition.fromState != transition.toState) {
+            continue;
+        }
+        for (const CharRange &range : SymbolTable::ranges(transition.input)) {
+            if (range.low > 0xFF) {
+                break; // 按字节匹配
             }
+            loopRanges[transition.fromState].append({range.low, qMin<ushort>(range.high, 0xFF)});
         }
     }
     
-    // 添加默认关键字
-    if (keywords.isEmpty()) {
-        keywords << "\"if\"" << "\"then\"" << "\"else\"" << "\"end\"" << "\"read\"" << "\"write\"" << "\"repeat\"" << "\"until\"";
+    QMap<DFAState, SelfLoopRun> runs;
+    for (auto it = loopRanges.constBegin(); it != loopRanges.constEnd(); ++it) {
+        const QList<CharRange> loop = SymbolTable::normalizeRanges(it.value());
+        int bytes = 0;
+        QList<CharRange> complement;
+        int next = 0;
+        for (const CharRange &range : loop) {
+            bytes += range.high - range.low + 1;
+            if (range.low > next) {
+                complement.append({static_cast<ushort>(next), static_cast<ushort>(range.low - 1)});
+            }
+            next = range.high + 1;
+        }
+        if (next <= 0xFF) {
+            complement.append({static_cast<ushort>(next), 0xFF});
+        }
+        if (bytes < SELF_LOOP_MIN_BYTES) {
+            continue;
+        }
+        
+        SelfLoopRun run;
+        run.stopSet = complement.size() < loop.size();
+        run.ranges = run.stopSet ? complement : loop;
+        if (run.ranges.size() <= SIMD_RUN_MAX_RANGES) {
+            runs.insert(it.key(), run);
+        }
     }
+    return runs;
+}
+
+/**
+ * @brief 生成SIMD支持代码
+ * 
+ * @return QString 生成的代码
+ */
+QString LexerGenerator::generateSimdSupport()
+{
+    QString code;
     
-    code += keywords.join(", ");
-    code += "};\n";
-    code += "    static const int keywordCount = sizeof(keywords) / sizeof(keywords[0]);\n";
-    code += "    \n";
-    code += "    for (int i = 0; i < keywordCount; i++) {\n";
-    code += "        if (lexeme == keywords[i]) {\n";
-    code += "            return true;\n";
-    code += "        }\n";
-    code += "    }\n";
-    code += "    return false;\n";
+    code += "// 自环加速：按编译器开启的指令集选择AVX2/SSE2，都不可用时逐字节扫描\n";
+    code += "#if defined(__AVX2__)\n";
+    code += "#include <immintrin.h>\n";
+    code += "#define LEXER_USE_AVX2 1\n";
+    code += "#endif\n";
+    code += "#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)\n";
+    code += "#include <emmintrin.h>\n";
+    code += "#define LEXER_USE_SSE2 1\n";
+    code += "#endif\n";
+    code += "#if defined(_MSC_VER)\n";
+    code += "#include <intrin.h>\n";
+    code += "#endif\n\n";
+    code += "inline unsigned int lexerCountTrailingZeros(unsigned int mask) {\n";
+    code += "#if defined(_MSC_VER)\n";
+    code += "\tunsigned long index;\n";
+    code += "\t_BitScanForward(&index, mask);\n";
+    code += "\treturn index;\n";
+    code += "#else\n";
+    code += "\treturn __builtin_ctz(mask);\n";
+    code += "#endif\n";
     code += "}\n\n";
+    
+    return code;
+}
 
-    // 生成词法分析函数
-    code += "void analyzeToken() {\n";
-    code += "\tint state = " + QString::number(minimizedDFA.startState) + ";\n";
-    code += "\tint lastAcceptState = -1;\n";
-    code += "\tint lastAcceptPos = read_cnt;\n";
-    code += "\tchar c;\n";
-    code += "\tbuf.clear();\n\n";
-    code += "\twhile ((c = in.peek()) != EOF) {\n";
-    code += "\t\tint nextState = getNextState(state, c);\n";
-    code += "\t\tif (nextState != ERROR_STATE) {\n";
-    code += "\t\t\tstate = nextState;\n";
-    code += "\t\t\tbuf += c;\n";
-    code += "\t\t\tin.get(c);\n";
-    code += "\t\t\tread_cnt++;\t\t\t\n";
-    code += "\t\t\tif (isAcceptState[state]) {\n";
-    code += "\t\t\t\tlastAcceptState = state;\n";
-    code += "\t\t\t\tlastAcceptPos = read_cnt;\n";
-    code += "\t\t\t}\n";
-    code += "\t\t}\n";
-    code += "\t\telse {\n";
-    code += "\t\t\tbreak;\n";
-    code += "\t\t}\n";
-    code += "\t}\n\n";
-    code += "\tif (lastAcceptState != -1) {\n";
-    code += "\t\t// 回退到最后一个接受状态\n";
-    code += "\t\tint backoff = read_cnt - lastAcceptPos;\n";
-    code += "\t\tin.seekg(-backoff, ios::cur);\n";
-    code += "\t\tread_cnt = lastAcceptPos;\n";
-    code += "\t\tbuf.resize(buf.size() - backoff);\t\t\n";
-    code += "\t\t\n";
-    code += "\t\t// 输出格式：单词\t编码\n";
-    code += "\t\tint tokenCode = acceptTokens[lastAcceptState];\n";
-    code += "\n";
-    code += "\t\t// 检查是否在token映射表中（多单词编码）\n";
-    code += "\t\t// 首先尝试精确匹配\n";
-    code += "\t\tauto it = tokenCodeMap.find(buf);\n";
-    code += "\t\tif (it != tokenCodeMap.end()) {\n";
-    code += "\t\t\ttokenCode = it->second;\n";
+/**
+ * @brief 生成跳过一段字节的扫描函数
+ * 
+ * 区间[lo, hi]的SIMD判断为min(x - lo, hi - lo) == x - lo（无符号字节比较），
+ * 单个字节直接比较相等，各区间的结果按位或；
+ * movemask得到每个字节的命中位后，停止位的最低位即为这一段的结束位置
+ * 
+ * @param name 函数名
+ * @param run 字节集合
+ * @return QString 生成的扫描函数代码
+ */
+QString LexerGenerator::generateRunScanner(const QString &name, const SelfLoopRun &run)
+{
+    // 生成把各区间的命中结果按位或到hits的语句，prefix为指令前缀，vector为向量类型
+    auto hitsStatements = [&run](const QString &prefix, const QString &vector) {
+        QString code;
+        for (int i = 0; i < run.ranges.size(); ++i) {
+            const CharRange &range = run.ranges[i];
+            QString test;
+            if (range.low == range.high) {
+                test = QString("%1_cmpeq_epi8(x, %1_set1_epi8(static_cast<char>(%2)))").arg(prefix).arg(range.low);
+            } else {
+                code += QString("\t\tconst %1 t%2 = %3_sub_epi8(x, %3_set1_epi8(static_cast<char>(%4)));\n")
+                        .arg(vector).arg(i).arg(prefix).arg(range.low);
+                test = QString("%1_cmpeq_epi8(%1_min_epu8(t%2, %1_set1_epi8(static_cast<char>(%3))), t%2)")
+                       .arg(prefix).arg(i).arg(range.high - range.low);
+            }
+            if (i == 0) {
+                code += QString("\t\t%1 hits = %2;\n").arg(vector, test);
+            } else {
+                code += QString("\t\thits = %1_or_%2(hits, %3);\n").arg(prefix, vector == "__m256i" ? "si256" : "si128", test);
+            }
+        }
+        return code;
+    };
+    
+    QString code;
+    code += "inline const unsigned char *" + name + "(const unsigned char *p, const unsigned char *end) {\n";
+    if (run.ranges.isEmpty()) {
+        // 自环覆盖全部字节
+        code += "\treturn end;\n";
+        code += "}\n\n";
+        return code;
+    }
+    
+    const QString condition = generateCharCondition(run.ranges, "*p");
+    const QString inRun = run.stopSet ? "!(" + condition + ")" : "(" + condition + ")";
+    
+    // 多数自环很短，第一个字节就不在自环上时不做向量比较
+    code += "\tif (p == end || !" + inRun + ") {\n";
+    code += "\t\treturn p;\n";
+    code += "\t}\n";
+    code += "#ifdef LEXER_USE_AVX2\n";
+    code += "\twhile (end - p >= 32) {\n";
+    code += "\t\tconst __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));\n";
+    code += hitsStatements("_mm256", "__m256i");
+    code += "\t\tconst unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(hits));\n";
+    code += run.stopSet ? "\t\tconst unsigned int stop = mask;\n" : "\t\tconst unsigned int stop = ~mask;\n";
+    code += "\t\tif (stop != 0) {\n";
+    code += "\t\t\treturn p + lexerCountTrailingZeros(stop);\n";
     code += "\t\t}\n";
-    code += "\t\t// 尝试转义后的形式（处理*+^等特殊字符）\n";
-    code += "\t\telse {\n";
-    code += "\t\t\tstring escapedBuf = \"\\\\\" + buf + \"\\\\\";\n";
-    code += "\t\t\tauto escapedIt = tokenCodeMap.find(escapedBuf);\n";
-    code += "\t\t\tif (escapedIt != tokenCodeMap.end()) {\n";
-    code += "\t\t\t\ttokenCode = escapedIt->second;\n";
-    code += "\t\t\t}\n";
-    code += "\t\t\t// 然后尝试大小写不敏感匹配\n";
-    code += "\t\t\telse {\n";
-    code += "\t\t\t\tstring lowercaseBuf;\n";
-    code += "\t\t\t\tfor (char ch : buf) {\n";
-    code += "\t\t\t\t\tlowercaseBuf += tolower(static_cast<unsigned char>(ch));\n";
-    code += "\t\t\t\t}\n";
-    code += "\t\t\t\tauto lowercaseIt = tokenCodeMap.find(lowercaseBuf);\n";
-    code += "\t\t\t\tif (lowercaseIt != tokenCodeMap.end()) {\n";
-    code += "\t\t\t\t\ttokenCode = lowercaseIt->second;\n";
-    code += "\t\t\t\t}\n";
-    code += "\t\t\t}\n";
+    code += "\t\tp += 32;\n";
+    code += "\t}\n";
+    code += "#endif\n";
+    code += "#ifdef LEXER_USE_SSE2\n";
+    code += "\twhile (end - p >= 16) {\n";
+    code += "\t\tconst __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));\n";
+    code += hitsStatements("_mm", "__m128i");
+    code += "\t\tconst unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(hits));\n";
+    code += run.stopSet ? "\t\tconst unsigned int stop = mask;\n" : "\t\tconst unsigned int stop = ~mask & 0xFFFFu;\n";
+    code += "\t\tif (stop != 0) {\n";
+    code += "\t\t\treturn p + lexerCountTrailingZeros(stop);\n";
     code += "\t\t}\n";
-    code += "\n";
-    code += "\t\tcout << buf << '\t' << tokenCode << endl;\n";
+    code += "\t\tp += 16;\n";
     code += "\t}\n";
-    code += "\telse {\n";
-    code += "\t\t// 跳过无法识别的字符\n";
-    code += "\t\tbuf.clear();\n";
-    code += "\t\tin.get();\n";
-    code += "\t\tread_cnt++;\n";
+    code += "#endif\n";
+    code += "\twhile (p < end && " + inRun + ") {\n";
+    code += "\t\t++p;\n";
     code += "\t}\n";
+    code += "\treturn p;\n";
     code += "}\n\n";
+    return code;
+}
 
-    // 生成主函数
-    code += "int main(int argc, char *argv[]) {\n";
-
-    code += "\tif (argc < 2) {\n";
-    code += "\t\tcerr << \"Usage: \" << argv[0] << \" <source_file>\" << endl;\n";
-    code += "\t\treturn 1;\n";
-    code += "\t}\n\n";
-    code += "\t// 打开输入文件\n";
-    code += "\tin.open(argv[1], ios::in);\n";
-    code += "\tif (!in.is_open()) {\n";
-    code += "\t\tcerr << \"Error: Could not open file '\" << argv[1] << \"'.\" << endl;\n";
-    code += "\t\treturn 1;\n";
-    code += "\t}\n\n";
-    code += "\t// 初始化token代码映射表\n";
-    code += "\tinitializeTokenCodeMap();\n\n";
-    code += "\t// 跳过初始空白字符\n";
-    code += "\tskipBlank();\n\n";
-    code += "\t// 主循环\n";
-    code += "\twhile (in.peek() != EOF) {\n";
-    code += "\t\tanalyzeToken();\n";
-    code += "\t\tskipBlank();\n";
-    code += "\t}\n\n";
-    code += "\t// 关闭文件\n";
-    code += "\tin.close();\n";
-    code += "\treturn 0;\n";
-    code += "}\n";
-
+/**
+ * @brief 生成各状态的自环扫描函数
+ * 
+ * @param runs 状态 -> 自环字节集合
+ * @param scannerNames 输出参数，状态 -> 扫描函数名
+ * @return QString 生成的扫描函数代码
+ */
+QString LexerGenerator::generateSelfLoopScanners(const QMap<DFAState, SelfLoopRun> &runs, QMap<DFAState, QString> &scannerNames)
+{
+    QString code;
+    QMap<QString, QString> nameByKey;
+    scannerNames.clear();
+    
+    for (auto it = runs.constBegin(); it != runs.constEnd(); ++it) {
+        QString key = it.value().stopSet ? "^" : "";
+        for (const CharRange &range : it.value().ranges) {
+            key += QString("%1-%2,").arg(range.low).arg(range.high);
+        }
+        
+        QString name = nameByKey.value(key);
+        if (name.isEmpty()) {
+            name = QString("scanRun%1").arg(nameByKey.size());
+            nameByKey.insert(key, name);
+            code += QString("// 自环扫描：%1%2\n")
+                    .arg(it.value().stopSet ? "直到遇到" : "跳过")
+                    .arg(generateCharCondition(it.value().ranges, "c"));
+            code += generateRunScanner(name, it.value());
+        }
+        scannerNames.insert(it.key(), name);
+    }
     return code;
 }
 
@@ -552,7 +1128,7 @@ QString LexerGenerator::generateStateTransitionTable(const DFA &minimizedDFA)
 {
     QString code;
 
-    code += "// DFA状态转移表（嵌套switch-case结构）\n";
+    code += "// DFA状态转移表（switch-case结构，转移条件为字符区间判断）\n";
     code += "const int NUM_STATES = " + QString::number(minimizedDFA.states.size()) + ";\n";
     code += "const int ERROR_STATE = -1;\n\n";
 
@@ -577,144 +1153,28 @@ QString LexerGenerator::generateStateTransitionTable(const DFA &minimizedDFA)
     // 生成状态转移函数声明
     code += "// 状态转移函数\n";
     code += "int getNextState(int currentState, char input) {\n";
+    code += "    unsigned char c = (unsigned char)input;\n";
     code += "    switch(currentState) {\n";
 
     // 为每个状态生成case分支
     for (int state = 0; state < minimizedDFA.states.size(); state++) {
-        code += QString("        case %1: {\n").arg(state);
-        code += "            switch(input) {\n";
-
-        // 收集当前状态的所有转移
-        QMap<QString, int> transitionsFromState;
+        // 按目标状态归并字符区间，同一目标只生成一个判断
+        QMap<int, QList<CharRange>> rangesByTarget;
         for (const auto &transition : minimizedDFA.transitions) {
             if (transition.fromState == state) {
-                transitionsFromState[transition.input] = transition.toState;
+                rangesByTarget[transition.toState].append(SymbolTable::ranges(transition.input));
             }
         }
 
-        // 处理特殊字符
-        if (transitionsFromState.contains("\n")) {
-            code += "                case '\n':\n";
-            code += QString("                    return %1;\n").arg(transitionsFromState["\n"]);
-            transitionsFromState.remove("\n");
-        }
-        if (transitionsFromState.contains("\t")) {
-            code += "                case '\t':\n";
-            code += QString("                    return %1;\n").arg(transitionsFromState["\t"]);
-            transitionsFromState.remove("\t");
-        }
-        if (transitionsFromState.contains("\r")) {
-            code += "                case '\r':\n";
-            code += QString("                    return %1;\n").arg(transitionsFromState["\r"]);
-            transitionsFromState.remove("\r");
-        }
-        if (transitionsFromState.contains("\0")) {
-            code += "                case '\0':\n";
-            code += QString("                    return %1;\n").arg(transitionsFromState["\0"]);
-            transitionsFromState.remove("\0");
-        }
-
-        // 处理字符类和范围
-        // 检查是否有数字范围的转移
-        bool hasDigitTransition = false;
-        int digitToState = -1;
-        for (const auto &transition : minimizedDFA.transitions) {
-            if (transition.fromState == state && (transition.input == "digit" || transition.input == "[0-9]")) {
-                hasDigitTransition = true;
-                digitToState = transition.toState;
-                break;
+        code += QString("        case %1:\n").arg(state);
+        for (auto it = rangesByTarget.constBegin(); it != rangesByTarget.constEnd(); ++it) {
+            QString condition = generateCharCondition(it.value(), "c");
+            if (!condition.isEmpty()) {
+                code += QString("            if (%1)\n").arg(condition);
+                code += QString("                return %1;\n").arg(it.key());
             }
         }
-        
-        // 检查是否有字母范围的转移
-        bool hasAlphaTransition = false;
-        int alphaToState = -1;
-        for (const auto &transition : minimizedDFA.transitions) {
-            if (transition.fromState == state && (transition.input == "letter" || transition.input == "[A-Za-z]")) {
-                hasAlphaTransition = true;
-                alphaToState = transition.toState;
-                break;
-            }
-        }
-        
-        // 检查是否有字母数字范围的转移
-        bool hasAlnumTransition = false;
-        int alnumToState = -1;
-        for (const auto &transition : minimizedDFA.transitions) {
-            if (transition.fromState == state && (transition.input == "alnum" || transition.input == "[A-Za-z0-9]")) {
-                hasAlnumTransition = true;
-                alnumToState = transition.toState;
-                break;
-            }
-        }
-
-        // 生成数字范围的转移
-        if (hasDigitTransition) {
-            code += "                case '0': case '1': case '2': case '3': case '4':\n";
-            code += "                case '5': case '6': case '7': case '8': case '9':\n";
-            code += QString("                    return %1;\n").arg(digitToState);
-        }
-
-        // 生成字母范围的转移
-        if (hasAlphaTransition) {
-            code += "                case 'a': case 'b': case 'c': case 'd': case 'e': case 'f': case 'g':\n";
-            code += "                case 'h': case 'i': case 'j': case 'k': case 'l': case 'm': case 'n':\n";
-            code += "                case 'o': case 'p': case 'q': case 'r': case 's': case 't': case 'u':\n";
-            code += "                case 'v': case 'w': case 'x': case 'y': case 'z':\n";
-            code += "                case 'A': case 'B': case 'C': case 'D': case 'E': case 'F': case 'G':\n";
-            code += "                case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':\n";
-            code += "                case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U':\n";
-            code += "                case 'V': case 'W': case 'X': case 'Y': case 'Z':\n";
-            code += QString("                    return %1;\n").arg(alphaToState);
-        }
-
-        // 生成字母数字范围的转移
-        if (hasAlnumTransition) {
-            code += "                case '0': case '1': case '2': case '3': case '4':\n";
-            code += "                case '5': case '6': case '7': case '8': case '9':\n";
-            code += "                case 'a': case 'b': case 'c': case 'd': case 'e': case 'f': case 'g':\n";
-            code += "                case 'h': case 'i': case 'j': case 'k': case 'l': case 'm': case 'n':\n";
-            code += "                case 'o': case 'p': case 'q': case 'r': case 's': case 't': case 'u':\n";
-            code += "                case 'v': case 'w': case 'x': case 'y': case 'z':\n";
-            code += "                case 'A': case 'B': case 'C': case 'D': case 'E': case 'F': case 'G':\n";
-            code += "                case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':\n";
-            code += "                case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U':\n";
-            code += "                case 'V': case 'W': case 'X': case 'Y': case 'Z':\n";
-            code += QString("                    return %1;\n").arg(alnumToState);
-        }
-
-        // 处理其他单个字符
-        QMap<QString, int>::const_iterator it;
-        for (it = transitionsFromState.constBegin(); it != transitionsFromState.constEnd(); ++it) {
-            QString input = it.key();
-            int toState = it.value();
-            
-            // 跳过已经处理过的字符类
-            if (input == "digit" || input == "[0-9]" || 
-                input == "letter" || input == "[A-Za-z]" || 
-                input == "alnum" || input == "[A-Za-z0-9]") {
-                continue;
-            }
-            
-            // 处理转义字符
-            if (input == "\\\\") {
-                input = "\\\\\\\\";
-            } else if (input == "\\\'") {
-                input = "\\\\'";
-            } else if (input == "\"" || input == "\\" || input == "'") {
-                // 只转义双引号、反斜杠和单引号，不需要转义其他特殊字符
-                input = "\\" + input;
-            }
-            
-            code += QString("                case '%1':\n").arg(input);
-            code += QString("                    return %1;\n").arg(toState);
-        }
-
-        // 处理默认情况
-        code += "                default:\n";
-        code += "                    return ERROR_STATE;\n";
-        code += "            }\n";
-        code += "        }\n";
+        code += "            return ERROR_STATE;\n";
     }
 
     code += "        default:\n";
@@ -726,147 +1186,242 @@ QString LexerGenerator::generateStateTransitionTable(const DFA &minimizedDFA)
 }
 
 /**
- * @brief 生成接受状态映射
+ * @brief 生成表驱动的状态转移表
  * 
- * 生成接受状态到token代码的映射代码
+ * 稠密表时getNextState即transitionTable[state][byteClass[c]]，编译器内联后热循环只有两次查表；
+ * 压缩表时沿默认状态链查找，未命中时返回ERROR_STATE
  * 
- * @param regexItems 正则表达式项列表
  * @param minimizedDFA 最小化DFA
- * @return QString 生成的接受状态映射代码
+ * @return QString 生成的转移表与getNextState函数代码
  */
-QString LexerGenerator::generateAcceptStatesMap(const QList<RegexItem> &regexItems, const DFA &minimizedDFA)
+QString LexerGenerator::generateTableDrivenTransitions(const DFA &minimizedDFA)
 {
-    QString code;
-
-    int numStates = minimizedDFA.states.size();
-    QVector<bool> isAccept(numStates, false);
-    QVector<int> tokens(numStates, -1);
-
-    // 1. 标记所有接受状态
-    for (const int &state : minimizedDFA.acceptStates) {
-        if (state >= 0 && state < numStates) {
-            isAccept[state] = true;
-        }
-    }
-
-    // 2. 为每个接受状态分配正确的tokenCode
-    // 初始化tokens数组为-1
-    for (int i = 0; i < numStates; i++) {
-        tokens[i] = -1;
+    DFATablePacker packer;
+    DenseDFATable dense;
+    if (!packer.buildDenseTable(minimizedDFA, dense)) {
+        m_errorMessage = packer.getErrorMessage();
+        return "";
     }
-
-    // 填充接受状态和对应的token代码
-    for (const auto &state : minimizedDFA.acceptStates) {
-        if (state >= 0 && state < numStates) {
-            // 先尝试从DFA的映射中获取正则表达式索引
-            int regexIndex = -1;
-            if (minimizedDFA.acceptStateToRegexIndex.contains(state)) {
-                regexIndex = minimizedDFA.acceptStateToRegexIndex[state];
-            }
-
-            // 确保索引有效
-            if (regexIndex >= 0 && regexIndex < regexItems.size()) {
-                // 获取对应的正则表达式项
-                const RegexItem &item = regexItems[regexIndex];
-                
-                // 为接受状态分配token代码
-                tokens[state] = item.code;
-                
-                // 对于多单词项，处理编码递增
-                if (item.isMultiWord) {
-                    // 多单词项的编码处理
-                }
+    
+    // 出错状态取NUM_STATES，所有数组都可以用无符号类型
+    const int numStates = dense.stateCount;
+    auto remapError = [numStates](QVector<qint32> values) {
+        for (qint32 &value : values) {
+            if (value < 0) {
+                value = numStates;
             }
         }
-    }
+        return values;
+    };
+    const QString stateType = unsignedTypeName(DFATablePacker::integerBytes(0, numStates));
     
-    // 确保所有正则表达式项都有对应的接受状态映射
-    // 特别处理那些在regex_items中明确定义的项
-    QMap<int, bool> codeMapped;
+    QString code;
+    code += "const int NUM_STATES = " + QString::number(numStates) + ";\n";
+    code += "const int NUM_CLASSES = " + QString::number(dense.classCount) + ";\n";
+    code += "const int ERROR_STATE = NUM_STATES;\n\n";
     
-    // 首先，标记已经映射的代码
-    for (const auto &state : minimizedDFA.acceptStates) {
-        if (state >= 0 && state < numStates) {
-            if (tokens[state] != -1) {
-                codeMapped[tokens[state]] = true;
-            }
-        }
+    QVector<qint32> byteClasses;
+    for (quint8 classIndex : std::as_const(dense.byteClasses)) {
+        byteClasses.append(classIndex);
     }
+    code += "// 字节 -> 等价类\n";
+    code += "const unsigned char byteClass[256] = " + integerArrayInitializer(byteClasses, 16) + ";\n\n";
     
-    // 然后，为没有映射的代码找到接受状态
-    for (const RegexItem &item : regexItems) {
-        if (!codeMapped.contains(item.code)) {
-            // 为这个代码找到第一个可用的接受状态
-            for (const auto &state : minimizedDFA.acceptStates) {
-                if (state >= 0 && state < numStates) {
-                    if (tokens[state] == -1) {
-                        tokens[state] = item.code;
-                        codeMapped[item.code] = true;
-                        break;
-                    }
+    const qint64 denseBytes = static_cast<qint64>(dense.transitions.size()) * DFATablePacker::integerBytes(0, numStates);
+    if (denseBytes <= DENSE_TABLE_LIMIT) {
+        const QVector<qint32> transitions = remapError(dense.transitions);
+        code += "// DFA状态转移表（稠密表，按状态行优先）\n";
+        code += "const " + stateType + " transitionTable[NUM_STATES][NUM_CLASSES] = {\n";
+        for (int state = 0; state < numStates; ++state) {
+            code += "    {";
+            for (int classIndex = 0; classIndex < dense.classCount; ++classIndex) {
+                if (classIndex > 0) {
+                    code += ", ";
                 }
+                code += QString::number(transitions[state * dense.classCount + classIndex]);
             }
+            code += (state + 1 < numStates) ? "},\n" : "}\n";
         }
+        code += "};\n\n";
+        
+        code += "// 状态转移函数\n";
+        code += "inline int getNextState(int currentState, char input) {\n";
+        code += "    return transitionTable[currentState][byteClass[(unsigned char)input]];\n";
+        code += "}\n\n";
+        return code;
     }
     
-    // 额外确保所有正则表达式项都有对应的映射
-    // 遍历所有正则表达式项，确保每个都有对应的接受状态
-    for (const RegexItem &item : regexItems) {
-        if (!codeMapped.contains(item.code)) {
-            // 找到第一个可用的接受状态
-            for (int i = 0; i < numStates; i++) {
-                if (isAccept[i] && tokens[i] == -1) {
-                    tokens[i] = item.code;
-                    codeMapped[item.code] = true;
-                    break;
-                }
-            }
+    const PackedDFATable packed = packer.pack(dense);
+    const QString indexType = unsignedTypeName(packed.indexBytes);
+    code += "// DFA状态转移表（行位移压缩：check[base[s] + k] == s时后继为next[base[s] + k]，否则查默认状态）\n";
+    code += "const int PACKED_SIZE = " + QString::number(packed.next.size()) + ";\n";
+    code += "const " + indexType + " packedBase[NUM_STATES] = " + integerArrayInitializer(packed.base, 16) + ";\n";
+    code += "const " + stateType + " packedDefault[NUM_STATES] = " + integerArrayInitializer(remapError(packed.defaults), 16) + ";\n";
+    code += "const " + stateType + " packedNext[PACKED_SIZE] = " + integerArrayInitializer(remapError(packed.next), 16) + ";\n";
+    code += "const " + stateType + " packedCheck[PACKED_SIZE] = " + integerArrayInitializer(remapError(packed.check), 16) + ";\n\n";
+    
+    code += "// 状态转移函数\n";
+    code += "inline int getNextState(int currentState, char input) {\n";
+    code += "    const int cls = byteClass[(unsigned char)input];\n";
+    code += "    for (int s = currentState; s != ERROR_STATE; s = packedDefault[s]) {\n";
+    code += "        const int slot = packedBase[s] + cls;\n";
+    code += "        if (packedCheck[slot] == s) {\n";
+    code += "            return packedNext[slot];\n";
+    code += "        }\n";
+    code += "    }\n";
+    code += "    return ERROR_STATE;\n";
+    code += "}\n\n";
+    return code;
+}
+
+/**
+ * @brief 生成整数数组的初始化列表
+ * 
+ * @param values 数组元素
+ * @param perLine 每行元素个数
+ * @return QString 初始化列表
+ */
+QString LexerGenerator::integerArrayInitializer(const QVector<qint32> &values, int perLine)
+{
+    QString code = "{\n";
+    for (int i = 0; i < values.size(); ++i) {
+        if (i % perLine == 0) {
+            code += "    ";
+        }
+        code += QString::number(values[i]);
+        if (i + 1 < values.size()) {
+            code += (i % perLine == perLine - 1) ? ",\n" : ", ";
         }
     }
-    
-    // 确保注释编码正确映射
-    // 遍历所有正则表达式项，找到注释项并确保其编码正确映射
-    for (const RegexItem &item : regexItems) {
-        if (item.name.contains("comment", Qt::CaseInsensitive)) {
-            // 找到一个未分配编码的接受状态并映射注释编码
-            bool foundState = false;
-            for (int i = 0; i < numStates; i++) {
-                if (isAccept[i] && tokens[i] == -1) {
-                    tokens[i] = item.code;
-                    codeMapped[item.code] = true;
-                    foundState = true;
-                    break;
-                }
-            }
-            // 如果没有未分配的接受状态，找到一个不是多单词编码的接受状态
-            if (!foundState) {
-                for (int i = 0; i < numStates; i++) {
-                    if (isAccept[i]) {
-                        // 检查该编码是否属于多单词项
-                        bool isMultiWordCode = false;
-                        for (const RegexItem &multiItem : regexItems) {
-                            if (multiItem.isMultiWord && multiItem.code == tokens[i]) {
-                                isMultiWordCode = true;
-                                break;
-                            }
-                        }
-                        if (!isMultiWordCode) {
-                            tokens[i] = item.code;
-                            codeMapped[item.code] = true;
-                            break;
-                        }
-                    }
-                }
-            }
+    code += "\n}";
+    return code;
+}
+
+/**
+ * @brief 获取指定字节数的无符号整数类型名
+ * 
+ * @param bytes 字节数：1、2或4
+ * @return QString C++类型名
+ */
+QString LexerGenerator::unsignedTypeName(int bytes)
+{
+    if (bytes == 1) {
+        return "unsigned char";
+    }
+    return bytes == 2 ? "unsigned short" : "unsigned int";
+}
+
+/**
+ * @brief 生成字符区间判断条件
+ * 
+ * @param ranges 字符区间列表
+ * @param var 被判断的字符变量表达式
+ * @return QString 判断条件
+ */
+QString LexerGenerator::generateCharCondition(const QList<CharRange> &ranges, const QString &var)
+{
+    QStringList terms;
+    for (const CharRange &range : SymbolTable::normalizeRanges(ranges)) {
+        if (range.low > 0xFF) {
+            break; // 生成的词法分析器按字节匹配
+        }
+        ushort high = qMin<ushort>(range.high, 0xFF);
+        if (range.low == high) {
+            terms << QString("%1 == %2").arg(var, charLiteral(range.low));
+        } else if (range.low == 0 && high == 0xFF) {
+            terms << "true";
+        } else if (range.low == 0) {
+            terms << QString("%1 <= %2").arg(var, charLiteral(high));
+        } else if (high == 0xFF) {
+            terms << QString("%1 >= %2").arg(var, charLiteral(range.low));
+        } else {
+            terms << QString("(%1 >= %2 && %1 <= %3)").arg(var, charLiteral(range.low), charLiteral(high));
+        }
+    }
+    return terms.join(" || ");
+}
+
+/**
+ * @brief 生成字符的C++字面量
+ * 
+ * @param c 字符编码
+ * @return QString 字符字面量
+ */
+QString LexerGenerator::charLiteral(ushort c)
+{
+    switch (c) {
+    case '\n': return "'\\n'";
+    case '\t': return "'\\t'";
+    case '\r': return "'\\r'";
+    case '\\': return "'\\\\'";
+    case '\'': return "'\\''";
+    default:
+        break;
+    }
+    if (c >= 0x20 && c < 0x7F) {
+        return QString("'%1'").arg(QChar(c));
+    }
+    return QString::number(c);
+}
+
+/**
+ * @brief 计算接受状态的token代码
+ * 
+ * 最小化按token划分接受状态，因此每个接受状态的正则表达式索引与单词下标都是准确的：
+ * 多单词项的编码为RegexItem::code加单词下标，其余为RegexItem::code。
+ * 生成的代码与编译后的二进制词法分析器共用同一结果
+ * 
+ * @param regexItems 正则表达式项列表
+ * @param minimizedDFA 最小化DFA
+ * @param isAccept 输出参数，每个状态是否为接受状态
+ * @param tokens 输出参数，每个状态的token代码，未映射为-1
+ */
+void LexerGenerator::computeAcceptTokens(const QList<RegexItem> &regexItems, const DFA &minimizedDFA,
+                                         QVector<bool> &isAccept, QVector<int> &tokens)
+{
+    int numStates = minimizedDFA.states.size();
+    isAccept = QVector<bool>(numStates, false);
+    tokens = QVector<int>(numStates, -1);
+
+    for (const auto &state : minimizedDFA.acceptStates) {
+        if (state < 0 || state >= numStates) {
+            continue;
+        }
+        isAccept[state] = true;
+        
+        int regexIndex = minimizedDFA.acceptStateToRegexIndex.value(state, -1);
+        if (regexIndex < 0 || regexIndex >= regexItems.size()) {
+            continue;
         }
+        
+        // 多单词项中未被单词到达的接受状态（正则表达式比单词列表更宽）使用基础编码
+        tokens[state] = regexItems[regexIndex].code + minimizedDFA.acceptStateToWordIndex.value(state, 0);
     }
+}
 
-    // 对于没有映射的接受态，保持-1，由tokenCodeMap覆盖
-    // 非多单词接受态应该已经通过映射获得了正确的tokenCode
-    // 多单词接受态由tokenCodeMap处理，不需要额外分配
+/**
+ * @brief 生成接受状态映射
+ * 
+ * 生成接受状态到token代码的映射代码。
+ * labelWordAcceptStates让多单词项的每个单词结束于自己的接受状态，
+ * 关键字与标识符在扫描到单词末尾时已由DFA区分开，
+ * 生成的词法分析器不需要关键字表：每个单词只查一次acceptTokens，没有哈希、比较与启动时的初始化。
+ * 两个数组都是常量，直接放在只读数据段
+ * 
+ * @param regexItems 正则表达式项列表
+ * @param minimizedDFA 最小化DFA
+ * @return QString 生成的接受状态映射代码
+ */
+QString LexerGenerator::generateAcceptStatesMap(const QList<RegexItem> &regexItems, const DFA &minimizedDFA)
+{
+    QString code;
+
+    QVector<bool> isAccept;
+    QVector<int> tokens;
+    computeAcceptTokens(regexItems, minimizedDFA, isAccept, tokens);
 
     // 生成接受状态数组
-    code += "bool isAcceptState[NUM_STATES] = {";
+    code += "const bool isAcceptState[NUM_STATES] = {";
     for (int i = 0; i < isAccept.size(); i++) {
         if (i > 0) {
             code += ", ";
@@ -876,7 +1431,7 @@ QString LexerGenerator::generateAcceptStatesMap(const QList<RegexItem> &regexIte
     code += "};\n";
 
     // 生成token代码数组
-    code += "int acceptTokens[NUM_STATES] = {";
+    code += "const int acceptTokens[NUM_STATES] = {";
     for (int i = 0; i < tokens.size(); i++) {
         if (i > 0) {
             code += ", ";
@@ -910,22 +1465,25 @@ QString LexerGenerator::generateTokenMap(const QList<RegexItem> &regexItems)
     for (const RegexItem &item : regexItems) {
         if (item.isMultiWord) {
             // 多单词情况（关键字、符号等）
-            int currentCode = item.code;
+            // 编码与computeAcceptTokens一致：RegexItem::code加单词下标，
+            // 重复的单词（按DFABuilder::labelWordAcceptStates的规则比较）取第一次出现的下标
+            QSet<QString> seenWords;
 
-            // 使用QMap来确保同一单词的不同大小写形式映射到同一个编码
-            QMap<QString, int> lowercaseToCodeMap;
+            for (int wordIndex = 0; wordIndex < item.wordList.size(); ++wordIndex) {
+                const QString &tokenValue = item.wordList[wordIndex];
 
-            for (const QString &word : item.wordList) {
-                QString lowercaseWord = word.toLower();
-                if (!lowercaseToCodeMap.contains(lowercaseWord)) {
-                    lowercaseToCodeMap[lowercaseWord] = currentCode++;
+                // 去掉转义，不区分大小写时按小写比较
+                QString wordKey;
+                for (int i = 0; i < tokenValue.length(); ++i) {
+                    if (tokenValue[i] == '\\' && i + 1 < tokenValue.length()) {
+                        ++i;
+                    }
+                    wordKey += item.caseInsensitive ? tokenValue[i].toLower() : tokenValue[i];
                 }
-            }
-
-            // 生成映射条目
-            for (auto it = lowercaseToCodeMap.constBegin(); it != lowercaseToCodeMap.constEnd(); ++it) {
-                // 正确处理转义字符
-                QString tokenValue = it.key();
+                if (seenWords.contains(wordKey)) {
+                    continue;
+                }
+                seenWords.insert(wordKey);
                 
                 // 移除多余的转义字符，特别是对于*+^等特殊字符
                 // 创建一个新字符串，跳过特殊字符前的转义
@@ -952,7 +1510,7 @@ QString LexerGenerator::generateTokenMap(const QList<RegexItem> &regexItems)
                 processedValue.replace("\"", "\\\"");
                 processedValue.replace("'", "\\'");
                 
-                mapContent += QString("%1=%2\n").arg(it.value()).arg(processedValue);
+                mapContent += QString("%1=%2\n").arg(item.code + wordIndex).arg(processedValue);
             }
         } else {
             // 单单词情况（标识符、数字等）
@@ -1002,3 +1560,98 @@ bool LexerGenerator::saveTokenMap(const QList<RegexItem> &regexItems, const QStr
 
     return true;
 }
+
+/**
+ * @brief 保存编译后的词法分析器
+ * 
+ * 用DFATablePacker把最小化DFA压缩为按字节等价类索引的行位移转移表，
+ * 连同接受状态的token代码与规格哈希写成CompiledLexerHeader描述的二进制格式
+ * 
+ * @param regexItems 正则表达式项列表
+ * @param minimizedDFA 最小化DFA
+ * @param specHash 规格哈希（CompiledLexer::hashSpec）
+ * @param outputPath 输出文件路径
+ * @return bool 保存成功返回true，失败返回false
+ */
+bool LexerGenerator::saveCompiledLexer(const QList<RegexItem> &regexItems, const DFA &minimizedDFA,
+                                       quint64 specHash, const QString &outputPath)
+{
+    DFATablePacker packer;
+    DenseDFATable dense;
+    if (!packer.buildDenseTable(minimizedDFA, dense)) {
+        m_errorMessage = packer.getErrorMessage();
+        return false;
+    }
+    const PackedDFATable packed = packer.pack(dense);
+    const int numStates = packed.stateCount;
+
+    QVector<bool> isAccept;
+    QVector<int> tokens;
+    computeAcceptTokens(regexItems, minimizedDFA, isAccept, tokens);
+
+    // 布局：文件头 | 字节等价类表 | base | default | next | check | 接受表，各段按4字节对齐
+    auto align = [](quint32 offset) {
+        return (offset + 3u) & ~3u;
+    };
+    CompiledLexerHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "BYYLLEX", 8);
+    header.version = CompiledLexer::FORMAT_VERSION;
+    header.headerSize = sizeof(CompiledLexerHeader);
+    header.byteOrderMark = 0x01020304u;
+    header.stateCount = static_cast<quint32>(numStates);
+    header.specHash = specHash;
+    header.classCount = static_cast<quint32>(packed.classCount);
+    header.startState = packed.startState;
+    header.stateBytes = static_cast<quint32>(packed.stateBytes);
+    header.indexBytes = static_cast<quint32>(packed.indexBytes);
+    header.packedSize = static_cast<quint32>(packed.next.size());
+    header.byteClassOffset = sizeof(CompiledLexerHeader);
+    header.baseOffset = align(header.byteClassOffset + 256);
+    header.defaultOffset = align(header.baseOffset + numStates * packed.indexBytes);
+    header.nextOffset = align(header.defaultOffset + numStates * packed.stateBytes);
+    header.checkOffset = align(header.nextOffset + header.packedSize * packed.stateBytes);
+    header.acceptOffset = align(header.checkOffset + header.packedSize * packed.stateBytes);
+    header.fileSize = header.acceptOffset + numStates * sizeof(qint32);
+
+    QByteArray data(static_cast<int>(header.fileSize), '\0');
+    char *out = data.data();
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + header.byteClassOffset, packed.byteClasses.constData(), 256);
+
+    // 按选定的字节数写出整数数组
+    auto writeIntegers = [out](quint32 offset, const QVector<qint32> &values, int bytes) {
+        for (int i = 0; i < values.size(); ++i) {
+            if (bytes == 1) {
+                reinterpret_cast<qint8 *>(out + offset)[i] = static_cast<qint8>(values[i]);
+            } else if (bytes == 2) {
+                reinterpret_cast<qint16 *>(out + offset)[i] = static_cast<qint16>(values[i]);
+            } else {
+                reinterpret_cast<qint32 *>(out + offset)[i] = values[i];
+            }
+        }
+    };
+    writeIntegers(header.baseOffset, packed.base, packed.indexBytes);
+    writeIntegers(header.defaultOffset, packed.defaults, packed.stateBytes);
+    writeIntegers(header.nextOffset, packed.next, packed.stateBytes);
+    writeIntegers(header.checkOffset, packed.check, packed.stateBytes);
+
+    qint32 *acceptTokens = reinterpret_cast<qint32 *>(out + header.acceptOffset);
+    for (int state = 0; state < numStates; ++state) {
+        acceptTokens[state] = isAccept[state] ? tokens[state] : CompiledLexer::NOT_ACCEPT;
+    }
+
+    QFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        m_errorMessage = QString("无法打开文件 %1 进行写入").arg(outputPath);
+        return false;
+    }
+    if (file.write(data) != data.size()) {
+        m_errorMessage = QString("写入文件 %1 失败").arg(outputPath);
+        file.close();
+        return false;
+    }
+    file.close();
+
+    return true;
+}
@@ -60,8 +60,8 @@ bool LexerTester::compileLexer(const QString &lexerCode, const QString &outputFi
         return false;
     }
     
-    // 编译命令 - 移除末尾空格，确保命令格式正确
-    QString command = QString("g++ %1 -o %2").arg(sourceFileName, outputFileName);
+    // 编译命令 - 移除末尾空格，确保命令格式正确；生成的词法分析器用std::thread分块并行识别，需要-pthread
+    QString command = QString("g++ -pthread %1 -o %2").arg(sourceFileName, outputFileName);
     
     // 执行编译命令
     QString output;
@@ -17,6 +17,7 @@
  */
 NFABuilder::NFABuilder()
     : m_nextState(0)
+    , m_caseInsensitive(false)
 {
 }
 
@@ -30,39 +31,135 @@ NFABuilder::~NFABuilder()
 }
 
 /**
- * @brief 构建NFA的邻接表
+ * @brief 构建NFA
  * 
- * 基于NFA的转换集合构建邻接表，便于快速查找状态转换
+ * 基于正则表达式项构建NFA
  * 
- * @param nfa 要构建邻接表的NFA
+ * @param regexItem 包含正则表达式模式的RegexItem对象
+ * @return NFA 构建好的NFA
  */
-void NFABuilder::buildTransitionTable(NFA &nfa)
+NFA NFABuilder::buildNFA(const RegexItem &regexItem)
 {
-    // 清空现有邻接表
-    nfa.transitionTable.clear();
+    resetStateCounter();
+    m_errorMessage.clear();
+    m_caseInsensitive = regexItem.caseInsensitive;
     
-    // 遍历所有转换，构建邻接表
-    for (const NFATransition &transition : nfa.transitions) {
-        nfa.transitionTable[transition.fromState][transition.input].insert(transition.toState);
+    NFA nfa = parseRegex(regexItem.pattern);
+    if (!m_errorMessage.isEmpty()) {
+        return NFA();
     }
+    return nfa;
 }
 
 /**
- * @brief 构建NFA
+ * @brief 构建语法树
  * 
- * 基于正则表达式项构建NFA
+ * 解析正则表达式得到语法树，用于followpos直接构造DFA，
+ * 文法、转义与字符集规则与buildNFA完全一致
  * 
  * @param regexItem 包含正则表达式模式的RegexItem对象
- * @return NFA 构建好的NFA
+ * @return RegexSyntaxTree 构建好的语法树，失败时root为-1
  */
-NFA NFABuilder::buildNFA(const RegexItem &regexItem)
+RegexSyntaxTree NFABuilder::buildSyntaxTree(const RegexItem &regexItem)
 {
-    resetStateCounter();
     m_errorMessage.clear();
+    m_caseInsensitive = regexItem.caseInsensitive;
     
-    NFA nfa = parseRegex(regexItem.pattern);
-    buildTransitionTable(nfa); // 构建邻接表
-    return nfa;
+    RegexSyntaxTree tree;
+    tree.root = -1;
+    
+    const QString &regex = regexItem.pattern;
+    int pos = 0;
+    QString error;
+    int root = parseChoiceNode(regex, pos, error, tree);
+    
+    if (!error.isEmpty()) {
+        m_errorMessage = error;
+    } else if (m_errorMessage.isEmpty() && pos < regex.length()) {
+        m_errorMessage = QString("解析错误：在位置 %1 处有未处理的字符")
+                         .arg(pos);
+    }
+    if (!m_errorMessage.isEmpty()) {
+        return RegexSyntaxTree{QVector<RegexNode>(), -1};
+    }
+    
+    tree.root = root;
+    return tree;
+}
+
+/**
+ * @brief 合并多个NFA
+ * 
+ * 将多个NFA合并为一个总NFA：各NFA的状态依次偏移编号，
+ * 新建的总起始状态用ε转移连接各NFA的起始状态
+ * 
+ * @param nfAs 要合并的NFA列表
+ * @return NFA 合并后的总NFA
+ */
+NFA NFABuilder::mergeNFAs(const QList<NFA> &nfAs)
+{
+    NFA totalNFA;
+    if (nfAs.isEmpty()) {
+        return totalNFA;
+    }
+    
+    // 状态偏移量，用于确保每个NFA的状态编号不冲突
+    int stateOffset = 0;
+    
+    // 收集所有NFA的起始状态（偏移后）
+    QList<NFAState> allStartStates;
+    
+    // 合并所有NFA的状态、转移、接受状态和字母表
+    for (const NFA &nfa : nfAs) {
+        // 处理状态
+        for (const NFAState &state : nfa.states) {
+            totalNFA.states.append(state + stateOffset);
+        }
+        
+        // 处理转移
+        for (const NFATransition &transition : nfa.transitions) {
+            NFATransition newTransition;
+            newTransition.fromState = transition.fromState + stateOffset;
+            newTransition.input = transition.input;
+            newTransition.toState = transition.toState + stateOffset;
+            totalNFA.transitions.append(newTransition);
+        }
+        
+        // 处理接受状态
+        for (const NFAState &acceptState : nfa.acceptStates) {
+            totalNFA.acceptStates.insert(acceptState + stateOffset);
+            // 处理接受状态到正则表达式索引的映射
+            if (nfa.acceptStateToRegexIndex.contains(acceptState)) {
+                int regexIndex = nfa.acceptStateToRegexIndex[acceptState];
+                totalNFA.acceptStateToRegexIndex[acceptState + stateOffset] = regexIndex;
+            }
+        }
+        
+        // 处理字母表 - 合并所有NFA的字母表
+        totalNFA.alphabet.unite(nfa.alphabet);
+        
+        // 记录偏移后的起始状态
+        allStartStates.append(nfa.startState + stateOffset);
+        
+        // 更新状态偏移量
+        stateOffset += nfa.states.size();
+    }
+    
+    // 创建总起始状态
+    NFAState totalStartState = stateOffset;
+    totalNFA.startState = totalStartState;
+    totalNFA.states.append(totalStartState);
+    
+    // 从总起始状态添加ε转移到每个NFA的起始状态
+    for (const NFAState &startState : allStartStates) {
+        NFATransition transition;
+        transition.fromState = totalStartState;
+        transition.input = SymbolTable::EPSILON; // ε转移
+        transition.toState = startState;
+        totalNFA.transitions.append(transition);
+    }
+    
+    return totalNFA;
 }
 
 /**
@@ -87,6 +184,13 @@ NFA NFABuilder::buildBasicNFA(const QString &input)
 {
     NFA nfa;
     
+    // 驻留输入符号
+    SymbolId symbol = internSymbol(input);
+    if (symbol == SymbolTable::INVALID) {
+        m_errorMessage = "构建错误：输入符号数量超出符号表容量";
+        return nfa;
+    }
+    
     // 创建两个状态
     NFAState start = getNextState();
     NFAState accept = getNextState();
@@ -97,13 +201,13 @@ NFA NFABuilder::buildBasicNFA(const QString &input)
     // 添加转换
     NFATransition transition;
     transition.fromState = start;
-    transition.input = input;
+    transition.input = symbol;
     transition.toState = accept;
     nfa.transitions << transition;
     
     // 添加输入字符到字母表
-    if (input != "#") { // 跳过空串
-        nfa.alphabet.insert(input);
+    if (symbol != SymbolTable::EPSILON) { // 跳过空串
+        nfa.alphabet.insert(symbol);
     }
     
     // 设置起始状态和接受状态
@@ -140,7 +244,7 @@ NFA NFABuilder::buildConcatenationNFA(const NFA &nfa1, const NFA &nfa2)
     for (NFAState acceptState : nfa1.acceptStates) {
         NFATransition transition;
         transition.fromState = acceptState;
-        transition.input = "#"; // 空串
+        transition.input = SymbolTable::EPSILON; // 空串
         transition.toState = nfa2.startState;
         result.transitions << transition;
     }
@@ -182,13 +286,13 @@ NFA NFABuilder::buildChoiceNFA(const NFA &nfa1, const NFA &nfa2)
     // 从新起始状态到两个NFA的起始状态（空串）
     NFATransition transition1;
     transition1.fromState = newStart;
-    transition1.input = "#";
+    transition1.input = SymbolTable::EPSILON;
     transition1.toState = nfa1.startState;
     result.transitions << transition1;
     
     NFATransition transition2;
     transition2.fromState = newStart;
-    transition2.input = "#";
+    transition2.input = SymbolTable::EPSILON;
     transition2.toState = nfa2.startState;
     result.transitions << transition2;
     
@@ -196,7 +300,7 @@ NFA NFABuilder::buildChoiceNFA(const NFA &nfa1, const NFA &nfa2)
     for (NFAState acceptState : nfa1.acceptStates) {
         NFATransition transition;
         transition.fromState = acceptState;
-        transition.input = "#";
+        transition.input = SymbolTable::EPSILON;
         transition.toState = newAccept;
         result.transitions << transition;
     }
@@ -204,7 +308,7 @@ NFA NFABuilder::buildChoiceNFA(const NFA &nfa1, const NFA &nfa2)
     for (NFAState acceptState : nfa2.acceptStates) {
         NFATransition transition;
         transition.fromState = acceptState;
-        transition.input = "#";
+        transition.input = SymbolTable::EPSILON;
         transition.toState = newAccept;
         result.transitions << transition;
     }
@@ -244,7 +348,7 @@ NFA NFABuilder::buildClosureNFA(const NFA &nfa)
     // 从新起始状态到NFA起始状态（空串）
     NFATransition transition1;
     transition1.fromState = newStart;
-    transition1.input = "#";
+    transition1.input = SymbolTable::EPSILON;
     transition1.toState = nfa.startState;
     result.transitions << transition1;
     
@@ -252,7 +356,7 @@ NFA NFABuilder::buildClosureNFA(const NFA &nfa)
     for (NFAState acceptState : nfa.acceptStates) {
         NFATransition transition;
         transition.fromState = acceptState;
-        transition.input = "#";
+        transition.input = SymbolTable::EPSILON;
         transition.toState = nfa.startState;
         result.transitions << transition;
     }
@@ -261,7 +365,7 @@ NFA NFABuilder::buildClosureNFA(const NFA &nfa)
     for (NFAState acceptState : nfa.acceptStates) {
         NFATransition transition;
         transition.fromState = acceptState;
-        transition.input = "#";
+        transition.input = SymbolTable::EPSILON;
         transition.toState = newAccept;
         result.transitions << transition;
     }
@@ -269,7 +373,7 @@ NFA NFABuilder::buildClosureNFA(const NFA &nfa)
     // 从新起始状态到新接受状态（空串）（处理空匹配）
     NFATransition transition2;
     transition2.fromState = newStart;
-    transition2.input = "#";
+    transition2.input = SymbolTable::EPSILON;
     transition2.toState = newAccept;
     result.transitions << transition2;
     
@@ -310,19 +414,138 @@ NFA NFABuilder::buildOptionalNFA(const NFA &nfa)
     return buildChoiceNFA(nfa, epsilonNFA);
 }
 
+/**
+ * @brief 解析字符集为字符类符号
+ * 
+ * 支持范围（a-z）、转义与取反[^...]，整个字符集驻留为一个字符类符号
+ * 
+ * @param charSet 字符集（包含方括号）
+ * @return SymbolId 字符类符号，失败时返回INVALID并设置错误信息
+ */
+SymbolId NFABuilder::parseCharacterSet(const QString &charSet)
+{
+    // 解析字符集
+    QString set = charSet.mid(1, charSet.length() - 2); // 去掉 [ 和 ]
+    
+    // 以^开头表示取反
+    bool negated = false;
+    int i = 0;
+    if (set.startsWith('^')) {
+        negated = true;
+        i = 1;
+    }
+    
+    // 读取一个字符（处理转义），返回字符编码并前移位置
+    auto readChar = [&set](int &pos) -> ushort {
+        QChar c = set.at(pos++);
+        if (c == '\\' && pos < set.length()) {
+            c = set.at(pos++);
+        }
+        return c.unicode();
+    };
+    
+    QList<CharRange> ranges;
+    while (i < set.length()) {
+        ushort low = readChar(i);
+        if (i + 1 < set.length() && set.at(i) == '-') {
+            // 处理范围，如 a-z
+            i++;
+            ushort high = readChar(i);
+            if (high < low) {
+                m_errorMessage = QString("构建错误：字符集 %1 中的范围无效").arg(charSet);
+                return SymbolTable::INVALID;
+            }
+            ranges.append({low, high});
+        } else {
+            // 处理单个字符
+            ranges.append({low, low});
+        }
+    }
+    
+    // 先折叠再取反，[^a]在不区分大小写时同样不匹配A
+    SymbolId symbol = SymbolTable::internClass(foldCaseRanges(ranges), negated);
+    if (symbol == SymbolTable::INVALID) {
+        m_errorMessage = QString("构建错误：字符集 %1 为空或超出符号表容量").arg(charSet);
+        return SymbolTable::INVALID;
+    }
+    
+    return symbol;
+}
+
+/**
+ * @brief 驻留单个字符符号
+ * 
+ * 空串符号"#"不做折叠
+ * 
+ * @param input 字符
+ * @return SymbolId 符号编号，符号表已满时返回INVALID
+ */
+SymbolId NFABuilder::internSymbol(const QString &input)
+{
+    SymbolId symbol = SymbolTable::intern(input);
+    if (!m_caseInsensitive || symbol == SymbolTable::INVALID || symbol == SymbolTable::EPSILON) {
+        return symbol;
+    }
+    
+    QList<CharRange> ranges = SymbolTable::ranges(symbol);
+    QList<CharRange> folded = foldCaseRanges(ranges);
+    if (folded.size() == ranges.size()) {
+        return symbol;
+    }
+    return SymbolTable::internClass(folded);
+}
+
+/**
+ * @brief 对字符区间做大小写折叠
+ * 
+ * 只处理ASCII字母，与生成的词法分析器按字节读取输入一致
+ * 
+ * @param ranges 字符区间列表
+ * @return QList<CharRange> 折叠后的字符区间列表（未规范化）
+ */
+QList<CharRange> NFABuilder::foldCaseRanges(const QList<CharRange> &ranges) const
+{
+    if (!m_caseInsensitive) {
+        return ranges;
+    }
+    
+    QList<CharRange> folded = ranges;
+    for (const CharRange &range : ranges) {
+        // 与a-z的交集补上大写形式
+        ushort low = qMax<ushort>(range.low, 'a');
+        ushort high = qMin<ushort>(range.high, 'z');
+        if (low <= high) {
+            folded.append({static_cast<ushort>(low - 'a' + 'A'), static_cast<ushort>(high - 'a' + 'A')});
+        }
+        
+        // 与A-Z的交集补上小写形式
+        low = qMax<ushort>(range.low, 'A');
+        high = qMin<ushort>(range.high, 'Z');
+        if (low <= high) {
+            folded.append({static_cast<ushort>(low - 'A' + 'a'), static_cast<ushort>(high - 'A' + 'a')});
+        }
+    }
+    return folded;
+}
+
 /**
  * @brief 构建字符集的NFA
  * 
- * 构建一个能够接受指定字符集的NFA
+ * 构建一个能够接受指定字符集的NFA。整个字符集只生成一条转换，
+ * 转换符号为驻留后的字符类（区间列表），支持范围、转义和取反（[^...]）
  * 
- * @param charSet 字符集，例如 [a-z0-9]
+ * @param charSet 字符集，例如 [a-z0-9]、[^\n]
  * @return NFA 字符集的NFA
  */
 NFA NFABuilder::buildCharacterSetNFA(const QString &charSet)
 {
-    // 处理字符集，例如 [a-z0-9]
     NFA result;
     
+    SymbolId symbol = parseCharacterSet(charSet);
+    if (symbol == SymbolTable::INVALID) {
+        return NFA();
+    }
+    
     // 创建新的起始状态和接受状态
     NFAState newStart = getNextState();
     NFAState newAccept = getNextState();
@@ -330,47 +553,15 @@ NFA NFABuilder::buildCharacterSetNFA(const QString &charSet)
     // 添加状态
     result.states << newStart << newAccept;
     
-    // 解析字符集
-    QString set = charSet.mid(1, charSet.length() - 2); // 去掉 [ 和 ]
+    // 添加从起始状态到接受状态的转换
+    NFATransition transition;
+    transition.fromState = newStart;
+    transition.input = symbol;
+    transition.toState = newAccept;
+    result.transitions << transition;
     
-    int i = 0;
-    while (i < set.length()) {
-        if (i + 2 < set.length() && set.at(i + 1) == '-') {
-            // 处理范围，如 a-z
-            QChar startChar = set.at(i);
-            QChar endChar = set.at(i + 2);
-            
-            // 使用整数类型迭代字符范围
-            for (ushort code = startChar.unicode(); code <= endChar.unicode(); ++code) {
-                QChar c(code);
-                // 添加从起始状态到接受状态的转换
-                NFATransition transition;
-                transition.fromState = newStart;
-                transition.input = c;
-                transition.toState = newAccept;
-                result.transitions << transition;
-                
-                // 添加到字母表
-                result.alphabet.insert(QString(c));
-            }
-            
-            i += 3;
-        } else {
-            // 处理单个字符
-            QChar c = set.at(i);
-            
-            NFATransition transition;
-            transition.fromState = newStart;
-            transition.input = c;
-            transition.toState = newAccept;
-            result.transitions << transition;
-            
-            // 添加到字母表
-            result.alphabet.insert(QString(c));
-            
-            i += 1;
-        }
-    }
+    // 添加到字母表
+    result.alphabet.insert(symbol);
     
     // 设置起始状态和接受状态
     result.startState = newStart;
@@ -531,8 +722,16 @@ NFA NFABuilder::parsePrimary(const QString &regex, int &pos, QString &error)
         pos++;
         return result;
     } else if (c == '[') {
-        // 处理字符集
-        int endPos = regex.indexOf(']', pos);
+        // 处理字符集，查找第一个未转义的右方括号
+        int endPos = -1;
+        for (int i = pos + 1; i < regex.length(); ++i) {
+            if (regex.at(i) == '\\') {
+                ++i;
+            } else if (regex.at(i) == ']') {
+                endPos = i;
+                break;
+            }
+        }
         if (endPos == -1) {
             error = "解析错误：缺少右方括号";
             return NFA();
@@ -560,6 +759,196 @@ NFA NFABuilder::parsePrimary(const QString &regex, int &pos, QString &error)
     }
 }
 
+/**
+ * @brief 向语法树追加节点
+ * 
+ * 子节点总是先于父节点追加，节点数组因此按后序排列
+ * 
+ * @param tree 语法树
+ * @param type 节点类型
+ * @param left 左子节点下标
+ * @param right 右子节点下标
+ * @param symbol 输入符号编号
+ * @return int 新节点下标
+ */
+int NFABuilder::addSyntaxNode(RegexSyntaxTree &tree, RegexNodeType type, int left, int right, SymbolId symbol)
+{
+    RegexNode node;
+    node.type = type;
+    node.left = left;
+    node.right = right;
+    node.symbol = symbol;
+    tree.nodes.append(node);
+    return tree.nodes.size() - 1;
+}
+
+/**
+ * @brief 解析选择操作并构建语法树节点
+ * 
+ * 与parseChoice的文法相同：concatenation (| concatenation)*
+ * 
+ * @param regex 要解析的正则表达式
+ * @param pos 当前解析位置（引用传递，会被修改）
+ * @param error 错误信息（引用传递，解析失败时会被设置）
+ * @param tree 语法树
+ * @return int 节点下标
+ */
+int NFABuilder::parseChoiceNode(const QString &regex, int &pos, QString &error, RegexSyntaxTree &tree)
+{
+    int result = parseConcatenationNode(regex, pos, error, tree);
+    if (!error.isEmpty()) return result;
+    
+    while (pos < regex.length() && regex.at(pos) == '|') {
+        pos++;
+        int next = parseConcatenationNode(regex, pos, error, tree);
+        if (!error.isEmpty()) return result;
+        
+        result = addSyntaxNode(tree, RegexNodeType::CHOICE, result, next);
+    }
+    
+    return result;
+}
+
+/**
+ * @brief 解析连接操作并构建语法树节点
+ * 
+ * 与parseConcatenation的文法相同：closure (closure)*
+ * 
+ * @param regex 要解析的正则表达式
+ * @param pos 当前解析位置（引用传递，会被修改）
+ * @param error 错误信息（引用传递，解析失败时会被设置）
+ * @param tree 语法树
+ * @return int 节点下标
+ */
+int NFABuilder::parseConcatenationNode(const QString &regex, int &pos, QString &error, RegexSyntaxTree &tree)
+{
+    int result = parseClosureNode(regex, pos, error, tree);
+    if (!error.isEmpty()) return result;
+    
+    while (pos < regex.length() && regex.at(pos) != '|' && regex.at(pos) != ')') {
+        int next = parseClosureNode(regex, pos, error, tree);
+        if (!error.isEmpty()) return result;
+        
+        result = addSyntaxNode(tree, RegexNodeType::CONCATENATION, result, next);
+    }
+    
+    return result;
+}
+
+/**
+ * @brief 解析闭包操作并构建语法树节点
+ * 
+ * 与parseClosure的文法相同：primary (* | + | ?)*
+ * 
+ * @param regex 要解析的正则表达式
+ * @param pos 当前解析位置（引用传递，会被修改）
+ * @param error 错误信息（引用传递，解析失败时会被设置）
+ * @param tree 语法树
+ * @return int 节点下标
+ */
+int NFABuilder::parseClosureNode(const QString &regex, int &pos, QString &error, RegexSyntaxTree &tree)
+{
+    int result = parsePrimaryNode(regex, pos, error, tree);
+    if (!error.isEmpty()) return result;
+    
+    while (pos < regex.length()) {
+        QChar c = regex.at(pos);
+        if (c == '*') {
+            result = addSyntaxNode(tree, RegexNodeType::CLOSURE, result, -1);
+        } else if (c == '+') {
+            result = addSyntaxNode(tree, RegexNodeType::POSITIVE_CLOSURE, result, -1);
+        } else if (c == '?') {
+            result = addSyntaxNode(tree, RegexNodeType::OPTIONAL, result, -1);
+        } else {
+            break;
+        }
+        pos++;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief 解析基本元素并构建语法树节点
+ * 
+ * 与parsePrimary的规则相同：字符、转义字符、字符集或(regex)。
+ * 文本"#"驻留为空串符号，生成EPSILON节点
+ * 
+ * @param regex 要解析的正则表达式
+ * @param pos 当前解析位置（引用传递，会被修改）
+ * @param error 错误信息（引用传递，解析失败时会被设置）
+ * @param tree 语法树
+ * @return int 节点下标
+ */
+int NFABuilder::parsePrimaryNode(const QString &regex, int &pos, QString &error, RegexSyntaxTree &tree)
+{
+    if (pos >= regex.length()) {
+        error = "解析错误：表达式意外结束";
+        return -1;
+    }
+    
+    QChar c = regex.at(pos);
+    SymbolId symbol;
+    
+    if (c == '(') {
+        // 处理括号
+        pos++;
+        int result = parseChoiceNode(regex, pos, error, tree);
+        if (!error.isEmpty()) return result;
+        
+        if (pos >= regex.length() || regex.at(pos) != ')') {
+            error = "解析错误：缺少右括号";
+            return -1;
+        }
+        pos++;
+        return result;
+    } else if (c == '[') {
+        // 处理字符集，查找第一个未转义的右方括号
+        int endPos = -1;
+        for (int i = pos + 1; i < regex.length(); ++i) {
+            if (regex.at(i) == '\\') {
+                ++i;
+            } else if (regex.at(i) == ']') {
+                endPos = i;
+                break;
+            }
+        }
+        if (endPos == -1) {
+            error = "解析错误：缺少右方括号";
+            return -1;
+        }
+        
+        symbol = parseCharacterSet(regex.mid(pos, endPos - pos + 1));
+        pos = endPos + 1;
+        if (symbol == SymbolTable::INVALID) {
+            error = m_errorMessage;
+            return -1;
+        }
+    } else if (c == '\\') {
+        // 处理转义字符
+        if (pos + 1 >= regex.length()) {
+            error = "解析错误：转义字符后缺少字符";
+            return -1;
+        }
+        
+        symbol = internSymbol(QString(regex.at(pos + 1)));
+        pos += 2;
+    } else {
+        // 处理普通字符
+        symbol = internSymbol(QString(c));
+        pos++;
+    }
+    
+    if (symbol == SymbolTable::INVALID) {
+        error = "构建错误：输入符号数量超出符号表容量";
+        return -1;
+    }
+    if (symbol == SymbolTable::EPSILON) {
+        return addSyntaxNode(tree, RegexNodeType::EPSILON, -1, -1);
+    }
+    return addSyntaxNode(tree, RegexNodeType::SYMBOL, -1, -1, symbol);
+}
+
 /**
  * @brief 获取下一个可用的NFA状态编号
  * 
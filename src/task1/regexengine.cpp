@@ -10,6 +10,62 @@
 
 #include "task1/regexengine.h"
 #include <QDebug>
+#include <algorithm>
+
+/**
+ * @brief 惰性DFA转换表中尚未计算的表项
+ */
+static const int LAZY_UNKNOWN = -2;
+
+/**
+ * @brief 惰性DFA中没有转换（状态集合为空）
+ */
+static const int LAZY_DEAD = -1;
+
+/**
+ * @brief 惰性DFA放弃，应退回NFA模拟
+ */
+static const int LAZY_BAIL = -3;
+
+/**
+ * @brief 无锚定搜索状态的标记，排在状态集合最前面以区分普通状态集合
+ */
+static const int LAZY_UNANCHORED_MARK = -1;
+
+/**
+ * @brief 搜索状态中线程组的分隔标记，各组按线程起点从早到晚排列
+ */
+static const int LAZY_GROUP_MARK = -2;
+
+/**
+ * @brief 反向状态的标记，排在状态集合最前面
+ */
+static const int LAZY_REVERSE_MARK = -3;
+
+/**
+ * @brief 反向状态中经^转换到达匹配起点的标记
+ */
+static const int LAZY_REVERSE_HIT = -4;
+
+/**
+ * @brief 字面量前缀集合的最大字符串数
+ */
+static const int MAX_LITERAL_PREFIXES = 16;
+
+/**
+ * @brief 字面量前缀的最大长度
+ */
+static const int MAX_LITERAL_LENGTH = 32;
+
+/**
+ * @brief 字符集不超过该字符数时按各个字符展开为字面量
+ */
+static const int MAX_LITERAL_CHAR_SET = 8;
+
+/**
+ * @brief 惰性DFA默认缓存上限（字节）
+ */
+static const int LAZY_DEFAULT_CACHE_SIZE = 1 << 20;
 
 /**
  * @brief RegexEngine构造函数
@@ -18,7 +74,26 @@
 RegexEngine::RegexEngine()
     : m_root(nullptr),
       m_isCompiled(false),
-      m_nextState(0)
+      m_nextState(0),
+      m_startAccepts(false),
+      m_hasPrefilter(false),
+      m_bitParallelEnabled(true),
+      m_bitParallel(false),
+      m_positionCount(0),
+      m_followChunks(0),
+      m_firstMask(0),
+      m_lastMask(0),
+      m_caretMask(0),
+      m_dollarMask(0),
+      m_lazyEnabled(true),
+      m_lazyCacheLimit(LAZY_DEFAULT_CACHE_SIZE),
+      m_lazyCacheBytes(0),
+      m_lazyContextCount(1),
+      m_lazySymbolCount(0),
+      m_lazyStart(-1),
+      m_lazyUnanchoredStart(-1),
+      m_lazyReverseStart(-1),
+      m_lazyCharsSinceFlush(0)
 {}
 
 /**
@@ -43,6 +118,7 @@ bool RegexEngine::compile(const QString &pattern)
     m_nfa.states.clear();
     m_nfa.transitions.clear();
     m_nfa.acceptStates.clear();
+    m_charSetInfo.clear();
     m_isCompiled = false;
     m_errorMessage.clear();
     m_nextState = 0;
@@ -60,6 +136,9 @@ bool RegexEngine::compile(const QString &pattern)
         
         // 构建NFA：根据抽象语法树构建非确定有限自动机
         m_nfa = buildNFA(m_root);
+        prepareLazyDFA();
+        prepareBitParallel();
+        prepareLiteralPrefix();
         m_isCompiled = true;
         return true;
     } catch (const QString &error) {
@@ -83,7 +162,7 @@ bool RegexEngine::match(const QString &input, int &matchLength)
         return false;
     }
     
-    return simulateNFA(m_nfa, input, 0, matchLength);
+    return runMatch(input, 0, matchLength);
 }
 
 /**
@@ -92,7 +171,9 @@ bool RegexEngine::match(const QString &input, int &matchLength)
  * @param startPos 匹配到的起始位置（输出参数）
  * @param matchLength 匹配到的长度（输出参数）
  * @return 搜索到匹配返回true，否则返回false
- * @details 从输入字符串的每个位置尝试匹配，返回第一个匹配结果
+ * @details 返回最左起点处的最长匹配。一遍正向无锚定扫描（每个位置都加入起始状态）
+ *          在找到匹配后不再开始新线程，并丢弃起点更晚的线程，扫描到最左匹配的末尾为止；
+ *          没有匹配时只需这一遍
  */
 bool RegexEngine::search(const QString &input, int &startPos, int &matchLength)
 {
@@ -101,15 +182,24 @@ bool RegexEngine::search(const QString &input, int &startPos, int &matchLength)
         return false;
     }
     
-    for (int i = 0; i < input.length(); i++) {
-        int len = 0;
-        if (simulateNFA(m_nfa, input, i, len)) {
-            startPos = i;
-            matchLength = len;
-            return true;
-        }
+    if (input.isEmpty()) {
+        return false;
     }
-    return false;
+    
+    // 起始状态本身可接受（空匹配）时，位置0处必然匹配
+    if (m_startAccepts) {
+        startPos = 0;
+        return runMatch(input, 0, matchLength);
+    }
+    
+    int start = -1;
+    int end = -1;
+    if (!findLeftmostLongest(input, start, end)) {
+        return false;
+    }
+    startPos = start;
+    matchLength = end - start;
+    return true;
 }
 
 /**
@@ -122,6 +212,54 @@ QString RegexEngine::getErrorMessage() const
     return m_errorMessage;
 }
 
+/**
+ * @brief 设置是否允许位并行后端
+ * @param enabled 是否允许
+ * @details 需在compile之前设置才会影响后端选择
+ */
+void RegexEngine::setBitParallelEnabled(bool enabled)
+{
+    m_bitParallelEnabled = enabled;
+}
+
+/**
+ * @brief 是否正在使用位并行后端
+ * @return 当前编译结果使用位并行匹配时返回true
+ */
+bool RegexEngine::isBitParallel() const
+{
+    return m_bitParallel;
+}
+
+/**
+ * @brief 设置是否启用惰性DFA
+ * @param enabled 是否启用
+ */
+void RegexEngine::setLazyDFAEnabled(bool enabled)
+{
+    m_lazyEnabled = enabled;
+}
+
+/**
+ * @brief 是否启用惰性DFA
+ * @return 启用返回true
+ */
+bool RegexEngine::isLazyDFAEnabled() const
+{
+    return m_lazyEnabled;
+}
+
+/**
+ * @brief 设置惰性DFA缓存上限
+ * @param bytes 缓存上限（字节）
+ * @details 修改上限会清空已有缓存
+ */
+void RegexEngine::setLazyDFACacheSize(int bytes)
+{
+    m_lazyCacheLimit = bytes;
+    resetLazyDFA();
+}
+
 /**
  * @brief 词法分析器实现
  * @param pattern 正则表达式字符串
@@ -925,10 +1063,8 @@ NFA RegexEngine::buildCharSetNFA(const QSet<QChar> &charSet, bool isNegated)
     transition.toState = end;
     nfa.transitions.append(transition);
     
-    // 存储字符集信息，用于模拟时使用
-    // 注意：这只是一个临时解决方案，实际实现中应该将字符集信息与转换关联
-    static QMap<NFAState, QPair<QSet<QChar>, bool>> charSetInfo;
-    charSetInfo[start] = qMakePair(charSet, isNegated);
+    // 存储字符集信息（以转换起点为键），用于模拟时使用
+    m_charSetInfo[start] = qMakePair(charSet, isNegated);
     
     return nfa;
 }
@@ -965,50 +1101,9 @@ bool RegexEngine::simulateNFA(const NFA &nfa, const QString &input, int startPos
         
         for (NFAState state : currentStates) {
             for (const NFATransition &transition : nfa.transitions) {
-                if (transition.fromState == state) {
-                    if (transition.input == QChar()) {
-                        // epsilon转换，跳过，在epsilonClosure中处理
-                        continue;
-                    } else if (transition.input == '.') {
-                        // 匹配任意字符，除了换行符
-                        if (c != '\n') {
-                            nextStates.insert(transition.toState);
-                        }
-                    } else if (transition.input == '^') {
-                        // 匹配字符串开头，只有当i == startPos时匹配
-                        if (i == startPos) {
-                            nextStates.insert(transition.toState);
-                        }
-                    } else if (transition.input == '$') {
-                        // 匹配字符串结尾，只有当i == inputLen - 1时匹配
-                        if (i == inputLen - 1) {
-                            nextStates.insert(transition.toState);
-                        }
-                    } else if (transition.input == '[') {
-                        // 字符集匹配或普通字符匹配
-                        static QMap<NFAState, QPair<QSet<QChar>, bool>> charSetInfo;
-                        if (charSetInfo.contains(state)) {
-                            // 字符集匹配
-                            QSet<QChar> charSet = charSetInfo[state].first;
-                            bool isNegated = charSetInfo[state].second;
-                            if ((charSet.contains(c) && !isNegated) || (!charSet.contains(c) && isNegated)) {
-                                nextStates.insert(transition.toState);
-                            }
-                        } else {
-                            // 普通字符匹配
-                            if (c == '[') {
-                                nextStates.insert(transition.toState);
-                            }
-                        }
-                    } else if (transition.input == ']') {
-                        // 普通字符匹配，因为字符集的右括号不应该出现在这里
-                        if (c == ']') {
-                            nextStates.insert(transition.toState);
-                        }
-                    } else if (transition.input == c) {
-                        // 直接匹配其他普通字符
-                        nextStates.insert(transition.toState);
-                    }
+                if (transition.fromState == state
+                    && transitionMatches(transition, c, i == startPos, i == inputLen - 1)) {
+                    nextStates.insert(transition.toState);
                 }
             }
         }
@@ -1101,6 +1196,1209 @@ QSet<NFAState> RegexEngine::move(const NFA &nfa, const QSet<NFAState> &states, Q
     return result;
 }
 
+/**
+ * @brief 判断转换能否接受字符
+ * @param transition NFA转换
+ * @param c 输入字符
+ * @param atStart 字符是否位于匹配起始位置
+ * @param atEnd 字符是否为输入的最后一个字符
+ * @return 能接受返回true
+ * @details 字符集转换按m_charSetInfo判断；.匹配除换行符外的任意字符；
+ *          ^和$分别只在起始位置和最后一个字符处匹配
+ */
+bool RegexEngine::transitionMatches(const NFATransition &transition, QChar c, bool atStart, bool atEnd) const
+{
+    if (transition.input == QChar()) {
+        // epsilon转换，在epsilonClosure中处理
+        return false;
+    }
+    
+    if (transition.input == '[' || transition.input == '^') {
+        auto it = m_charSetInfo.constFind(transition.fromState);
+        if (it != m_charSetInfo.constEnd()) {
+            // 字符集匹配
+            return it->first.contains(c) != it->second;
+        }
+    }
+    
+    if (transition.input == '.') {
+        // 匹配任意字符，除了换行符
+        return c != '\n';
+    } else if (transition.input == '^') {
+        // 匹配字符串开头
+        return atStart;
+    } else if (transition.input == '$') {
+        // 匹配字符串结尾
+        return atEnd;
+    }
+    
+    // 直接匹配普通字符
+    return transition.input == c;
+}
+
+/**
+ * @brief 执行一次匹配
+ * @param input 输入字符串
+ * @param startPos 匹配起始位置
+ * @param matchLength 匹配到的长度（输出参数）
+ * @return 匹配成功返回true，失败返回false
+ * @details 模式位置数不超过64时使用位并行匹配；否则启用惰性DFA时先用惰性DFA匹配，
+ *          惰性DFA放弃时退回NFA模拟
+ */
+bool RegexEngine::runMatch(const QString &input, int startPos, int &matchLength)
+{
+    if (m_bitParallel) {
+        return simulateBitParallel(input, startPos, matchLength);
+    }
+    if (m_lazyEnabled) {
+        bool completed = false;
+        bool matched = simulateLazyDFA(input, startPos, matchLength, completed);
+        if (completed) {
+            return matched;
+        }
+    }
+    return simulateNFA(m_nfa, input, startPos, matchLength);
+}
+
+/**
+ * @brief 准备惰性DFA
+ * @details 按状态建立epsilon与非epsilon转换的正向、反向邻接表；把模式中出现的字符
+ *          （普通字符、字符集成员、.不匹配的换行符）各自作为一个等价类，
+ *          其余字符共用等价类0。模式含^或$时，转换还需区分位置条件
+ */
+void RegexEngine::prepareLazyDFA()
+{
+    m_epsilonTargets = QVector<QVector<NFAState>>(m_nextState);
+    m_labelTransitions = QVector<QVector<NFATransition>>(m_nextState);
+    m_reverseEpsilon = QVector<QVector<NFAState>>(m_nextState);
+    m_reverseLabel = QVector<QVector<NFATransition>>(m_nextState);
+    
+    bool hasAnchors = false;
+    QSet<ushort> distinguished;
+    for (const NFATransition &transition : m_nfa.transitions) {
+        if (transition.input == QChar()) {
+            m_epsilonTargets[transition.fromState].append(transition.toState);
+            m_reverseEpsilon[transition.toState].append(transition.fromState);
+            continue;
+        }
+        m_labelTransitions[transition.fromState].append(transition);
+        m_reverseLabel[transition.toState].append(transition);
+        
+        if ((transition.input == '[' || transition.input == '^') && m_charSetInfo.contains(transition.fromState)) {
+            for (QChar member : m_charSetInfo[transition.fromState].first) {
+                distinguished.insert(member.unicode());
+            }
+        } else if (transition.input == '.') {
+            distinguished.insert('\n');
+        } else if (transition.input == '^' || transition.input == '$') {
+            hasAnchors = true;
+        } else {
+            distinguished.insert(transition.input.unicode());
+        }
+    }
+    
+    // 等价类0的代表字符取第一个未在模式中出现的字符
+    m_classRepresentative.clear();
+    ushort other = 1;
+    while (distinguished.contains(other)) {
+        ++other;
+    }
+    m_classRepresentative.append(QChar(other));
+    
+    QList<ushort> chars(distinguished.begin(), distinguished.end());
+    std::sort(chars.begin(), chars.end());
+    m_latin1Class = QVector<int>(256, 0);
+    m_charClass.clear();
+    for (ushort c : chars) {
+        int cls = m_classRepresentative.size();
+        m_classRepresentative.append(QChar(c));
+        if (c < 256) {
+            m_latin1Class[c] = cls;
+        } else {
+            m_charClass.insert(c, cls);
+        }
+    }
+    
+    // 位置条件：bit0表示位于匹配起始位置，bit1表示最后一个字符
+    m_lazyContextCount = hasAnchors ? 4 : 1;
+    m_lazySymbolCount = m_classRepresentative.size() * m_lazyContextCount;
+    
+    // 搜索用：起始状态闭包及其成员标记
+    m_startClosure = adjacencyClosure({m_nfa.startState}, m_epsilonTargets);
+    m_inStartClosure = QVector<bool>(m_nextState, false);
+    m_startAccepts = false;
+    for (NFAState state : m_startClosure) {
+        m_inStartClosure[state] = true;
+        if (m_nfa.acceptStates.contains(state)) {
+            m_startAccepts = true;
+        }
+    }
+    
+    resetLazyDFA();
+}
+
+/**
+ * @brief 清空惰性DFA缓存
+ */
+void RegexEngine::resetLazyDFA()
+{
+    m_lazyStateSets.clear();
+    m_lazyStateIds.clear();
+    m_lazyAccept.clear();
+    m_lazyNext.clear();
+    m_lazyCacheBytes = 0;
+    m_lazyStart = -1;
+    m_lazyUnanchoredStart = -1;
+    m_lazyReverseStart = -1;
+    m_lazyCharsSinceFlush = 0;
+}
+
+/**
+ * @brief 获取字符所属的等价类
+ * @param c 输入字符
+ * @return 等价类编号
+ */
+int RegexEngine::lazyCharClass(QChar c) const
+{
+    ushort code = c.unicode();
+    if (code < 256) {
+        return m_latin1Class[code];
+    }
+    return m_charClass.value(code, 0);
+}
+
+/**
+ * @brief 沿邻接表计算闭包
+ * @param states 初始状态列表
+ * @param edges 每个状态的epsilon转换目标（正向或反向）
+ * @return 按编号升序排列的闭包
+ */
+QVector<NFAState> RegexEngine::adjacencyClosure(const QVector<NFAState> &states,
+                                                const QVector<QVector<NFAState>> &edges) const
+{
+    QVector<bool> visited(m_nextState, false);
+    QVector<NFAState> closure;
+    QVector<NFAState> stack;
+    for (NFAState state : states) {
+        if (!visited[state]) {
+            visited[state] = true;
+            stack.append(state);
+        }
+    }
+    
+    while (!stack.isEmpty()) {
+        NFAState state = stack.takeLast();
+        closure.append(state);
+        for (NFAState target : edges[state]) {
+            if (!visited[target]) {
+                visited[target] = true;
+                stack.append(target);
+            }
+        }
+    }
+    
+    std::sort(closure.begin(), closure.end());
+    return closure;
+}
+
+/**
+ * @brief 查找或加入惰性DFA状态
+ * @param states 按编号升序排列的NFA状态集合（搜索状态与反向状态带有标记）
+ * @return DFA状态编号，缓存已满时返回-1
+ * @details 新状态的转换表项全部初始化为LAZY_UNKNOWN。正向状态含NFA接受状态时接受；
+ *          反向状态含NFA起始状态或LAZY_REVERSE_HIT时接受，表示匹配可从当前位置开始
+ */
+int RegexEngine::addLazyState(const QVector<NFAState> &states)
+{
+    auto it = m_lazyStateIds.constFind(states);
+    if (it != m_lazyStateIds.constEnd()) {
+        return it.value();
+    }
+    
+    // 估算占用：转换表一行 + 状态集合（集合本身与哈希键各一份）+ 固定开销
+    qint64 bytes = static_cast<qint64>(m_lazySymbolCount) * sizeof(int)
+                   + static_cast<qint64>(states.size()) * sizeof(NFAState) * 2 + 64;
+    if (!m_lazyStateSets.isEmpty() && m_lazyCacheBytes + bytes > m_lazyCacheLimit) {
+        return -1;
+    }
+    
+    int id = m_lazyStateSets.size();
+    m_lazyStateSets.append(states);
+    m_lazyStateIds.insert(states, id);
+    
+    const bool reverse = !states.isEmpty() && states.first() == LAZY_REVERSE_MARK;
+    bool accept = false;
+    for (NFAState state : states) {
+        if (reverse ? (state == LAZY_REVERSE_HIT || state == m_nfa.startState) : m_nfa.acceptStates.contains(state)) {
+            accept = true;
+            break;
+        }
+    }
+    m_lazyAccept.append(accept);
+    m_lazyNext.resize(m_lazyNext.size() + m_lazySymbolCount);
+    std::fill(m_lazyNext.end() - m_lazySymbolCount, m_lazyNext.end(), LAZY_UNKNOWN);
+    m_lazyCacheBytes += bytes;
+    return id;
+}
+
+/**
+ * @brief 计算并缓存惰性DFA转换
+ * @param state 当前DFA状态（输入输出参数）
+ * @param symbol 输入符号
+ * @return 目标状态、LAZY_DEAD或LAZY_BAIL
+ * @details 用等价类的代表字符和位置条件求出后继状态集合（正向见lazyForwardStep，
+ *          反向见lazyReverseStep）。缓存已满时清空缓存，重新加入当前状态后继续；
+ *          若距上次清空处理的字符数不足缓存状态数的10倍，说明缓存命中率太低，放弃惰性DFA
+ */
+int RegexEngine::computeLazyTransition(int &state, int symbol)
+{
+    const int cls = symbol / m_lazyContextCount;
+    const int context = symbol % m_lazyContextCount;
+    const QChar c = m_classRepresentative[cls];
+    const bool atStart = (context & 1) != 0;
+    const bool atEnd = (context & 2) != 0;
+    
+    const QVector<NFAState> &states = m_lazyStateSets[state];
+    const QVector<NFAState> successor = !states.isEmpty() && states.first() == LAZY_REVERSE_MARK
+                                        ? lazyReverseStep(states, c, atEnd)
+                                        : lazyForwardStep(states, c, atStart, atEnd);
+    
+    int next = LAZY_DEAD;
+    if (!successor.isEmpty()) {
+        next = addLazyState(successor);
+        if (next == -1) {
+            if (m_lazyCharsSinceFlush < 10 * m_lazyStateSets.size()) {
+                return LAZY_BAIL;
+            }
+            QVector<NFAState> current = m_lazyStateSets[state];
+            resetLazyDFA();
+            state = addLazyState(current);
+            next = addLazyState(successor);
+            if (next == -1) {
+                return LAZY_BAIL;
+            }
+        }
+    }
+    
+    m_lazyNext[state * m_lazySymbolCount + symbol] = next;
+    return next;
+}
+
+/**
+ * @brief 求正向状态在一个字符上的后继集合
+ * @param states 当前状态的NFA状态集合
+ * @param c 输入字符
+ * @param atStart 字符是否位于匹配起始位置
+ * @param atEnd 字符是否为输入的最后一个字符
+ * @return 后继集合，为空表示没有转换
+ * @details 集合由LAZY_GROUP_MARK分隔为若干线程组，按线程起点从早到晚排列；锚定匹配的状态只有一组。
+ *          各组分别move并求闭包，已出现在更早组中的NFA状态从较晚的组中去掉（后续行为相同，
+ *          起点更早者优先）。无锚定搜索状态还要在末尾加入本位置新开始的线程（^在此成立）。
+ *          某组含接受状态时丢弃其后的各组，并去掉无锚定标记，不再开始新线程，
+ *          此后接受的位置即为最左起点处匹配的结束位置
+ */
+QVector<NFAState> RegexEngine::lazyForwardStep(const QVector<NFAState> &states, QChar c,
+                                               bool atStart, bool atEnd) const
+{
+    const bool unanchored = !states.isEmpty() && states.first() == LAZY_UNANCHORED_MARK;
+    
+    QVector<QVector<NFAState>> groups(1);
+    for (NFAState nfaState : states) {
+        if (nfaState == LAZY_UNANCHORED_MARK) {
+            continue;
+        }
+        if (nfaState == LAZY_GROUP_MARK) {
+            groups.append(QVector<NFAState>());
+            continue;
+        }
+        for (const NFATransition &transition : m_labelTransitions[nfaState]) {
+            if (transitionMatches(transition, c, atStart, atEnd)) {
+                groups.last().append(transition.toState);
+            }
+        }
+    }
+    if (unanchored) {
+        groups.append(QVector<NFAState>());
+        for (NFAState nfaState : m_startClosure) {
+            for (const NFATransition &transition : m_labelTransitions[nfaState]) {
+                if (transitionMatches(transition, c, true, atEnd)) {
+                    groups.last().append(transition.toState);
+                }
+            }
+        }
+    }
+    
+    QVector<bool> seen(m_nextState, false);
+    QVector<NFAState> result;
+    bool matched = false;
+    for (const QVector<NFAState> &group : std::as_const(groups)) {
+        if (group.isEmpty()) {
+            continue;
+        }
+        const int sizeBefore = result.size();
+        if (!result.isEmpty()) {
+            result.append(LAZY_GROUP_MARK);
+        }
+        const int groupStart = result.size();
+        for (NFAState nfaState : adjacencyClosure(group, m_epsilonTargets)) {
+            if (!seen[nfaState]) {
+                seen[nfaState] = true;
+                result.append(nfaState);
+                matched = matched || m_nfa.acceptStates.contains(nfaState);
+            }
+        }
+        if (result.size() == groupStart) {
+            // 整组都已出现在更早的组中
+            result.resize(sizeBefore);
+        }
+        if (matched) {
+            break;
+        }
+    }
+    
+    if (unanchored && !matched) {
+        result.prepend(LAZY_UNANCHORED_MARK);
+    }
+    return result;
+}
+
+/**
+ * @brief 求反向状态在一个字符上的后继集合
+ * @param states 当前反向状态的NFA状态集合（以LAZY_REVERSE_MARK开头）
+ * @param c 输入字符（向前消耗）
+ * @param atEnd 字符是否为输入的最后一个字符
+ * @return 后继集合，为空表示没有转换
+ * @details 沿反向转换与反向epsilon闭包前进。^转换只能是匹配的第一个字符，
+ *          其起点属于起始状态闭包时加入LAZY_REVERSE_HIT（匹配可从该字符开始）而不再延伸
+ */
+QVector<NFAState> RegexEngine::lazyReverseStep(const QVector<NFAState> &states, QChar c, bool atEnd) const
+{
+    QVector<NFAState> previous;
+    bool hit = false;
+    for (NFAState nfaState : states) {
+        if (nfaState < 0) {
+            continue;
+        }
+        for (const NFATransition &transition : m_reverseLabel[nfaState]) {
+            if (isStartAnchor(transition)) {
+                hit = hit || m_inStartClosure[transition.fromState];
+            } else if (transitionMatches(transition, c, false, atEnd)) {
+                previous.append(transition.fromState);
+            }
+        }
+    }
+    
+    if (previous.isEmpty() && !hit) {
+        return QVector<NFAState>();
+    }
+    QVector<NFAState> result = previous.isEmpty() ? QVector<NFAState>()
+                                                  : adjacencyClosure(previous, m_reverseEpsilon);
+    if (hit) {
+        result.prepend(LAZY_REVERSE_HIT);
+    }
+    result.prepend(LAZY_REVERSE_MARK);
+    return result;
+}
+
+/**
+ * @brief 使用惰性DFA匹配
+ * @param input 输入字符串
+ * @param startPos 匹配起始位置
+ * @param matchLength 匹配到的长度（输出参数）
+ * @param completed 惰性DFA是否完成匹配（输出参数）
+ * @return 匹配成功返回true，失败返回false
+ * @details 与simulateNFA语义相同，记录最长匹配；已缓存的转换每个字符只需一次查表
+ */
+bool RegexEngine::simulateLazyDFA(const QString &input, int startPos, int &matchLength, bool &completed)
+{
+    completed = false;
+    if (m_lazyStart == -1) {
+        QVector<NFAState> startClosure = adjacencyClosure({m_nfa.startState}, m_epsilonTargets);
+        m_lazyStart = addLazyState(startClosure);
+        if (m_lazyStart == -1) {
+            // 缓存已满，清空后重新加入起始状态
+            resetLazyDFA();
+            m_lazyStart = addLazyState(startClosure);
+        }
+    }
+    
+    int state = m_lazyStart;
+    int maxMatch = m_lazyAccept[state] ? 0 : -1;
+    const int inputLen = input.length();
+    const QChar *data = input.constData();
+    
+    for (int i = startPos; i < inputLen; i++) {
+        int symbol = lazyCharClass(data[i]) * m_lazyContextCount;
+        if (m_lazyContextCount > 1) {
+            symbol += (i == startPos ? 1 : 0) | (i == inputLen - 1 ? 2 : 0);
+        }
+        
+        int next = m_lazyNext[state * m_lazySymbolCount + symbol];
+        if (next == LAZY_UNKNOWN) {
+            next = computeLazyTransition(state, symbol);
+            if (next == LAZY_BAIL) {
+                return false;
+            }
+        }
+        if (next == LAZY_DEAD) {
+            break;
+        }
+        
+        state = next;
+        ++m_lazyCharsSinceFlush;
+        if (m_lazyAccept[state]) {
+            maxMatch = i - startPos + 1;
+        }
+    }
+    
+    completed = true;
+    if (maxMatch != -1) {
+        matchLength = maxMatch;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 判断转换是否为^锚点
+ * @param transition NFA转换
+ * @return 是^锚点（而不是取反字符集）返回true
+ */
+bool RegexEngine::isStartAnchor(const NFATransition &transition) const
+{
+    return transition.input == '^' && !m_charSetInfo.contains(transition.fromState);
+}
+
+/**
+ * @brief 查找最左起点处的最长匹配
+ * @param input 输入字符串
+ * @param startPos 匹配起点（输出参数）
+ * @param matchEnd 匹配结束位置（不含，输出参数）
+ * @return 找到非空匹配返回true
+ * @details 位并行后端按起点分组模拟，直接得到起点与结束位置；启用惰性DFA时先用正向惰性DFA
+ *          求出最左匹配的结束位置，再用反向惰性DFA从该位置向前扫描到起点下界，求出起点；
+ *          惰性DFA放弃时退回记录线程起点的NFA模拟
+ */
+bool RegexEngine::findLeftmostLongest(const QString &input, int &startPos, int &matchEnd)
+{
+    if (m_bitParallel) {
+        return bitParallelSearch(input, startPos, matchEnd);
+    }
+    if (m_lazyEnabled) {
+        bool completed = false;
+        int startBound = 0;
+        const int end = lazySearchEnd(input, startBound, completed);
+        if (completed) {
+            if (end == -1) {
+                return false;
+            }
+            const int start = lazyLeftmostStart(input, startBound, end, completed);
+            if (completed && start != -1) {
+                startPos = start;
+                matchEnd = end;
+                return true;
+            }
+        }
+    }
+    return nfaSearch(input, startPos, matchEnd);
+}
+
+/**
+ * @brief 记录线程起点的NFA搜索
+ * @param input 输入字符串
+ * @param startPos 匹配起点（输出参数）
+ * @param matchEnd 匹配结束位置（不含，输出参数）
+ * @return 找到非空匹配返回true
+ * @details 每个NFA状态只保留一个线程及其起点，线程按起点从早到晚排列，先到达某状态的
+ *          线程（起点更早）优先。线程到达接受状态时，起点更晚的线程全部丢弃，也不再开始新线程；
+ *          剩余线程全部结束时，最后一次接受的位置即为最左起点处最长匹配的结束位置。
+ *          没有线程时用字面量前缀预筛选跳过输入
+ */
+bool RegexEngine::nfaSearch(const QString &input, int &startPos, int &matchEnd)
+{
+    const int inputLen = input.length();
+    QVector<NFAState> current;
+    QVector<NFAState> next;
+    QVector<int> currentStart(m_nextState, -1);
+    QVector<int> nextStart(m_nextState, -1);
+    QVector<int> listedAt(m_nextState, -1);  // 状态最近一次加入next时的位置
+    QVector<NFAState> stack;
+    int bestStart = -1;
+    int bestEnd = -1;
+    
+    // 把状态及其epsilon闭包以给定起点加入next，已在next中的状态保留原有（更早的）起点
+    auto addThread = [&](NFAState state, int start, int position) {
+        stack.append(state);
+        while (!stack.isEmpty()) {
+            NFAState s = stack.takeLast();
+            if (listedAt[s] == position) {
+                continue;
+            }
+            listedAt[s] = position;
+            nextStart[s] = start;
+            next.append(s);
+            for (NFAState target : m_epsilonTargets[s]) {
+                if (listedAt[target] != position) {
+                    stack.append(target);
+                }
+            }
+        }
+    };
+    
+    for (int i = 0; i < inputLen; i++) {
+        if (current.isEmpty()) {
+            if (bestStart != -1) {
+                break;
+            }
+            // 没有延续中的线程时，直接跳到下一个可能的匹配起点
+            if (m_hasPrefilter) {
+                i = nextCandidate(input, i);
+                if (i == -1) {
+                    break;
+                }
+            }
+        }
+        const QChar c = input.at(i);
+        const bool atEnd = (i == inputLen - 1);
+        
+        next.clear();
+        for (NFAState state : std::as_const(current)) {
+            for (const NFATransition &transition : m_labelTransitions[state]) {
+                if (transitionMatches(transition, c, false, atEnd)) {
+                    addThread(transition.toState, currentStart[state], i);
+                }
+            }
+        }
+        if (bestStart == -1) {
+            // 本位置新开始的线程，^在这里成立
+            for (NFAState state : std::as_const(m_startClosure)) {
+                for (const NFATransition &transition : m_labelTransitions[state]) {
+                    if (transitionMatches(transition, c, true, atEnd)) {
+                        addThread(transition.toState, i, i);
+                    }
+                }
+            }
+        }
+        
+        // 起点最早的接受线程决定匹配，丢弃起点比它晚的线程
+        for (int k = 0; k < next.size(); ++k) {
+            if (m_nfa.acceptStates.contains(next[k])) {
+                const int start = nextStart[next[k]];
+                bestStart = start;
+                bestEnd = i + 1;
+                int kept = 0;
+                while (kept < next.size() && nextStart[next[kept]] <= start) {
+                    ++kept;
+                }
+                next.resize(kept);
+                break;
+            }
+        }
+        
+        current.swap(next);
+        currentStart.swap(nextStart);
+    }
+    
+    if (bestStart == -1) {
+        return false;
+    }
+    startPos = bestStart;
+    matchEnd = bestEnd;
+    return true;
+}
+
+/**
+ * @brief 使用无锚定惰性DFA求最左匹配的结束位置
+ * @param input 输入字符串
+ * @param startBound 匹配起点的下界（输出参数），即最后一次没有延续中线程的位置
+ * @param completed 惰性DFA是否完成扫描（输出参数）
+ * @return 最左起点处最长匹配的结束位置，没有匹配返回-1
+ * @details 状态中的线程组规则见lazyForwardStep：找到匹配后不再开始新线程，
+ *          扫描到状态为空（最左起点及更早的线程全部结束）为止，最后一次接受的位置即为结束位置
+ */
+int RegexEngine::lazySearchEnd(const QString &input, int &startBound, bool &completed)
+{
+    completed = false;
+    if (m_lazyUnanchoredStart == -1) {
+        const QVector<NFAState> startSet = {LAZY_UNANCHORED_MARK};
+        m_lazyUnanchoredStart = addLazyState(startSet);
+        if (m_lazyUnanchoredStart == -1) {
+            resetLazyDFA();
+            m_lazyUnanchoredStart = addLazyState(startSet);
+        }
+    }
+    
+    int state = m_lazyUnanchoredStart;
+    int lastEnd = -1;
+    startBound = 0;
+    const int inputLen = input.length();
+    const QChar *data = input.constData();
+    
+    for (int i = 0; i < inputLen; i++) {
+        // 匹配前状态只有标记时没有延续中的线程：此后的匹配都从i或更晚开始，可先跳到下一个候选起点
+        if (lastEnd == -1 && m_lazyStateSets[state].size() == 1) {
+            if (m_hasPrefilter) {
+                i = nextCandidate(input, i);
+                if (i == -1) {
+                    completed = true;
+                    return -1;
+                }
+            }
+            startBound = i;
+        }
+        int symbol = lazyCharClass(data[i]) * m_lazyContextCount;
+        if (m_lazyContextCount > 1 && i == inputLen - 1) {
+            symbol += 2;
+        }
+        
+        int next = m_lazyNext[state * m_lazySymbolCount + symbol];
+        if (next == LAZY_UNKNOWN) {
+            next = computeLazyTransition(state, symbol);
+            if (next == LAZY_BAIL) {
+                return -1;
+            }
+        }
+        if (next == LAZY_DEAD) {
+            break;
+        }
+        
+        state = next;
+        ++m_lazyCharsSinceFlush;
+        if (m_lazyAccept[state]) {
+            lastEnd = i + 1;
+        }
+    }
+    
+    completed = true;
+    return lastEnd;
+}
+
+/**
+ * @brief 使用反向惰性DFA求最左匹配的起点
+ * @param input 输入字符串
+ * @param startBound 起点的下界，扫描到此为止
+ * @param matchEnd 最左起点处最长匹配的结束位置
+ * @param completed 惰性DFA是否完成扫描（输出参数）
+ * @return 在matchEnd结束的匹配中最小的起点，没有返回-1
+ * @details 反向状态从各接受状态的反向闭包开始，只从matchEnd向前扫描，状态为空或到达下界时停止。
+ *          最左起点到matchEnd本身是一个匹配，且没有更早开始的匹配，
+ *          因此在matchEnd结束的匹配中最小的起点就是最左起点
+ */
+int RegexEngine::lazyLeftmostStart(const QString &input, int startBound, int matchEnd, bool &completed)
+{
+    completed = false;
+    if (m_lazyReverseStart == -1) {
+        QVector<NFAState> acceptList(m_nfa.acceptStates.begin(), m_nfa.acceptStates.end());
+        QVector<NFAState> startSet = adjacencyClosure(acceptList, m_reverseEpsilon);
+        startSet.prepend(LAZY_REVERSE_MARK);
+        m_lazyReverseStart = addLazyState(startSet);
+        if (m_lazyReverseStart == -1) {
+            resetLazyDFA();
+            m_lazyReverseStart = addLazyState(startSet);
+        }
+    }
+    
+    int state = m_lazyReverseStart;
+    int leftmost = -1;
+    const int inputLen = input.length();
+    const QChar *data = input.constData();
+    
+    for (int i = matchEnd - 1; i >= startBound; i--) {
+        int symbol = lazyCharClass(data[i]) * m_lazyContextCount;
+        if (m_lazyContextCount > 1 && i == inputLen - 1) {
+            symbol += 2;
+        }
+        
+        int next = m_lazyNext[state * m_lazySymbolCount + symbol];
+        if (next == LAZY_UNKNOWN) {
+            next = computeLazyTransition(state, symbol);
+            if (next == LAZY_BAIL) {
+                return -1;
+            }
+        }
+        if (next == LAZY_DEAD) {
+            break;
+        }
+        
+        state = next;
+        ++m_lazyCharsSinceFlush;
+        if (m_lazyAccept[state]) {
+            leftmost = i;
+        }
+    }
+    
+    completed = true;
+    return leftmost;
+}
+
+/**
+ * @brief 准备位并行后端
+ * @details 统计AST中消耗字符的叶子（位置）。位置数不超过64时构造Glushkov位置自动机：
+ *          first/last集合、每个位置的follow集合，再把follow按字节拆成查找表，
+ *          并为每个字符等价类计算可接受的位置掩码。
+ *          字符等价类沿用prepareLazyDFA的划分，需在其之后调用
+ */
+void RegexEngine::prepareBitParallel()
+{
+    m_bitParallel = false;
+    m_followTable.clear();
+    m_classMask.clear();
+    if (!m_bitParallelEnabled) {
+        return;
+    }
+    
+    QVector<ASTNode*> positions;
+    QVector<quint64> follow(64, 0);
+    bool overflow = false;
+    GlushkovInfo root = buildGlushkov(m_root, positions, follow, overflow);
+    if (overflow || positions.isEmpty()) {
+        return;
+    }
+    
+    m_positionCount = positions.size();
+    m_firstMask = root.first;
+    m_lastMask = root.last;
+    m_caretMask = 0;
+    m_dollarMask = 0;
+    for (int p = 0; p < m_positionCount; ++p) {
+        if (positions[p]->type == ASTNodeType::CARET) {
+            m_caretMask |= Q_UINT64_C(1) << p;
+        } else if (positions[p]->type == ASTNodeType::DOLLAR) {
+            m_dollarMask |= Q_UINT64_C(1) << p;
+        }
+    }
+    
+    // 按字节拆分：表k的第b项为字节k取值b时各位置集合的并
+    m_followChunks = (m_positionCount + 7) / 8;
+    m_followTable = QVector<quint64>(m_followChunks * 256, 0);
+    for (int k = 0; k < m_followChunks; ++k) {
+        for (int b = 1; b < 256; ++b) {
+            int low = 0;
+            while (!(b & (1 << low))) {
+                ++low;
+            }
+            int p = k * 8 + low;
+            int rest = b & (b - 1);
+            quint64 followBits = p < m_positionCount ? follow[p] : 0;
+            m_followTable[k * 256 + b] = m_followTable[k * 256 + rest] | followBits;
+        }
+    }
+    
+    // 每个字符等价类可接受的位置（^和$位置接受任意字符，位置条件另行处理）
+    m_classMask = QVector<quint64>(m_classRepresentative.size(), 0);
+    for (int cls = 0; cls < m_classRepresentative.size(); ++cls) {
+        const QChar c = m_classRepresentative[cls];
+        quint64 mask = m_caretMask | m_dollarMask;
+        for (int p = 0; p < m_positionCount; ++p) {
+            const ASTNode *node = positions[p];
+            bool accepts = false;
+            switch (node->type) {
+                case ASTNodeType::CHARACTER:
+                    accepts = node->character == c;
+                    break;
+                case ASTNodeType::DOT:
+                    accepts = c != '\n';
+                    break;
+                case ASTNodeType::CHAR_SET:
+                    accepts = node->charSet.contains(c);
+                    break;
+                case ASTNodeType::NEG_CHAR_SET:
+                    accepts = !node->charSet.contains(c);
+                    break;
+                default:
+                    break;
+            }
+            if (accepts) {
+                mask |= Q_UINT64_C(1) << p;
+            }
+        }
+        m_classMask[cls] = mask;
+    }
+    
+    m_bitParallel = true;
+}
+
+/**
+ * @brief 递归构造Glushkov位置自动机
+ * @param node AST节点
+ * @param positions 位置 -> 叶子节点（输入输出参数）
+ * @param follow 每个位置的follow集合（输入输出参数）
+ * @param overflow 位置数超过64时置为true（输出参数）
+ * @return 该子树的first、last集合及是否可空
+ * @details 重复节点与buildRepeatNFA保持一致：max不为1时可循环，min为0时可空
+ */
+GlushkovInfo RegexEngine::buildGlushkov(ASTNode *node, QVector<ASTNode*> &positions,
+                                        QVector<quint64> &follow, bool &overflow)
+{
+    GlushkovInfo info = {0, 0, true};
+    if (!node || overflow) {
+        return info;
+    }
+    
+    switch (node->type) {
+        case ASTNodeType::CHARACTER:
+        case ASTNodeType::DOT:
+        case ASTNodeType::CARET:
+        case ASTNodeType::DOLLAR:
+        case ASTNodeType::CHAR_SET:
+        case ASTNodeType::NEG_CHAR_SET:
+            if (positions.size() >= 64) {
+                overflow = true;
+                return info;
+            }
+            info.first = info.last = Q_UINT64_C(1) << positions.size();
+            info.nullable = false;
+            positions.append(node);
+            return info;
+            
+        case ASTNodeType::CONCAT: {
+            GlushkovInfo left = buildGlushkov(node->left, positions, follow, overflow);
+            GlushkovInfo right = buildGlushkov(node->right, positions, follow, overflow);
+            for (int p = 0; p < 64; ++p) {
+                if (left.last & (Q_UINT64_C(1) << p)) {
+                    follow[p] |= right.first;
+                }
+            }
+            info.first = left.first | (left.nullable ? right.first : 0);
+            info.last = right.last | (right.nullable ? left.last : 0);
+            info.nullable = left.nullable && right.nullable;
+            return info;
+        }
+            
+        case ASTNodeType::CHOICE: {
+            GlushkovInfo left = buildGlushkov(node->left, positions, follow, overflow);
+            GlushkovInfo right = buildGlushkov(node->right, positions, follow, overflow);
+            info.first = left.first | right.first;
+            info.last = left.last | right.last;
+            info.nullable = left.nullable || right.nullable;
+            return info;
+        }
+            
+        case ASTNodeType::GROUP:
+            return buildGlushkov(node->left, positions, follow, overflow);
+            
+        case ASTNodeType::REPEAT: {
+            info = buildGlushkov(node->left, positions, follow, overflow);
+            if (node->maxRepeat != 1) {
+                for (int p = 0; p < 64; ++p) {
+                    if (info.last & (Q_UINT64_C(1) << p)) {
+                        follow[p] |= info.first;
+                    }
+                }
+            }
+            info.nullable = info.nullable || node->minRepeat == 0;
+            return info;
+        }
+            
+        default:
+            overflow = true;
+            return info;
+    }
+}
+
+/**
+ * @brief 求位置集合的follow并集
+ * @param positions 位置集合
+ * @return 各位置follow集合的并，每个字节查一次表
+ */
+quint64 RegexEngine::followOf(quint64 positions) const
+{
+    const quint64 *table = m_followTable.constData();
+    quint64 result = 0;
+    for (int k = 0; k < m_followChunks; ++k) {
+        result |= table[k * 256 + ((positions >> (8 * k)) & 0xFF)];
+    }
+    return result;
+}
+
+/**
+ * @brief 位并行匹配
+ * @param input 输入字符串
+ * @param startPos 匹配起始位置
+ * @param matchLength 匹配到的长度（输出参数）
+ * @return 匹配成功返回true，失败返回false
+ * @details 状态为"刚匹配过的位置"集合：D' = (follow(D)去掉^位置 | 起点处的first) & 字符掩码，
+ *          $位置只在最后一个字符处保留；记录最长匹配
+ */
+bool RegexEngine::simulateBitParallel(const QString &input, int startPos, int &matchLength)
+{
+    const int inputLen = input.length();
+    const QChar *data = input.constData();
+    const quint64 *classMask = m_classMask.constData();
+    int maxMatch = m_startAccepts ? 0 : -1;
+    quint64 active = 0;
+    
+    for (int i = startPos; i < inputLen; i++) {
+        quint64 reach = followOf(active) & ~m_caretMask;
+        if (i == startPos) {
+            reach |= m_firstMask;
+        }
+        if (i != inputLen - 1) {
+            reach &= ~m_dollarMask;
+        }
+        active = reach & classMask[lazyCharClass(data[i])];
+        if (active == 0) {
+            break;
+        }
+        if (active & m_lastMask) {
+            maxMatch = i - startPos + 1;
+        }
+    }
+    
+    if (maxMatch != -1) {
+        matchLength = maxMatch;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 位并行搜索最左起点处的最长匹配
+ * @param input 输入字符串
+ * @param startPos 匹配起点（输出参数）
+ * @param matchEnd 匹配结束位置（不含，输出参数）
+ * @return 找到非空匹配返回true
+ * @details 活跃位置按线程起点分组，组按起点从早到晚排列，已出现在更早组中的位置从较晚的组中去掉。
+ *          每组D' = follow(D)去掉^位置 & 字符掩码；未找到匹配时末尾加入本位置开始的组（first，^在此成立）。
+ *          某组含last位置时丢弃其后的组并不再开始新组，所有组结束时即得到最左起点与最长匹配的结束位置。
+ *          没有活跃组时用字面量前缀预筛选跳过不可能开始匹配的位置
+ */
+bool RegexEngine::bitParallelSearch(const QString &input, int &startPos, int &matchEnd)
+{
+    const int inputLen = input.length();
+    const QChar *data = input.constData();
+    const quint64 *classMask = m_classMask.constData();
+    QVector<quint64> groupMask;
+    QVector<int> groupStart;
+    int bestStart = -1;
+    int bestEnd = -1;
+    
+    for (int i = 0; i < inputLen; i++) {
+        if (groupMask.isEmpty()) {
+            if (bestStart != -1) {
+                break;
+            }
+            // 没有活跃位置时，直接跳到下一个可能的匹配起点
+            if (m_hasPrefilter) {
+                i = nextCandidate(input, i);
+                if (i == -1) {
+                    break;
+                }
+            }
+        }
+        quint64 allowed = classMask[lazyCharClass(data[i])];
+        if (i != inputLen - 1) {
+            allowed &= ~m_dollarMask;
+        }
+        
+        quint64 claimed = 0;
+        int kept = 0;
+        int matched = -1;
+        for (int g = 0; g < groupMask.size() && matched == -1; ++g) {
+            const quint64 active = followOf(groupMask[g]) & ~m_caretMask & allowed & ~claimed;
+            if (active == 0) {
+                continue;
+            }
+            claimed |= active;
+            groupMask[kept] = active;
+            groupStart[kept] = groupStart[g];
+            if (active & m_lastMask) {
+                matched = kept;
+            }
+            ++kept;
+        }
+        groupMask.resize(kept);
+        groupStart.resize(kept);
+        
+        if (matched == -1 && bestStart == -1) {
+            const quint64 active = m_firstMask & allowed & ~claimed;
+            if (active != 0) {
+                groupMask.append(active);
+                groupStart.append(i);
+                if (active & m_lastMask) {
+                    matched = groupMask.size() - 1;
+                }
+            }
+        }
+        if (matched != -1) {
+            bestStart = groupStart[matched];
+            bestEnd = i + 1;
+        }
+    }
+    
+    if (bestStart == -1) {
+        return false;
+    }
+    startPos = bestStart;
+    matchEnd = bestEnd;
+    return true;
+}
+
+/**
+ * @brief 准备字面量前缀预筛选
+ * @details 从AST求出所有非空匹配都必须以之开头的字面量集合。起始状态可接受
+ *          （存在空匹配）时任何位置都可能匹配，不启用预筛选
+ */
+void RegexEngine::prepareLiteralPrefix()
+{
+    m_literalPrefixes.clear();
+    m_prefixFirstLatin1 = QVector<bool>(256, false);
+    m_prefixFirstOther.clear();
+    m_hasPrefilter = false;
+    if (m_startAccepts) {
+        return;
+    }
+    
+    LiteralInfo info = literalPrefixes(m_root);
+    if (info.strings.isEmpty()) {
+        return;
+    }
+    
+    m_literalPrefixes = info.strings;
+    for (const QString &prefix : m_literalPrefixes) {
+        ushort c = prefix.at(0).unicode();
+        if (c < 256) {
+            m_prefixFirstLatin1[c] = true;
+        } else {
+            m_prefixFirstOther.insert(c);
+        }
+    }
+    m_hasPrefilter = true;
+}
+
+/**
+ * @brief 求子表达式的字面量前缀集合
+ * @param node AST节点
+ * @return 前缀集合；strings为空表示没有要求，complete表示子表达式恰好匹配这些字符串
+ * @details 连接节点在左侧完整时与右侧前缀做笛卡尔积；或节点取并集（过多时退化为首字符）；
+ *          重复至少一次时沿用子表达式的前缀；小字符集展开为单字符；
+ *          .、取反字符集以及消耗任意字符的^、$没有字面量要求
+ */
+LiteralInfo RegexEngine::literalPrefixes(ASTNode *node)
+{
+    LiteralInfo info;
+    info.complete = false;
+    if (!node) {
+        return info;
+    }
+    
+    switch (node->type) {
+        case ASTNodeType::CHARACTER:
+            info.strings << QString(node->character);
+            info.complete = true;
+            return info;
+            
+        case ASTNodeType::CHAR_SET:
+            if (!node->charSet.isEmpty() && node->charSet.size() <= MAX_LITERAL_CHAR_SET) {
+                QList<QChar> chars(node->charSet.begin(), node->charSet.end());
+                std::sort(chars.begin(), chars.end());
+                for (QChar c : chars) {
+                    info.strings << QString(c);
+                }
+                info.complete = true;
+            }
+            return info;
+            
+        case ASTNodeType::GROUP:
+            return literalPrefixes(node->left);
+            
+        case ASTNodeType::CONCAT: {
+            LiteralInfo left = literalPrefixes(node->left);
+            if (left.strings.isEmpty() || !left.complete) {
+                return left;
+            }
+            LiteralInfo right = literalPrefixes(node->right);
+            if (right.strings.isEmpty()
+                || left.strings.size() * right.strings.size() > MAX_LITERAL_PREFIXES) {
+                left.complete = false;
+                return left;
+            }
+            for (const QString &a : left.strings) {
+                for (const QString &b : right.strings) {
+                    if (a.length() + b.length() > MAX_LITERAL_LENGTH) {
+                        left.complete = false;
+                        return left;
+                    }
+                    info.strings << a + b;
+                }
+            }
+            info.complete = right.complete;
+            return info;
+        }
+            
+        case ASTNodeType::CHOICE: {
+            LiteralInfo left = literalPrefixes(node->left);
+            LiteralInfo right = literalPrefixes(node->right);
+            if (left.strings.isEmpty() || right.strings.isEmpty()) {
+                return info;
+            }
+            info.strings = left.strings;
+            for (const QString &b : right.strings) {
+                if (!info.strings.contains(b)) {
+                    info.strings << b;
+                }
+            }
+            info.complete = left.complete && right.complete;
+            if (info.strings.size() > MAX_LITERAL_PREFIXES) {
+                // 退化为首字符集合
+                QStringList firstChars;
+                for (const QString &prefix : info.strings) {
+                    QString first = prefix.left(1);
+                    if (!firstChars.contains(first)) {
+                        firstChars << first;
+                    }
+                }
+                info.strings = firstChars.size() <= MAX_LITERAL_PREFIXES ? firstChars : QStringList();
+                info.complete = false;
+            }
+            return info;
+        }
+            
+        case ASTNodeType::REPEAT:
+            if (node->minRepeat == 0) {
+                return info;
+            }
+            info = literalPrefixes(node->left);
+            info.complete = info.complete && node->maxRepeat == 1;
+            return info;
+            
+        default:
+            return info;
+    }
+}
+
+/**
+ * @brief 查找下一个可能的匹配起点
+ * @param input 输入字符串
+ * @param from 起始查找位置
+ * @return 不小于from且出现某个字面量前缀的最小位置，没有返回-1
+ * @details 只有一个前缀时直接使用QString::indexOf（Qt内部按字符块向量化扫描）；
+ *          多个前缀时按首字符表扫描，再逐个比较候选位置
+ */
+int RegexEngine::nextCandidate(const QString &input, int from) const
+{
+    if (m_literalPrefixes.size() == 1) {
+        const QString &prefix = m_literalPrefixes.first();
+        return prefix.length() == 1 ? input.indexOf(prefix.at(0), from) : input.indexOf(prefix, from);
+    }
+    
+    const int inputLen = input.length();
+    const QChar *data = input.constData();
+    for (int i = from; i < inputLen; i++) {
+        ushort c = data[i].unicode();
+        if (c < 256 ? !m_prefixFirstLatin1.at(c) : !m_prefixFirstOther.contains(c)) {
+            continue;
+        }
+        for (const QString &prefix : m_literalPrefixes) {
+            if (i + prefix.length() <= inputLen
+                && std::equal(prefix.constData(), prefix.constData() + prefix.length(), data + i)) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
 /**
  * @brief 检查是否为特殊字符
  * @param c 字符
@@ -174,7 +174,8 @@ bool RegexProcessor::parseLine(const QString &line, RegexItem &item)
     // 验证名称
     int code = 0;
     bool isMultiWord = false;
-    if (!validateName(name, code, isMultiWord)) {
+    bool caseInsensitive = false;
+    if (!validateName(name, code, isMultiWord, caseInsensitive)) {
         return false;
     }
 
@@ -191,6 +192,13 @@ bool RegexProcessor::parseLine(const QString &line, RegexItem &item)
         // 该函数能处理各种复杂情况，包括分组表达式和选择表达式
         wordList = generateWordsFromGroupedRegex(standardPattern);
         
+        // 不区分大小写时只保留小写形式，大小写变体由NFA中的字符类匹配
+        if (caseInsensitive) {
+            for (QString &word : wordList) {
+                word = word.toLower();
+            }
+        }
+        
         // 去重，确保每个单词只出现一次
         wordList.removeDuplicates();
         
@@ -204,6 +212,7 @@ bool RegexProcessor::parseLine(const QString &line, RegexItem &item)
     item.code = code;
     item.isMultiWord = isMultiWord;
     item.wordList = wordList;
+    item.caseInsensitive = caseInsensitive;
 
     return true;
 }
@@ -211,22 +220,25 @@ bool RegexProcessor::parseLine(const QString &line, RegexItem &item)
 /**
  * @brief 验证正则表达式名称
  * 
- * 验证正则表达式名称的格式，提取编码和是否为多单词
+ * 验证正则表达式名称的格式，提取编码、是否为多单词和是否不区分大小写。
+ * 名称可以S结尾表示多单词，以I结尾表示不区分大小写，两者同时使用时为SI；
+ * 多单词（关键字、符号等）总是不区分大小写
  * 
  * @param name 正则表达式名称
  * @param code 输出参数，存储提取的编码
  * @param isMultiWord 输出参数，指示是否为多单词
+ * @param caseInsensitive 输出参数，指示是否不区分大小写
  * @return bool 验证成功返回true，失败返回false
  */
-bool RegexProcessor::validateName(const QString &name, int &code, bool &isMultiWord)
+bool RegexProcessor::validateName(const QString &name, int &code, bool &isMultiWord, bool &caseInsensitive)
 {
     // 只有以下划线开头的正则表达式才需要验证命名规则
     if (name.startsWith('_')) {
-        // 检查名称格式：_xxx123 或 _xxx123S
+        // 检查名称格式：_xxx123，可带S、I或SI后缀
         
         // 检查长度，至少需要：_ + 1个字母 + 1个数字 + 0或1个S
         if (name.length() < 3) {
-            m_errorMessage = "正则表达式名称格式错误，应为 _名称编码 或 _名称编码S";
+            m_errorMessage = "正则表达式名称格式错误，应为 _名称编码、_名称编码S、_名称编码I 或 _名称编码SI";
             return false;
         }
         
@@ -244,7 +256,7 @@ bool RegexProcessor::validateName(const QString &name, int &code, bool &isMultiW
         
         // 确保名称部分至少有一个字符
         if (pos == 1) {
-            m_errorMessage = "正则表达式名称格式错误，应为 _名称编码 或 _名称编码S";
+            m_errorMessage = "正则表达式名称格式错误，应为 _名称编码、_名称编码S、_名称编码I 或 _名称编码SI";
             return false;
         }
         
@@ -261,7 +273,7 @@ bool RegexProcessor::validateName(const QString &name, int &code, bool &isMultiW
         
         // 确保编码部分至少有一个数字
         if (pos == codeStartPos) {
-            m_errorMessage = "正则表达式名称格式错误，应为 _名称编码 或 _名称编码S";
+            m_errorMessage = "正则表达式名称格式错误，应为 _名称编码、_名称编码S、_名称编码I 或 _名称编码SI";
             return false;
         }
         
@@ -273,20 +285,31 @@ bool RegexProcessor::validateName(const QString &name, int &code, bool &isMultiW
             return false;
         }
         
-        // 检查是否为多单词（可选的S结尾）
+        // 检查是否为多单词（可选的S）与不区分大小写（可选的I）
         isMultiWord = false;
+        caseInsensitive = false;
+        if (pos < name.length() && name.at(pos) == 'S') {
+            isMultiWord = true;
+            pos++;
+        }
+        if (pos < name.length() && name.at(pos) == 'I') {
+            caseInsensitive = true;
+            pos++;
+        }
         if (pos < name.length()) {
-            if (name.at(pos) == 'S' && pos == name.length() - 1) {
-                isMultiWord = true;
-            } else {
-                m_errorMessage = "正则表达式名称格式错误，应为 _名称编码 或 _名称编码S";
-                return false;
-            }
+            m_errorMessage = "正则表达式名称格式错误，应为 _名称编码、_名称编码S、_名称编码I 或 _名称编码SI";
+            return false;
+        }
+        
+        // 多单词的所有大小写形式都映射到同一编码
+        if (isMultiWord) {
+            caseInsensitive = true;
         }
     } else {
         // 对于非下划线开头的正则表达式，设置默认值
         code = 0;
         isMultiWord = false;
+        caseInsensitive = false;
     }
 
     return true;
@@ -305,9 +328,9 @@ QString RegexProcessor::processEscapeCharacters(const QString &pattern)
     QString result = pattern;
     
     // 处理转义字符
-    // Escape special characters: +, *, ?, |, (, ), [, ], {, }, ., ^, $
+    // Escape special characters: +, *, ?, |, (, ), [, ], {, }, ., ^, $, -
     QList<QChar> specialChars;
-    specialChars << '+' << '*' << '?' << '|' << '(' << ')' << '[' << ']' << '{' << '}' << '.' << '^' << '$' << '\\';    
+    specialChars << '+' << '*' << '?' << '|' << '(' << ')' << '[' << ']' << '{' << '}' << '.' << '^' << '$' << '-' << '\\';
     
     // Iterate through the string and process escape characters
     for (int i = 0; i < result.length(); ++i) {
@@ -317,6 +340,10 @@ QString RegexProcessor::processEscapeCharacters(const QString &pattern)
             if (specialChars.contains(nextC)) {
                 // Keep escape character for special characters
                 i++; // Skip next character
+            } else if (nextC == 'n' || nextC == 't' || nextC == 'r') {
+                // Control characters, e.g. [^\n] in a negated character class
+                QChar control = nextC == 'n' ? QChar('\n') : (nextC == 't' ? QChar('\t') : QChar('\r'));
+                result.replace(i, 2, QString(control));
             } else {
                 // Remove unnecessary escape
                 result.remove(i, 1);
@@ -495,61 +522,6 @@ QStringList RegexProcessor::extractMultiWords(const QString &pattern)
     return result;
 }
 
-/**
- * @brief 生成所有可能的大小写组合
- * 
- * 注意：此函数只处理简单字符串，不处理包含 (、) 或 | 的复杂表达式
- * 
- * @param pattern 要生成大小写组合的字符串
- * @return QStringList 所有可能的大小写组合
- */
-QStringList RegexProcessor::generateAllCaseCombinations(const QString &pattern)
-{
-    QStringList result;
-    
-    // 处理基本情况：空字符串
-    if (pattern.isEmpty()) {
-        result.append("");
-        return result;
-    }
-    
-    // 检查是否包含复杂表达式符号
-    if (pattern.contains('(') || pattern.contains(')') || pattern.contains('|')) {
-        // 包含复杂表达式符号，直接返回原字符串
-        result.append(pattern);
-        return result;
-    }
-    
-    // 处理普通字符串
-    if (pattern.length() == 1) {
-        // 单个字符，返回原始字符和大写字符（如果是字母）
-        result.append(pattern);
-        if (pattern.at(0).isLetter()) {
-            result.append(pattern.toUpper());
-        }
-        return result;
-    }
-    
-    // 递归处理：将字符串拆分为第一个字符和剩余部分
-    QString firstChar = pattern.left(1);
-    QString rest = pattern.mid(1);
-    
-    QStringList firstCombinations = generateAllCaseCombinations(firstChar);
-    QStringList restCombinations = generateAllCaseCombinations(rest);
-    
-    // 生成所有组合
-    for (const QString &first : firstCombinations) {
-        for (const QString &r : restCombinations) {
-            result.append(first + r);
-        }
-    }
-    
-    // 去重，确保每个组合只出现一次
-    result.removeDuplicates();
-    
-    return result;
-}
-
 /**
  * @brief 从分组的正则表达式中生成所有可能的单词变体
  * 
@@ -641,8 +613,9 @@ QStringList RegexProcessor::generateWordsFromGroupedRegex(const QString &pattern
     
     // 检查是否为简单字符串
     if (!pattern.contains('(') && !pattern.contains(')')) {
-        // 简单字符串，直接生成大小写组合
-        return generateAllCaseCombinations(pattern);
+        // 简单字符串即为单词本身，大小写由RegexItem::caseInsensitive处理
+        result.append(pattern);
+        return result;
     }
     
     // 否则，是分组表达式，需要生成笛卡尔积
@@ -698,9 +671,8 @@ QStringList RegexProcessor::generateWordsFromGroupedRegex(const QString &pattern
             QStringList groupOptions = generateWordsFromGroupedRegex(inner, depth + 1);
             allOptions.append(groupOptions);
         } else {
-            // 处理普通字符串：生成大小写组合
-            QStringList simpleOptions = generateAllCaseCombinations(part);
-            allOptions.append(simpleOptions);
+            // 处理普通字符串
+            allOptions.append(QStringList(part));
         }
     }
     
@@ -0,0 +1,281 @@
+/*
+ * @file symboltable.cpp
+ * @id symboltable-cpp
+ * @brief 实现输入符号驻留表
+ * @version 1.0
+ * @author 郭梓烽
+ * @date 2025/12/07
+ * @copyright Copyright (c) 2025 郭梓烽
+ */
+#include "task1/symboltable.h"
+#include <algorithm>
+
+/**
+ * @brief 将单个字符转换为字符类文本中的写法
+ * 
+ * @param c 字符编码
+ * @return QString 转义后的字符
+ */
+static QString classCharText(ushort c)
+{
+    switch (c) {
+    case '\n': return "\\n";
+    case '\t': return "\\t";
+    case '\r': return "\\r";
+    case '\\': case ']': case '[': case '-': case '^':
+        return QString("\\") + QChar(c);
+    default:
+        break;
+    }
+    if (c < 0x20 || (c >= 0x7F && c <= 0xFF)) {
+        return QString("\\x%1").arg(static_cast<uint>(c), 2, 16, QChar('0'));
+    }
+    return QString(QChar(c));
+}
+
+/**
+ * @brief 构造函数
+ * 
+ * 预先驻留空串符号"#"，保证其编号为EPSILON
+ */
+SymbolTable::SymbolTable()
+{
+    m_ids.insert("#", EPSILON);
+    m_texts.append("#");
+    m_ranges.append(QList<CharRange>());
+}
+
+/**
+ * @brief 获取全局符号表实例
+ * 
+ * @return SymbolTable& 符号表实例
+ */
+SymbolTable &SymbolTable::instance()
+{
+    static SymbolTable table;
+    return table;
+}
+
+/**
+ * @brief 驻留符号文本
+ * 
+ * @param text 符号文本
+ * @return SymbolId 符号编号，符号表已满时返回INVALID
+ */
+SymbolId SymbolTable::intern(const QString &text)
+{
+    SymbolTable &table = instance();
+    auto it = table.m_ids.constFind(text);
+    if (it != table.m_ids.constEnd()) {
+        return it.value();
+    }
+    
+    // 编号空间耗尽（INVALID保留不分配）
+    if (table.m_texts.size() >= INVALID) {
+        return INVALID;
+    }
+    
+    SymbolId id = static_cast<SymbolId>(table.m_texts.size());
+    table.m_ids.insert(text, id);
+    table.m_texts.append(text);
+    
+    // 单字符符号对应只含该字符的区间
+    QList<CharRange> ranges;
+    if (text.length() == 1) {
+        ushort c = text.at(0).unicode();
+        ranges.append({c, c});
+    }
+    table.m_ranges.append(ranges);
+    return id;
+}
+
+/**
+ * @brief 驻留字符类符号
+ * 
+ * @param ranges 字符区间列表
+ * @param negated 是否为取反字符类
+ * @return SymbolId 符号编号，字符集为空或符号表已满时返回INVALID
+ */
+SymbolId SymbolTable::internClass(const QList<CharRange> &ranges, bool negated)
+{
+    QList<CharRange> normalized = normalizeRanges(ranges);
+    
+    if (negated) {
+        // 在[0, CLASS_UNIVERSE_MAX]内求补集
+        QList<CharRange> complement;
+        uint next = 0;
+        for (const CharRange &range : normalized) {
+            if (range.low > CLASS_UNIVERSE_MAX) {
+                break;
+            }
+            if (range.low > next) {
+                complement.append({static_cast<ushort>(next), static_cast<ushort>(range.low - 1)});
+            }
+            next = static_cast<uint>(range.high) + 1;
+        }
+        if (next <= CLASS_UNIVERSE_MAX) {
+            complement.append({static_cast<ushort>(next), CLASS_UNIVERSE_MAX});
+        }
+        normalized = complement;
+    }
+    
+    if (normalized.isEmpty()) {
+        return INVALID;
+    }
+    
+    // 单个字符与普通符号共用编号
+    if (normalized.size() == 1 && normalized.first().low == normalized.first().high) {
+        return intern(QString(QChar(normalized.first().low)));
+    }
+    
+    SymbolId id = intern(classText(normalized));
+    if (id != INVALID) {
+        instance().m_ranges[id] = normalized;
+    }
+    return id;
+}
+
+/**
+ * @brief 查找符号文本对应的编号
+ * 
+ * @param text 符号文本
+ * @return SymbolId 符号编号，不存在时返回INVALID
+ */
+SymbolId SymbolTable::lookup(const QString &text)
+{
+    return instance().m_ids.value(text, INVALID);
+}
+
+/**
+ * @brief 获取符号编号对应的文本
+ * 
+ * @param id 符号编号
+ * @return QString 符号文本
+ */
+QString SymbolTable::text(SymbolId id)
+{
+    const SymbolTable &table = instance();
+    if (id >= table.m_texts.size()) {
+        return QString();
+    }
+    return table.m_texts.at(id);
+}
+
+/**
+ * @brief 获取符号所匹配的字符区间
+ * 
+ * @param id 符号编号
+ * @return QList<CharRange> 字符区间列表
+ */
+QList<CharRange> SymbolTable::ranges(SymbolId id)
+{
+    const SymbolTable &table = instance();
+    if (id >= table.m_ranges.size()) {
+        return QList<CharRange>();
+    }
+    return table.m_ranges.at(id);
+}
+
+/**
+ * @brief 判断符号是否匹配某个字符
+ * 
+ * @param id 符号编号
+ * @param c 字符编码
+ * @return bool 匹配返回true
+ */
+bool SymbolTable::matches(SymbolId id, ushort c)
+{
+    const SymbolTable &table = instance();
+    if (id >= table.m_ranges.size()) {
+        return false;
+    }
+    for (const CharRange &range : table.m_ranges.at(id)) {
+        if (c < range.low) {
+            return false;
+        }
+        if (c <= range.high) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 排序并合并重叠或相邻的区间
+ * 
+ * @param ranges 原始区间列表
+ * @return QList<CharRange> 规范化后的区间列表
+ */
+QList<CharRange> SymbolTable::normalizeRanges(const QList<CharRange> &ranges)
+{
+    QList<CharRange> sorted = ranges;
+    std::sort(sorted.begin(), sorted.end(), [](const CharRange &a, const CharRange &b) {
+        return a.low < b.low;
+    });
+    
+    QList<CharRange> result;
+    for (const CharRange &range : sorted) {
+        if (range.low > range.high) {
+            continue; // 跳过无效区间
+        }
+        if (!result.isEmpty() && static_cast<uint>(range.low) <= static_cast<uint>(result.last().high) + 1) {
+            result.last().high = std::max(result.last().high, range.high);
+        } else {
+            result.append(range);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 生成字符类的规范文本
+ * 
+ * @param ranges 规范化后的区间列表
+ * @return QString 字符类文本
+ */
+QString SymbolTable::classText(const QList<CharRange> &ranges)
+{
+    auto rangesText = [](const QList<CharRange> &list) {
+        QString text;
+        for (const CharRange &range : list) {
+            text += classCharText(range.low);
+            if (range.high == range.low + 1) {
+                text += classCharText(range.high);
+            } else if (range.high > range.low) {
+                text += "-" + classCharText(range.high);
+            }
+        }
+        return text;
+    };
+    
+    QString positive = "[" + rangesText(ranges) + "]";
+    
+    // 全部落在取反全集内时，尝试取反写法
+    if (ranges.last().high > CLASS_UNIVERSE_MAX) {
+        return positive;
+    }
+    QList<CharRange> excluded;
+    uint next = 0;
+    for (const CharRange &range : ranges) {
+        if (range.low > next) {
+            excluded.append({static_cast<ushort>(next), static_cast<ushort>(range.low - 1)});
+        }
+        next = static_cast<uint>(range.high) + 1;
+    }
+    if (next <= CLASS_UNIVERSE_MAX) {
+        excluded.append({static_cast<ushort>(next), CLASS_UNIVERSE_MAX});
+    }
+    QString negative = "[^" + rangesText(excluded) + "]";
+    
+    return negative.length() < positive.length() ? negative : positive;
+}
+
+/**
+ * @brief 获取已驻留的符号数量
+ * 
+ * @return int 符号数量
+ */
+int SymbolTable::size()
+{
+    return instance().m_texts.size();
+}
@@ -8,6 +8,7 @@
  * @copyright Copyright (c) 2025 郭梓烽
  */
 #include "task1/task1window.h"
+#include "task1/compiledlexer.h"
 #include "ui_task1window.h"
 #include <QFileDialog>
 #include <QFile>
@@ -15,6 +16,7 @@
 #include <QMessageBox>
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <utility>
 
 /**
@@ -30,9 +32,15 @@ Task1Window::Task1Window(QWidget *parent)
     , m_dynamicTableNFA(nullptr)
     , m_dynamicTableDFA(nullptr)
     , m_dynamicTableMinDFA(nullptr)
+    , m_checkBoxDirectDFA(nullptr)
 {
     ui->setupUi(this);
     
+    // 构建时不记录状态来源，DFA表格显示时再按需计算（见updateDFADisplay）
+    m_dfaBuilder.setKeepProvenance(false);
+    // 子集构造按机器核心数并行，状态编号与单线程一致
+    m_dfaBuilder.setThreadCount(0);
+    
     // 创建动态表格
     createDynamicTables();
     
@@ -79,9 +87,15 @@ Task1Window::Task1Window(QWidget *parent)
         nfaLayout->addWidget(btnRefreshNFA);
     }
     
+    // DFA构造方式：默认对NFA做子集构造，勾选后由语法树按followpos直接构造
+    m_checkBoxDirectDFA = new QCheckBox(tr("直接构造DFA"), this);
+    m_checkBoxDirectDFA->setObjectName("checkBoxDirectDFA");
+    m_checkBoxDirectDFA->setToolTip(tr("跳过NFA，由正则表达式语法树按followpos直接构造DFA"));
+    
     // 找到DFA标签页的水平布局并添加刷新按钮
     QHBoxLayout *dfaLayout = qobject_cast<QHBoxLayout*>(ui->tabDFA->layout()->itemAt(0)->layout());
     if (dfaLayout) {
+        dfaLayout->addWidget(m_checkBoxDirectDFA);
         dfaLayout->addWidget(btnRefreshDFA);
     }
     
@@ -161,17 +175,19 @@ void Task1Window::on_btnParseRegex_clicked()
     
     if (m_regexProcessor.parse(regexText)) {
         m_currentRegexItems = m_regexProcessor.getRegexItems();
+        m_currentRegexText = regexText;
         
         // 更新正则表达式下拉列表
         updateRegexComboBox();
         
         QString message = tr("成功解析 %1 个正则表达式\n\n").arg(m_currentRegexItems.size());
         for (const RegexItem &item : m_currentRegexItems) {
-            message += tr("名称: %1\n模式: %2\n编码: %3\n是否多单词: %4\n\n")
+            message += tr("名称: %1\n模式: %2\n编码: %3\n是否多单词: %4\n不区分大小写: %5\n\n")
                       .arg(item.name)
                       .arg(item.pattern)
                       .arg(item.code)
-                      .arg(item.isMultiWord ? tr("是") : tr("否"));
+                      .arg(item.isMultiWord ? tr("是") : tr("否"))
+                      .arg(item.caseInsensitive ? tr("是") : tr("否"));
         }
         QMessageBox::information(this, tr("成功"), message);
     } else {
@@ -216,31 +232,14 @@ void Task1Window::on_btnGenerateNFA_clicked()
     
     QList<RegexItem> regexItems = m_regexProcessor.getRegexItems();
     m_currentRegexItems = regexItems;
+    m_currentRegexText = regexText;
     if (regexItems.isEmpty()) {
         QMessageBox::warning(this, tr("警告"), tr("没有找到有效的正则表达式"));
         return;
     }
     
-    // 清空之前的NFA映射
-    m_nfaMap.clear();
-    
-    // 为每个以下划线开头的正则表达式构建NFA
-    int generatedCount = 0;
-    for (int i = 0; i < regexItems.size(); i++) {
-        const RegexItem &item = regexItems[i];
-        // 仅为下划线开头的正则表达式生成NFA
-        if (item.name.startsWith('_')) {
-            NFA nfa = m_nfaBuilder.buildNFA(item);
-            if (!nfa.states.isEmpty()) {
-                // 设置接受状态的正则表达式索引
-                for (const NFAState &state : nfa.acceptStates) {
-                    nfa.acceptStateToRegexIndex[state] = i;
-                }
-                m_nfaMap[item.name] = nfa;
-                generatedCount++;
-            }
-        }
-    }
+    // 为每个以下划线开头的正则表达式构建NFA，并生成总NFA
+    int generatedCount = buildNFAs();
     
     if (generatedCount == 0) {
         QMessageBox::warning(this, tr("错误"), tr("NFA构建失败: %1").arg(m_nfaBuilder.getErrorMessage()));
@@ -255,11 +254,6 @@ void Task1Window::on_btnGenerateNFA_clicked()
     // 更新正则表达式下拉列表
     updateRegexComboBox();
     
-    // 生成总NFA
-    if (generatedCount > 0) {
-        m_totalNFA = mergeNFAs(m_nfaMap.values());
-    }
-    
     // 更新NFA显示
     updateNFADisplay();
     
@@ -268,156 +262,341 @@ void Task1Window::on_btnGenerateNFA_clicked()
 
 // DFA模块
 /**
- * @brief 合并多个NFA
- * 
- * 将多个NFA合并为一个总NFA
+ * @brief 生成DFA按钮点击事件
  * 
- * @param nfAs 要合并的NFA列表
- * @return NFA 合并后的总NFA
+ * 为每个NFA生成DFA，生成总DFA，并更新显示
  */
-NFA Task1Window::mergeNFAs(const QList<NFA> &nfAs)
+void Task1Window::on_btnGenerateDFA_clicked()
 {
-    NFA totalNFA;
-    if (nfAs.isEmpty()) {
-        return totalNFA;
+    // 检查是否已生成NFA
+    if (m_nfaMap.isEmpty()) {
+        QMessageBox::warning(this, tr("警告"), tr("请先生成NFA"));
+        return;
     }
     
-    // 状态偏移量，用于确保每个NFA的状态编号不冲突
-    int stateOffset = 0;
+    // 重新生成DFA
+    qint64 elapsedMs = 0;
+    buildDFAs(elapsedMs);
     
-    // 收集所有NFA的起始状态（偏移后）
-    QList<NFAState> allStartStates;
+    // 更新DFA显示
+    updateDFADisplay();
     
-    // 合并所有NFA的状态、转移、接受状态和字母表
-    for (const NFA &nfa : nfAs) {
-        // 处理状态
-        for (const NFAState &state : nfa.states) {
-            totalNFA.states.append(state + stateOffset);
-        }
-        
-        // 处理转移
-        for (const NFATransition &transition : nfa.transitions) {
-            NFATransition newTransition;
-            newTransition.fromState = transition.fromState + stateOffset;
-            newTransition.input = transition.input;
-            newTransition.toState = transition.toState + stateOffset;
-            totalNFA.transitions.append(newTransition);
+    QMessageBox::information(this, tr("成功"), tr("DFA生成成功！（%1，耗时 %2 ms）")
+                             .arg(m_checkBoxDirectDFA->isChecked() ? tr("followpos直接构造") : tr("子集构造"))
+                             .arg(elapsedMs));
+}
+
+/**
+ * @brief 设置产物中接受状态的正则表达式索引
+ * 
+ * 单个正则表达式的NFA/DFA只有一个正则表达式索引，缓存项换到新索引时整体替换
+ * 
+ * @param automaton NFA或DFA
+ * @param regexIndex 新的正则表达式索引
+ */
+template <typename Automaton>
+static void setRegexIndex(Automaton &automaton, int regexIndex)
+{
+    for (auto it = automaton.acceptStateToRegexIndex.begin(); it != automaton.acceptStateToRegexIndex.end(); ++it) {
+        it.value() = regexIndex;
+    }
+}
+
+/**
+ * @brief 获取构建缓存项
+ * 
+ * 缓存以展开后的模式文本（已代入引用的命名正则）及大小写标志为键，二者不变则产物不变；
+ * 同一模式换了正则表达式索引时只需改写已缓存产物中的索引
+ * 
+ * @param item 正则表达式项
+ * @param regexIndex 正则表达式索引
+ * @return AutomatonCacheEntry& 缓存项，不存在时新建空项
+ */
+AutomatonCacheEntry &Task1Window::cacheEntry(const RegexItem &item, int regexIndex)
+{
+    const QString key = cacheKey(item);
+    auto it = m_buildCache.find(key);
+    if (it == m_buildCache.end()) {
+        AutomatonCacheEntry entry;
+        entry.regexIndex = regexIndex;
+        entry.hasNFA = false;
+        entry.hasDFA = false;
+        entry.dfaDirect = false;
+        entry.hasMinimizedDFA = false;
+        it = m_buildCache.insert(key, entry);
+    } else if (it->regexIndex != regexIndex) {
+        setRegexIndex(it->nfa, regexIndex);
+        setRegexIndex(it->dfa, regexIndex);
+        setRegexIndex(it->minimizedDFA, regexIndex);
+        it->regexIndex = regexIndex;
+    }
+    return it.value();
+}
+
+/**
+ * @brief 获取正则表达式项的构建缓存键
+ * 
+ * 不区分大小写会改变构建出的自动机，多单词项的DFA带有单词下标标注，
+ * 因此这两个标志也是键的一部分
+ * 
+ * @param item 正则表达式项
+ * @return QString 缓存键
+ */
+QString Task1Window::cacheKey(const RegexItem &item)
+{
+    if (item.isMultiWord) {
+        return "w:" + item.pattern;
+    }
+    return (item.caseInsensitive ? "i:" : "s:") + item.pattern;
+}
+
+/**
+ * @brief 生成NFA
+ * 
+ * 为m_currentRegexItems中每个以下划线开头的正则表达式生成NFA，
+ * 模式未变化的取自构建缓存，不再出现的模式从缓存中移除。
+ * 各项名称、模式与索引都与上次相同时保留原有总NFA
+ * 
+ * @return int 生成的NFA数量
+ */
+int Task1Window::buildNFAs()
+{
+    m_nfaMap.clear();
+    
+    int generatedCount = 0;
+    QSet<QString> usedKeys;
+    for (int i = 0; i < m_currentRegexItems.size(); i++) {
+        const RegexItem &item = m_currentRegexItems[i];
+        // 仅为下划线开头的正则表达式生成NFA
+        if (!item.name.startsWith('_')) {
+            continue;
         }
+        usedKeys.insert(cacheKey(item));
         
-        // 处理接受状态
-        for (const NFAState &acceptState : nfa.acceptStates) {
-            totalNFA.acceptStates.insert(acceptState + stateOffset);
-            // 处理接受状态到正则表达式索引的映射
-            if (nfa.acceptStateToRegexIndex.contains(acceptState)) {
-                int regexIndex = nfa.acceptStateToRegexIndex[acceptState];
-                totalNFA.acceptStateToRegexIndex[acceptState + stateOffset] = regexIndex;
+        AutomatonCacheEntry &entry = cacheEntry(item, i);
+        if (!entry.hasNFA) {
+            NFA nfa = m_nfaBuilder.buildNFA(item);
+            if (nfa.states.isEmpty()) {
+                continue;
+            }
+            // 设置接受状态的正则表达式索引
+            for (const NFAState &state : nfa.acceptStates) {
+                nfa.acceptStateToRegexIndex[state] = i;
             }
+            entry.nfa = nfa;
+            entry.hasNFA = true;
         }
-        
-        // 处理字母表 - 合并所有NFA的字母表
-        totalNFA.alphabet.unite(nfa.alphabet);
-        
-        // 记录偏移后的起始状态
-        allStartStates.append(nfa.startState + stateOffset);
-        
-        // 更新状态偏移量
-        stateOffset += nfa.states.size();
+        m_nfaMap[item.name] = entry.nfa;
+        generatedCount++;
     }
     
-    // 创建总起始状态
-    NFAState totalStartState = stateOffset;
-    totalNFA.startState = totalStartState;
-    totalNFA.states.append(totalStartState);
+    // 移除不再使用的模式
+    for (auto it = m_buildCache.begin(); it != m_buildCache.end();) {
+        if (usedKeys.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_buildCache.erase(it);
+        }
+    }
     
-    // 从总起始状态添加ε转移到每个NFA的起始状态
-    for (const NFAState &startState : allStartStates) {
-        NFATransition transition;
-        transition.fromState = totalStartState;
-        transition.input = "#"; // ε转移
-        transition.toState = startState;
-        totalNFA.transitions.append(transition);
+    // 总表签名：按合并顺序记录每项的名称、模式与索引
+    QHash<QString, int> itemIndex;
+    for (int i = 0; i < m_currentRegexItems.size(); ++i) {
+        itemIndex.insert(m_currentRegexItems[i].name, i);
+    }
+    m_nfaSignature.clear();
+    for (auto it = m_nfaMap.constBegin(); it != m_nfaMap.constEnd(); ++it) {
+        int index = itemIndex.value(it.key());
+        m_nfaSignature += it.key() + QChar(0x1F) + m_currentRegexItems[index].pattern
+                          + QChar(0x1F) + QString::number(index) + QChar(0x1E);
     }
     
-    // 构建总NFA的邻接表
-    totalNFA.transitionTable.clear();
-    for (const NFATransition &transition : totalNFA.transitions) {
-        totalNFA.transitionTable[transition.fromState][transition.input].insert(transition.toState);
+    // 生成总NFA
+    if (generatedCount == 0) {
+        m_totalNFA = NFA();
+        m_totalNFAKey.clear();
+    } else if (m_totalNFAKey != m_nfaSignature) {
+        m_totalNFA = NFABuilder::mergeNFAs(m_nfaMap.values());
+        m_totalNFAKey = m_nfaSignature;
     }
     
-    return totalNFA;
+    return generatedCount;
 }
 
 /**
- * @brief 生成DFA按钮点击事件
+ * @brief 按当前构造方式生成DFA
  * 
- * 为每个NFA生成DFA，生成总DFA，并更新显示
+ * 未勾选"直接构造DFA"时对NFA做子集构造；勾选时由语法树按followpos直接构造，
+ * 不使用NFA与总NFA。总DFA中各正则表达式的顺序与NFABuilder::mergeNFAs一致，
+ * 两种方式的DFA语言相同，耗时可用于对比。
+ * 模式与构造方式未变化的单个DFA取自构建缓存，总表签名未变化时保留原有总DFA
+ * 
+ * @param elapsedMs 输出参数，构造耗时（毫秒）
+ * @return int 生成的单个DFA数量
  */
-void Task1Window::on_btnGenerateDFA_clicked()
+int Task1Window::buildDFAs(qint64 &elapsedMs)
 {
-    // 检查是否已生成NFA
-    if (m_nfaMap.isEmpty()) {
-        QMessageBox::warning(this, tr("警告"), tr("请先生成NFA"));
-        return;
-    }
+    QElapsedTimer timer;
+    timer.start();
     
-    // 清空之前的DFA映射
+    const bool direct = m_checkBoxDirectDFA->isChecked();
     m_dfaMap.clear();
+    int generatedCount = 0;
+    
+    // 按名称查找正则表达式项及其索引
+    QHash<QString, int> itemIndex;
+    for (int i = 0; i < m_currentRegexItems.size(); ++i) {
+        itemIndex.insert(m_currentRegexItems[i].name, i);
+    }
+    
+    // 接受冲突按多单词项优先、声明顺序次之解决，与m_nfaMap的名称顺序无关
+    m_dfaBuilder.setTokenPriority(m_currentRegexItems);
     
-    // 为每个NFA生成DFA
     for (auto it = m_nfaMap.constBegin(); it != m_nfaMap.constEnd(); ++it) {
-        const QString &regexName = it.key();
-        const NFA &nfa = it.value();
+        int index = itemIndex.value(it.key(), -1);
+        if (index < 0) {
+            continue;
+        }
         
-        DFA dfa = m_dfaBuilder.convertNFAToDFA(nfa);
-        if (!dfa.states.isEmpty()) {
-            m_dfaMap[regexName] = dfa;
+        AutomatonCacheEntry &entry = cacheEntry(m_currentRegexItems[index], index);
+        if (!entry.hasDFA || entry.dfaDirect != direct) {
+            DFA dfa;
+            if (direct) {
+                RegexSyntaxTree tree = m_nfaBuilder.buildSyntaxTree(m_currentRegexItems[index]);
+                if (tree.root < 0) {
+                    continue;
+                }
+                dfa = m_dfaBuilder.convertRegexesToDFA(QList<RegexSyntaxTree>() << tree, QList<int>() << index);
+            } else {
+                dfa = m_dfaBuilder.convertNFAToDFA(it.value());
+            }
+            if (dfa.states.isEmpty()) {
+                continue;
+            }
+            m_dfaBuilder.labelWordAcceptStates(dfa, m_currentRegexItems);
+            entry.dfa = dfa;
+            entry.hasDFA = true;
+            entry.dfaDirect = direct;
+            entry.hasMinimizedDFA = false;
         }
+        m_dfaMap[it.key()] = entry.dfa;
+        generatedCount++;
     }
     
     // 生成总DFA
-    if (!m_totalNFA.states.isEmpty()) {
-        m_totalDFA = m_dfaBuilder.convertNFAToDFA(m_totalNFA);
+    QString totalKey = m_nfaSignature + (direct ? "direct" : "subset");
+    if (m_totalDFAKey != totalKey) {
+        m_totalDFA = DFA();
+        m_totalDFAKey.clear();
+        
+        if (direct) {
+            QList<RegexSyntaxTree> trees;
+            QList<int> regexIndices;
+            for (auto it = m_nfaMap.constBegin(); it != m_nfaMap.constEnd(); ++it) {
+                int index = itemIndex.value(it.key(), -1);
+                if (index < 0) {
+                    continue;
+                }
+                RegexSyntaxTree tree = m_nfaBuilder.buildSyntaxTree(m_currentRegexItems[index]);
+                if (tree.root >= 0) {
+                    trees.append(tree);
+                    regexIndices.append(index);
+                }
+            }
+            if (!trees.isEmpty()) {
+                m_totalDFA = m_dfaBuilder.convertRegexesToDFA(trees, regexIndices);
+            }
+        } else if (!m_totalNFA.states.isEmpty()) {
+            m_totalDFA = m_dfaBuilder.convertNFAToDFA(m_totalNFA);
+        }
+        
+        if (!m_totalDFA.states.isEmpty()) {
+            m_dfaBuilder.labelWordAcceptStates(m_totalDFA, m_currentRegexItems);
+            m_totalDFAKey = totalKey;
+        }
     }
     
-    // 更新DFA显示
-    updateDFADisplay();
-    
-    QMessageBox::information(this, tr("成功"), tr("DFA生成成功！"));
+    elapsedMs = timer.elapsed();
+    return generatedCount;
 }
 
-// 最小化DFA模块
 /**
- * @brief 最小化DFA按钮点击事件
+ * @brief 生成最小化DFA
  * 
- * 为每个DFA生成最小化DFA，生成总最小化DFA，并更新显示
+ * 对m_dfaMap中的每个DFA及总DFA做最小化。DFA取自构建缓存的项复用缓存中的最小化结果，
+ * 总DFA未变化时保留原有总最小化DFA
+ * 
+ * @return int 生成的单个最小化DFA数量
  */
-void Task1Window::on_btnMinimizeDFA_clicked()
+int Task1Window::buildMinimizedDFAs()
 {
-    // 检查是否已生成DFA
-    if (m_dfaMap.isEmpty()) {
-        QMessageBox::warning(this, tr("警告"), tr("请先生成DFA"));
-        return;
-    }
-    
-    // 清空之前的最小化DFA映射
     m_minimizedDfaMap.clear();
+    int generatedCount = 0;
+    
+    QHash<QString, int> itemIndex;
+    for (int i = 0; i < m_currentRegexItems.size(); ++i) {
+        itemIndex.insert(m_currentRegexItems[i].name, i);
+    }
     
-    // 为每个DFA生成最小化DFA
     for (auto it = m_dfaMap.constBegin(); it != m_dfaMap.constEnd(); ++it) {
         const QString &regexName = it.key();
-        const DFA &dfa = it.value();
+        int index = itemIndex.value(regexName, -1);
+        
+        // 模式在生成DFA之后又被修改时，缓存项没有对应的DFA，只做最小化不写入缓存
+        AutomatonCacheEntry *entry = nullptr;
+        if (index >= 0) {
+            entry = &cacheEntry(m_currentRegexItems[index], index);
+            if (!entry->hasDFA) {
+                entry = nullptr;
+            }
+        }
         
-        DFA minimizedDFA = m_dfaMinimizer.minimizeDFA(dfa);
+        if (entry && entry->hasMinimizedDFA) {
+            m_minimizedDfaMap[regexName] = entry->minimizedDFA;
+            generatedCount++;
+            continue;
+        }
+        
+        DFA minimizedDFA = m_dfaMinimizer.minimizeDFA(it.value());
         if (!minimizedDFA.states.isEmpty()) {
+            if (entry) {
+                entry->minimizedDFA = minimizedDFA;
+                entry->hasMinimizedDFA = true;
+            }
             m_minimizedDfaMap[regexName] = minimizedDFA;
+            generatedCount++;
         }
     }
     
     // 生成总最小化DFA
-    if (!m_totalDFA.states.isEmpty()) {
+    if (m_totalDFA.states.isEmpty()) {
+        m_totalMinimizedDFA = DFA();
+        m_totalMinimizedDFAKey.clear();
+    } else if (m_totalDFAKey.isEmpty() || m_totalMinimizedDFAKey != m_totalDFAKey) {
         m_totalMinimizedDFA = m_dfaMinimizer.minimizeDFA(m_totalDFA);
+        m_totalMinimizedDFAKey = m_totalDFAKey;
+    }
+    
+    return generatedCount;
+}
+
+// 最小化DFA模块
+/**
+ * @brief 最小化DFA按钮点击事件
+ * 
+ * 为每个DFA生成最小化DFA，生成总最小化DFA，并更新显示
+ */
+void Task1Window::on_btnMinimizeDFA_clicked()
+{
+    // 检查是否已生成DFA
+    if (m_dfaMap.isEmpty()) {
+        QMessageBox::warning(this, tr("警告"), tr("请先生成DFA"));
+        return;
     }
     
+    // 为每个DFA及总DFA生成最小化DFA
+    buildMinimizedDFAs();
+    
     // 更新最小化DFA显示
     updateMinimizedDFADisplay();
     
@@ -450,7 +629,7 @@ void Task1Window::on_btnGenerateLexer_clicked()
     }
     
     // 默认使用表驱动方法
-    GenerationMethod method = GenerationMethod::STATE_TRANSITION;
+    GenerationMethod method = GenerationMethod::TABLE_DRIVEN;
     
     // 生成词法分析器代码
     QString lexerCode;
@@ -475,6 +654,16 @@ void Task1Window::on_btnGenerateLexer_clicked()
         } else {
             qDebug() << "警告：无法保存Token映射文件";
         }
+        
+        // 同时保存编译后的二进制词法分析器，规格未变化时工具可直接映射加载，跳过正则解析与DFA构建
+        QString compiledFileName = "sample.lexbin";
+        const DFA &compiledDFA = m_isTotalView ? m_totalMinimizedDFA : m_minimizedDfaMap[m_currentRegexName];
+        if (m_lexerGenerator.saveCompiledLexer(m_currentRegexItems, compiledDFA,
+                                               CompiledLexer::hashSpec(m_currentRegexText), compiledFileName)) {
+            qDebug() << "编译后的词法分析器已保存：" << compiledFileName;
+        } else {
+            qDebug() << "警告：无法保存编译后的词法分析器：" << m_lexerGenerator.getErrorMessage();
+        }
     }
 }
 
@@ -658,6 +847,9 @@ QMap<QString, QString> Task1Window::processRegexReferences(const QList<RegexItem
             if (!name.startsWith('_')) {
                 // 处理字符集格式，如 [a-z] 或 [0-9] 或 [!@#$%^&*()]
                 if (pattern.startsWith('[') && pattern.endsWith(']')) {
+                    // 整个字符集作为一条字符类转换时，按其文本映射到引用名称
+                    charToRefMap[pattern] = name;
+                    
                     // 提取字符集内容
                     QString charset = pattern.mid(1, pattern.length() - 2);
                     
@@ -741,7 +933,7 @@ void Task1Window::displayNFA(const NFA &nfa, QTableWidget *table)
     // 收集所有转移名称（输入字符）
     QSet<QString> transitions;
     for (const NFATransition &transition : nfa.transitions) {
-        transitions.insert(transition.input);
+        transitions.insert(SymbolTable::text(transition.input));
     }
     
     // 检查当前处理的正则表达式是否为keyword（不区分大小写）
@@ -855,7 +1047,7 @@ void Task1Window::displayNFA(const NFA &nfa, QTableWidget *table)
             // 收集所有匹配字符的转移
             for (const QString &charStr : chars) {
                 for (const NFATransition &t : nfa.transitions) {
-                    if (t.fromState == state && t.input == charStr) {
+                    if (t.fromState == state && SymbolTable::text(t.input) == charStr) {
                         uniqueTargetStates.insert(t.toState);
                     }
                 }
@@ -887,7 +1079,7 @@ void Task1Window::displayDFA(const DFA &dfa, QTableWidget *table)
     // 收集所有转移名称（输入字符）
     QSet<QString> transitions;
     for (const DFATransition &transition : dfa.transitions) {
-        transitions.insert(transition.input);
+        transitions.insert(SymbolTable::text(transition.input));
     }
     
     // 检查当前处理的正则表达式是否为keyword（不区分大小写）
@@ -964,14 +1156,6 @@ void Task1Window::displayDFA(const DFA &dfa, QTableWidget *table)
     table->setColumnCount(headers.size());
     table->setHorizontalHeaderLabels(headers);
     
-    // 创建DFA状态到NFA状态集合的反向映射
-    QMap<DFAState, QList<NFAState>> dfaToNfaStatesMap;
-    for (auto it = dfa.stateMap.constBegin(); it != dfa.stateMap.constEnd(); ++it) {
-        const QList<NFAState> &nfaStates = it.key();
-        DFAState dfaState = it.value();
-        dfaToNfaStatesMap[dfaState] = nfaStates;
-    }
-    
     // 收集所有状态并排序
     QList<DFAState> allStates = dfa.states;
     std::sort(allStates.begin(), allStates.end());
@@ -1009,7 +1193,7 @@ void Task1Window::displayDFA(const DFA &dfa, QTableWidget *table)
             // 查找匹配字符的转移，DFA每个状态和转移只有一个目标状态
             for (const QString &charStr : chars) {
                 for (const DFATransition &t : dfa.transitions) {
-                    if (t.fromState == state && t.input == charStr) {
+                    if (t.fromState == state && SymbolTable::text(t.input) == charStr) {
                         targetState = QString::number(t.toState);
                         break;
                     }
@@ -1023,6 +1207,16 @@ void Task1Window::displayDFA(const DFA &dfa, QTableWidget *table)
         }
         
         addTableRow(table, rowData);
+        
+        // 状态编号的提示中显示该DFA状态对应的NFA状态集合
+        QList<NFAState> nfaStates = DFABuilder::provenanceOf(dfa, state);
+        if (!nfaStates.isEmpty()) {
+            QStringList nfaStateTexts;
+            for (NFAState nfaState : nfaStates) {
+                nfaStateTexts << QString::number(nfaState);
+            }
+            table->item(table->rowCount() - 1, 1)->setToolTip(QString("NFA状态集合: {%1}").arg(nfaStateTexts.join(", ")));
+        }
     }
     
     // 调整列宽
@@ -1036,7 +1230,7 @@ void Task1Window::displayMinimizedDFA(const DFA &dfa, QTableWidget *table)
     // 收集所有转移名称（输入字符）
     QSet<QString> transitions;
     for (const DFATransition &transition : dfa.transitions) {
-        transitions.insert(transition.input);
+        transitions.insert(SymbolTable::text(transition.input));
     }
     
     // 检查当前处理的正则表达式是否为keyword（不区分大小写）
@@ -1150,7 +1344,7 @@ void Task1Window::displayMinimizedDFA(const DFA &dfa, QTableWidget *table)
             // 查找匹配字符的转移
             for (const QString &charStr : chars) {
                 for (const DFATransition &t : dfa.transitions) {
-                    if (t.fromState == state && t.input == charStr) {
+                    if (t.fromState == state && SymbolTable::text(t.input) == charStr) {
                         targetState = QString::number(t.toState);
                         break;
                     }
@@ -1379,6 +1573,10 @@ void Task1Window::updateDFADisplay()
         // 显示总DFA
         if (m_totalDFA.states.size() > 0) {
             try {
+                // 状态来源只在表格显示时计算一次，重新构建后清空
+                if (m_totalDFA.provenanceOffsets.isEmpty()) {
+                    m_dfaBuilder.computeProvenance(m_totalNFA, m_totalDFA);
+                }
                 displayDFA(m_totalDFA, m_dynamicTableDFA);
                 ui->groupBoxDFA->setTitle("总DFA图表");
             } catch (const std::exception &e) {
@@ -1391,8 +1589,11 @@ void Task1Window::updateDFADisplay()
     } else {
         // 显示单个DFA
         if (!m_currentRegexName.isEmpty() && m_dfaMap.contains(m_currentRegexName)) {
-            const DFA &dfa = m_dfaMap[m_currentRegexName];
+            DFA &dfa = m_dfaMap[m_currentRegexName];
             try {
+                if (dfa.provenanceOffsets.isEmpty() && m_nfaMap.contains(m_currentRegexName)) {
+                    m_dfaBuilder.computeProvenance(m_nfaMap[m_currentRegexName], dfa);
+                }
                 displayDFA(dfa, m_dynamicTableDFA);
                 ui->groupBoxDFA->setTitle(QString("单个正则表达式DFA图表 - %1").arg(m_currentRegexName));
             } catch (const std::exception &e) {
@@ -1616,35 +1817,19 @@ void Task1Window::on_btnRefreshNFA_clicked()
     
     QList<RegexItem> regexItems = m_regexProcessor.getRegexItems();
     m_currentRegexItems = regexItems;
+    m_currentRegexText = regexText;
     if (regexItems.isEmpty()) {
         QMessageBox::warning(this, tr("警告"), tr("没有找到有效的正则表达式"));
         ui->statusbar->showMessage(tr("刷新失败：未找到有效正则表达式"), 3000);
         return;
     }
     
-    // 清空之前的NFA映射
-    ui->statusbar->showMessage(tr("正在清空NFA数据..."), 0);
-    m_nfaMap.clear();
-    m_totalNFA = NFA();
-    
-    // 为每个以下划线开头的正则表达式构建NFA
+    // 为每个以下划线开头的正则表达式构建NFA并生成总NFA，模式未变化的直接复用缓存
     ui->statusbar->showMessage(tr("正在构建NFA..."), 0);
-    int generatedCount = 0;
-    for (int i = 0; i < regexItems.size(); i++) {
-        const RegexItem &item = regexItems[i];
-        // 仅为下划线开头的正则表达式生成NFA
-        if (item.name.startsWith('_')) {
-            NFA nfa = m_nfaBuilder.buildNFA(item);
-            if (!nfa.states.isEmpty()) {
-                // 设置接受状态的正则表达式索引
-                for (const NFAState &state : nfa.acceptStates) {
-                    nfa.acceptStateToRegexIndex[state] = i;
-                }
-                m_nfaMap[item.name] = nfa;
-                generatedCount++;
-            }
-        }
-    }
+    QElapsedTimer timer;
+    timer.start();
+    int generatedCount = buildNFAs();
+    qint64 elapsedMs = timer.elapsed();
     
     if (generatedCount == 0) {
         QMessageBox::warning(this, tr("错误"), tr("NFA构建失败: %1").arg(m_nfaBuilder.getErrorMessage()));
@@ -1652,12 +1837,6 @@ void Task1Window::on_btnRefreshNFA_clicked()
         return;
     }
     
-    // 生成总NFA
-    ui->statusbar->showMessage(tr("正在生成总NFA..."), 0);
-    if (generatedCount > 0) {
-        m_totalNFA = mergeNFAs(m_nfaMap.values());
-    }
-    
     // 更新正则表达式下拉列表（不改变当前选择）
     ui->statusbar->showMessage(tr("正在更新下拉列表..."), 0);
     updateRegexComboBoxWithoutChangingSelection(currentRegexName, currentIsTotalView);
@@ -1674,7 +1853,7 @@ void Task1Window::on_btnRefreshNFA_clicked()
     ui->groupBoxNFA->update();
     
     // 显示加载完成状态
-    ui->statusbar->showMessage(tr("NFA图表刷新完成，共生成 %1 个NFA").arg(generatedCount), 5000);
+    ui->statusbar->showMessage(tr("NFA图表刷新完成，共生成 %1 个NFA，耗时 %2 ms").arg(generatedCount).arg(elapsedMs), 5000);
 }
 
 // 手动刷新DFA图表
@@ -1698,30 +1877,10 @@ void Task1Window::on_btnRefreshDFA_clicked()
         return;
     }
     
-    // 清空之前的DFA映射
-    ui->statusbar->showMessage(tr("正在清空DFA数据..."), 0);
-    m_dfaMap.clear();
-    m_totalDFA = DFA();
-    
-    // 为每个NFA生成DFA
-    ui->statusbar->showMessage(tr("正在转换NFA到DFA..."), 0);
-    int generatedCount = 0;
-    for (auto it = m_nfaMap.constBegin(); it != m_nfaMap.constEnd(); ++it) {
-        const QString &regexName = it.key();
-        const NFA &nfa = it.value();
-        
-        DFA dfa = m_dfaBuilder.convertNFAToDFA(nfa);
-        if (!dfa.states.isEmpty()) {
-            m_dfaMap[regexName] = dfa;
-            generatedCount++;
-        }
-    }
-    
-    // 生成总DFA
-    ui->statusbar->showMessage(tr("正在生成总DFA..."), 0);
-    if (!m_totalNFA.states.isEmpty()) {
-        m_totalDFA = m_dfaBuilder.convertNFAToDFA(m_totalNFA);
-    }
+    // 生成各正则表达式的DFA与总DFA，模式未变化的直接复用缓存
+    ui->statusbar->showMessage(tr("正在生成DFA..."), 0);
+    qint64 elapsedMs = 0;
+    int generatedCount = buildDFAs(elapsedMs);
     
     // 更新正则表达式下拉列表（不改变当前选择）
     ui->statusbar->showMessage(tr("正在更新下拉列表..."), 0);
@@ -1739,7 +1898,7 @@ void Task1Window::on_btnRefreshDFA_clicked()
     ui->groupBoxDFA->update();
     
     // 显示加载完成状态
-    ui->statusbar->showMessage(tr("DFA图表刷新完成，共生成 %1 个DFA").arg(generatedCount), 5000);
+    ui->statusbar->showMessage(tr("DFA图表刷新完成，共生成 %1 个DFA，耗时 %2 ms").arg(generatedCount).arg(elapsedMs), 5000);
 }
 
 // 手动刷新最小化DFA图表
@@ -1763,30 +1922,12 @@ void Task1Window::on_btnRefreshMinDFA_clicked()
         return;
     }
     
-    // 清空之前的最小化DFA映射
-    ui->statusbar->showMessage(tr("正在清空最小化DFA数据..."), 0);
-    m_minimizedDfaMap.clear();
-    m_totalMinimizedDFA = DFA();
-    
-    // 为每个DFA生成最小化DFA
+    // 为每个DFA及总DFA生成最小化DFA，对应DFA未变化的直接复用缓存
     ui->statusbar->showMessage(tr("正在最小化DFA..."), 0);
-    int generatedCount = 0;
-    for (auto it = m_dfaMap.constBegin(); it != m_dfaMap.constEnd(); ++it) {
-        const QString &regexName = it.key();
-        const DFA &dfa = it.value();
-        
-        DFA minimizedDFA = m_dfaMinimizer.minimizeDFA(dfa);
-        if (!minimizedDFA.states.isEmpty()) {
-            m_minimizedDfaMap[regexName] = minimizedDFA;
-            generatedCount++;
-        }
-    }
-    
-    // 生成总最小化DFA
-    ui->statusbar->showMessage(tr("正在生成总最小化DFA..."), 0);
-    if (!m_totalDFA.states.isEmpty()) {
-        m_totalMinimizedDFA = m_dfaMinimizer.minimizeDFA(m_totalDFA);
-    }
+    QElapsedTimer timer;
+    timer.start();
+    int generatedCount = buildMinimizedDFAs();
+    qint64 elapsedMs = timer.elapsed();
     
     // 更新正则表达式下拉列表（不改变当前选择）
     ui->statusbar->showMessage(tr("正在更新下拉列表..."), 0);
@@ -1804,7 +1945,7 @@ void Task1Window::on_btnRefreshMinDFA_clicked()
     ui->groupBoxMinDFA->update();
     
     // 显示加载完成状态
-    ui->statusbar->showMessage(tr("最小化DFA图表刷新完成，共生成 %1 个最小化DFA").arg(generatedCount), 5000);
+    ui->statusbar->showMessage(tr("最小化DFA图表刷新完成，共生成 %1 个最小化DFA，耗时 %2 ms").arg(generatedCount).arg(elapsedMs), 5000);
 }
 
 // 创建动态表格
@@ -6,6 +6,7 @@
 #include <QTextStream>
 #include <QRegularExpression>
 #include "task1/lexergenerator.h"
+#include "task1/symboltable.h"
 #include "task1/dfabuilder.h"
 #include "task1/nfabuilder.h"
 #include "task1/dfaminimizer.h"
@@ -143,7 +144,7 @@ int main(int argc, char *argv[])
     // 数字转移
     for (char c = '0'; c <= '9'; c++) {
         t1.fromState = 5;
-        t1.input = QString(c);
+        t1.input = SymbolTable::intern(QString(c));
         t1.toState = 1;
         dfa.transitions.append(t1);
     }
@@ -151,13 +152,13 @@ int main(int argc, char *argv[])
     // 字母转移
     for (char c = 'a'; c <= 'z'; c++) {
         t2.fromState = 5;
-        t2.input = QString(c);
+        t2.input = SymbolTable::intern(QString(c));
         t2.toState = 0;
         dfa.transitions.append(t2);
     }
     for (char c = 'A'; c <= 'Z'; c++) {
         t3.fromState = 5;
-        t3.input = QString(c);
+        t3.input = SymbolTable::intern(QString(c));
         t3.toState = 0;
         dfa.transitions.append(t3);
     }
@@ -166,39 +167,39 @@ int main(int argc, char *argv[])
     QStringList specialChars = {"+", "-", "*", "/", "%", "^", "<", ">", "=", ";"};
     for (const QString &ch : specialChars) {
         t4.fromState = 5;
-        t4.input = ch;
+        t4.input = SymbolTable::intern(ch);
         t4.toState = 4;
         dfa.transitions.append(t4);
     }
     
     // 冒号转移
     t5.fromState = 5;
-    t5.input = ":";
+    t5.input = SymbolTable::intern(":");
     t5.toState = 7;
     dfa.transitions.append(t5);
     
     // 左花括号转移
     t6.fromState = 5;
-    t6.input = "{";
+    t6.input = SymbolTable::intern("{");
     t6.toState = 6;
     dfa.transitions.append(t6);
     
     // 状态0（identifier）的转移
     for (char c = 'a'; c <= 'z'; c++) {
         t7.fromState = 0;
-        t7.input = QString(c);
+        t7.input = SymbolTable::intern(QString(c));
         t7.toState = 0;
         dfa.transitions.append(t7);
     }
     for (char c = 'A'; c <= 'Z'; c++) {
         t8.fromState = 0;
-        t8.input = QString(c);
+        t8.input = SymbolTable::intern(QString(c));
         t8.toState = 0;
         dfa.transitions.append(t8);
     }
     for (char c = '0'; c <= '9'; c++) {
         t9.fromState = 0;
-        t9.input = QString(c);
+        t9.input = SymbolTable::intern(QString(c));
         t9.toState = 0;
         dfa.transitions.append(t9);
     }
@@ -206,70 +207,70 @@ int main(int argc, char *argv[])
     // 状态1（number）的转移
     for (char c = '0'; c <= '9'; c++) {
         t10.fromState = 1;
-        t10.input = QString(c);
+        t10.input = SymbolTable::intern(QString(c));
         t10.toState = 1;
         dfa.transitions.append(t10);
     }
     
     // 状态2（<）的转移
     t11.fromState = 2;
-    t11.input = "=";
+    t11.input = SymbolTable::intern("=");
     t11.toState = 4;
     dfa.transitions.append(t11);
     t12.fromState = 2;
-    t12.input = ">";
+    t12.input = SymbolTable::intern(">");
     t12.toState = 4;
     dfa.transitions.append(t12);
     
     // 状态3（>）的转移
     t13.fromState = 3;
-    t13.input = "=";
+    t13.input = SymbolTable::intern("=");
     t13.toState = 4;
     dfa.transitions.append(t13);
     
     // 状态6（comment）的转移
     for (char c = 'a'; c <= 'z'; c++) {
         t14.fromState = 6;
-        t14.input = QString(c);
+        t14.input = SymbolTable::intern(QString(c));
         t14.toState = 6;
         dfa.transitions.append(t14);
     }
     for (char c = 'A'; c <= 'Z'; c++) {
         t15.fromState = 6;
-        t15.input = QString(c);
+        t15.input = SymbolTable::intern(QString(c));
         t15.toState = 6;
         dfa.transitions.append(t15);
     }
     for (char c = '0'; c <= '9'; c++) {
         t16.fromState = 6;
-        t16.input = QString(c);
+        t16.input = SymbolTable::intern(QString(c));
         t16.toState = 6;
         dfa.transitions.append(t16);
     }
     for (const QString &ch : specialChars) {
         t17.fromState = 6;
-        t17.input = ch;
+        t17.input = SymbolTable::intern(ch);
         t17.toState = 6;
         dfa.transitions.append(t17);
     }
     t18.fromState = 6;
-    t18.input = ":";
+    t18.input = SymbolTable::intern(":");
     t18.toState = 8;
     dfa.transitions.append(t18);
     t19.fromState = 6;
-    t19.input = "}";
+    t19.input = SymbolTable::intern("}");
     t19.toState = 4;
     dfa.transitions.append(t19);
     
     // 状态7（:）的转移
     t20.fromState = 7;
-    t20.input = "=";
+    t20.input = SymbolTable::intern("=");
     t20.toState = 4;
     dfa.transitions.append(t20);
     
     // 状态8（:=）的转移
     t21.fromState = 8;
-    t21.input = "=";
+    t21.input = SymbolTable::intern("=");
     t21.toState = 6;
     dfa.transitions.append(t21);
     
@@ -0,0 +1,134 @@
+#include <QCoreApplication>
+#include <QList>
+#include <QDebug>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <cstring>
+#include "task1/symboltable.h"
+#include "task1/lexergenerator.h"
+#include "task1/compiledlexer.h"
+#include "test_pipeline.h"
+
+static const char *LEXBIN_PATH = "test_compiled_lexer.lexbin";
+static const char *BAD_VERSION_PATH = "test_compiled_lexer_version.lexbin";
+static const char *TRUNCATED_PATH = "test_compiled_lexer_truncated.lexbin";
+
+// 按DFA的转移求状态state在字节c上的后继，没有转移时为DEAD_STATE
+int expectedNextState(const DFA &dfa, int state, uchar c)
+{
+    for (const DFATransition &transition : dfa.transitions) {
+        if (transition.fromState == state && SymbolTable::matches(transition.input, c)) {
+            return transition.toState;
+        }
+    }
+    return CompiledLexer::DEAD_STATE;
+}
+
+bool writeFile(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int failures = 0;
+
+    const QString spec = miniCSpec();
+    QList<RegexItem> items;
+    if (!parseSpec(spec, items)) {
+        return 1;
+    }
+    DFA minimizedDFA = buildMinimizedSpecDFA(items);
+    if (minimizedDFA.states.isEmpty()) {
+        qDebug() << "失败：无法构建mini-c的最小化DFA";
+        return 1;
+    }
+
+    // 保存后经内存映射加载
+    const quint64 specHash = CompiledLexer::hashSpec(spec);
+    LexerGenerator generator;
+    if (!generator.saveCompiledLexer(items, minimizedDFA, specHash, LEXBIN_PATH)) {
+        qDebug() << "失败：保存编译后的词法分析器失败：" << generator.getErrorMessage();
+        return 1;
+    }
+
+    CompiledLexer lexer;
+    if (!lexer.load(LEXBIN_PATH)) {
+        qDebug() << "失败：加载编译后的词法分析器失败：" << lexer.getErrorMessage();
+        QFile::remove(LEXBIN_PATH);
+        return 1;
+    }
+    if (!lexer.verify()) {
+        qDebug() << "失败：压缩转移表校验失败：" << lexer.getErrorMessage();
+        failures++;
+    }
+    if (lexer.specHash() != specHash || lexer.stateCount() != minimizedDFA.states.size()
+        || lexer.startState() != minimizedDFA.startState) {
+        qDebug() << "失败：文件头与DFA不一致";
+        failures++;
+    }
+
+    // 每个(状态, 字节)的后继与每个状态的接受编码都应与DFA一致
+    QVector<bool> isAccept;
+    QVector<int> tokens;
+    LexerGenerator::computeAcceptTokens(items, minimizedDFA, isAccept, tokens);
+    int mismatches = 0;
+    for (int state = 0; state < minimizedDFA.states.size(); ++state) {
+        for (int c = 0; c < 256; ++c) {
+            if (lexer.nextState(state, static_cast<uchar>(c)) != expectedNextState(minimizedDFA, state, c)) {
+                mismatches++;
+            }
+        }
+        const int expectedToken = isAccept[state] ? tokens[state] : CompiledLexer::NOT_ACCEPT;
+        if (lexer.isAccept(state) != isAccept[state] || lexer.acceptToken(state) != expectedToken) {
+            mismatches++;
+        }
+    }
+    if (mismatches > 0) {
+        qDebug() << "失败：" << mismatches << "处转移或接受编码与DFA不一致";
+        failures++;
+    }
+    lexer.unload();
+
+    QFile original(LEXBIN_PATH);
+    original.open(QIODevice::ReadOnly);
+    const QByteArray data = original.readAll();
+    original.close();
+
+    // 版本号不同的文件应被拒绝
+    QByteArray badVersion = data;
+    const quint32 version = CompiledLexer::FORMAT_VERSION + 1;
+    std::memcpy(badVersion.data() + offsetof(CompiledLexerHeader, version), &version, sizeof(version));
+    if (!writeFile(BAD_VERSION_PATH, badVersion) || lexer.load(BAD_VERSION_PATH)) {
+        qDebug() << "失败：版本号不同的文件未被拒绝";
+        failures++;
+    } else {
+        qDebug() << "版本号不同：" << lexer.getErrorMessage();
+    }
+
+    // 截断的文件（缺少接受表末尾，或连文件头都不完整）应被拒绝
+    for (int length : {data.size() - 4, static_cast<int>(sizeof(CompiledLexerHeader)) / 2}) {
+        if (!writeFile(TRUNCATED_PATH, data.left(length)) || lexer.load(TRUNCATED_PATH)) {
+            qDebug() << "失败：截断为" << length << "字节的文件未被拒绝";
+            failures++;
+        } else {
+            qDebug() << "截断为" << length << "字节：" << lexer.getErrorMessage();
+        }
+    }
+
+    QFile::remove(LEXBIN_PATH);
+    QFile::remove(BAD_VERSION_PATH);
+    QFile::remove(TRUNCATED_PATH);
+
+    if (failures == 0) {
+        qDebug() << "全部通过";
+    }
+    return failures == 0 ? 0 : 1;
+}
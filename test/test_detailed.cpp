@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 #include "task1/lexergenerator.h"
+#include "task1/symboltable.h"
 #include "task1/dfabuilder.h"
 #include "task1/regexprocessor.h"
 #include <fstream>
@@ -57,25 +58,25 @@ int main() {
     // 简单的状态转移，用于测试生成逻辑
     DFATransition t1;
     t1.fromState = 0;
-    t1.input = "i";
+    t1.input = SymbolTable::intern("i");
     t1.toState = 1;
     dfa.transitions.append(t1);
     
     DFATransition t2;
     t2.fromState = 0;
-    t2.input = "w";
+    t2.input = SymbolTable::intern("w");
     t2.toState = 1;
     dfa.transitions.append(t2);
     
     DFATransition t3;
     t3.fromState = 0;
-    t3.input = "f";
+    t3.input = SymbolTable::intern("f");
     t3.toState = 1;
     dfa.transitions.append(t3);
     
     DFATransition t4;
     t4.fromState = 0;
-    t4.input = "r";
+    t4.input = SymbolTable::intern("r");
     t4.toState = 1;
     dfa.transitions.append(t4);
     
@@ -83,7 +84,7 @@ int main() {
     for (char c = '0'; c <= '9'; c++) {
         DFATransition t;
         t.fromState = 0;
-        t.input = QString(c);
+        t.input = SymbolTable::intern(QString(c));
         t.toState = 2;
         dfa.transitions.append(t);
     }
@@ -93,7 +94,7 @@ int main() {
         if (c != 'i' && c != 'w' && c != 'f' && c != 'r') {
             DFATransition t;
             t.fromState = 0;
-            t.input = QString(c);
+            t.input = SymbolTable::intern(QString(c));
             t.toState = 3;
             dfa.transitions.append(t);
         }
@@ -104,7 +105,7 @@ int main() {
     for (const QString& op : operators) {
         DFATransition t;
         t.fromState = 0;
-        t.input = op;
+        t.input = SymbolTable::intern(op);
         t.toState = 1;
         dfa.transitions.append(t);
     }
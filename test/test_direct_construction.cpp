@@ -0,0 +1,115 @@
+#include <QCoreApplication>
+#include <QList>
+#include <QDebug>
+#include <QString>
+#include <QVector>
+#include "task1/dfatablepacker.h"
+#include "task1/lexergenerator.h"
+#include "test_pipeline.h"
+
+// 用到'?'、'+'与嵌套'*'的定义，各项之间有重叠，最小化后接受状态仍须按token区分
+static const char *SPECS[][2] = {
+    {"可选与正闭包",
+     "letter=[a-z]\n"
+     "digit=[0-9]\n"
+     "_word100=letter+(_letter+)?\n"
+     "_number101=digit+(.digit+)?(e-?digit+)?\n"
+     "_mixed102=(a|b)+c?d?\n"
+     "_Keyword200S=ab|abc|abcd|do|done\n"},
+    {"嵌套闭包",
+     "_nest100=((ab*)*c)*d\n"
+     "_deep101=(x(y(z)*)*)*w\n"
+     "_runs102=(a*b*)*e\n"
+     "_plus103=((p+q?)+r)+\n"},
+};
+
+// 规范编号后的DFA：状态按从起始状态出发、按字节顺序的广度优先次序编号
+typedef struct {
+    QVector<int> next;    // 状态i在字节c上的后继为next[i * 256 + c]，-1表示没有转移
+    QVector<int> tokens;  // 每个状态的token编码，非接受状态为-2
+} CanonicalDFA;
+
+bool canonicalize(const QList<RegexItem> &items, const DFA &minimizedDFA, CanonicalDFA &canonical)
+{
+    DFATablePacker packer;
+    DenseDFATable dense;
+    if (!packer.buildDenseTable(minimizedDFA, dense)) {
+        qDebug() << "展开转移表失败：" << packer.getErrorMessage();
+        return false;
+    }
+    QVector<bool> isAccept;
+    QVector<int> tokens;
+    LexerGenerator::computeAcceptTokens(items, minimizedDFA, isAccept, tokens);
+
+    QVector<int> order(dense.stateCount, -1);
+    QList<int> queue = {dense.startState};
+    order[dense.startState] = 0;
+    canonical.next.clear();
+    canonical.tokens.clear();
+    for (int head = 0; head < queue.size(); head++) {
+        const int state = queue[head];
+        canonical.tokens.append(isAccept[state] ? tokens[state] : -2);
+        for (int c = 0; c < 256; c++) {
+            const int target = dense.transitions[state * dense.classCount + dense.byteClasses[c]];
+            if (target != -1 && order[target] == -1) {
+                order[target] = queue.size();
+                queue.append(target);
+            }
+            canonical.next.append(target == -1 ? -1 : order[target]);
+        }
+    }
+    return true;
+}
+
+// 比较直接构造与子集构造的最小化DFA，返回失败次数
+int compareConstructions(const QString &name, const QString &spec)
+{
+    QList<RegexItem> items;
+    if (!parseSpec(spec, items)) {
+        return 1;
+    }
+
+    const DFA subsetDFA = buildMinimizedSpecDFA(items, false);
+    const DFA directDFA = buildMinimizedSpecDFA(items, true);
+    qDebug() << name << "子集构造：" << subsetDFA.states.size() << "个状态，直接构造："
+             << directDFA.states.size() << "个状态";
+    if (subsetDFA.states.size() != directDFA.states.size()) {
+        qDebug() << "失败：" << name << "最小化后的状态数不同";
+        return 1;
+    }
+
+    CanonicalDFA subset;
+    CanonicalDFA direct;
+    if (!canonicalize(items, subsetDFA, subset) || !canonicalize(items, directDFA, direct)) {
+        return 1;
+    }
+    if (subset.tokens.size() != subsetDFA.states.size() || direct.tokens.size() != directDFA.states.size()) {
+        qDebug() << "失败：" << name << "最小化DFA中有不可达状态";
+        return 1;
+    }
+    if (subset.next != direct.next) {
+        qDebug() << "失败：" << name << "规范编号后的转移不同";
+        return 1;
+    }
+    if (subset.tokens != direct.tokens) {
+        qDebug() << "失败：" << name << "规范编号后的接受编码不同";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int failures = 0;
+    failures += compareConstructions("mini-c", miniCSpec());
+    for (const auto &spec : SPECS) {
+        failures += compareConstructions(spec[0], spec[1]);
+    }
+
+    if (failures == 0) {
+        qDebug() << "全部通过";
+    }
+    return failures == 0 ? 0 : 1;
+}
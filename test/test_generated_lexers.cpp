@@ -0,0 +1,156 @@
+#include <QCoreApplication>
+#include <QList>
+#include <QDebug>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QFile>
+#include <cstdlib>
+#include "task1/lexergenerator.h"
+#include "test_pipeline.h"
+
+static const char *INPUT_PATH = "test_generated_lexers_input.txt";
+
+// 生成方法及其名称
+typedef struct {
+    const char *name;
+    GenerationMethod method;
+    bool selfLoopRuns;   // 生成的代码是否含自环加速（直接匹配法没有）
+} Method;
+
+static const Method METHODS[] = {
+    {"direct_match", GenerationMethod::DIRECT_MATCH, false},
+    {"state_transition", GenerationMethod::STATE_TRANSITION, true},
+    {"table_driven", GenerationMethod::TABLE_DRIVEN, true},
+    {"direct_coded", GenerationMethod::DIRECT_CODED, true},
+};
+
+// 自环加速的指令集：默认编译选项（x86-64上为SSE2）、AVX2，以及去掉SIMD宏后的逐字节扫描
+typedef struct {
+    const char *name;
+    const char *flags;
+} SimdVariant;
+
+static const SimdVariant SIMD_VARIANTS[] = {
+    {"default", ""},
+    {"avx2", "-mavx2"},
+    {"scalar", "-U__SSE2__ -U__AVX2__"},
+};
+
+bool writeFile(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+// mini-c示例之后附加长标识符、长数字、长注释与长空白，使自环加速跨过多个16/32字节的块
+QByteArray buildInput()
+{
+    QByteArray input = readTestFile("mini-c/minic_sample.txt").toUtf8();
+    for (int n = 1; n <= 80; n++) {
+        input += "int " + QByteArray(n, 'v') + "_" + QByteArray::number(n) + " = " + QByteArray(n, '7') + ".5;";
+        input += QByteArray(n % 40, ' ') + "//" + QByteArray(n * 3, 'c') + "\n";
+        input += QByteArray(n, '\t') + "if(x>=" + QByteArray(n, '1') + ")x++;" + QByteArray(n, '\n');
+    }
+    return input;
+}
+
+// 编译生成的词法分析器并在输入上运行，返回输出的单词流，失败时返回空
+QByteArray compileAndRun(const QString &code, const QString &name, const char *flags)
+{
+    const QString sourcePath = QString("test_generated_lexer_%1.cpp").arg(name);
+    const QString binaryPath = QString("test_generated_lexer_%1").arg(name);
+    const QString outputPath = QString("test_generated_lexer_%1.out").arg(name);
+    if (!writeFile(sourcePath, code.toUtf8())) {
+        qDebug() << "失败：无法写入" << sourcePath;
+        return QByteArray();
+    }
+
+    const QString compile = QString("g++ -std=c++17 -O2 %1 -o %2 %3 -lpthread").arg(flags).arg(binaryPath).arg(sourcePath);
+    QByteArray output;
+    if (system(qPrintable(compile)) != 0) {
+        qDebug() << "失败：编译失败：" << compile;
+    } else if (system(qPrintable(QString("./%1 %2 > %3").arg(binaryPath).arg(INPUT_PATH).arg(outputPath))) != 0) {
+        qDebug() << "失败：运行失败：" << binaryPath;
+    } else {
+        output = readFile(outputPath);
+    }
+
+    QFile::remove(sourcePath);
+    QFile::remove(binaryPath);
+    QFile::remove(outputPath);
+    return output;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QList<RegexItem> items;
+    if (!parseSpec(miniCSpec(), items)) {
+        return 1;
+    }
+    DFA minimizedDFA = buildMinimizedSpecDFA(items);
+    if (minimizedDFA.states.isEmpty() || !writeFile(INPUT_PATH, buildInput())) {
+        qDebug() << "失败：无法构建mini-c的最小化DFA或写入输入文件";
+        return 1;
+    }
+
+    // 各生成方法、各指令集的单词流都应与第一个（直接匹配法）完全相同
+    int failures = 0;
+    QByteArray expected;
+    LexerGenerator generator;
+    for (const Method &method : METHODS) {
+        const QString code = generator.generateLexer(items, minimizedDFA, method.method);
+        if (code.isEmpty()) {
+            qDebug() << "失败：" << method.name << "生成失败：" << generator.getErrorMessage();
+            failures++;
+            continue;
+        }
+
+        for (const SimdVariant &variant : SIMD_VARIANTS) {
+            if (!method.selfLoopRuns && variant.flags[0] != '\0') {
+                continue;
+            }
+            if (QString(variant.name) == "avx2" && !__builtin_cpu_supports("avx2")) {
+                qDebug() << "跳过：CPU不支持AVX2";
+                continue;
+            }
+
+            const QString name = QString("%1_%2").arg(method.name).arg(variant.name);
+            const QByteArray output = compileAndRun(code, name, variant.flags);
+            if (output.isEmpty()) {
+                failures++;
+                continue;
+            }
+            if (expected.isEmpty()) {
+                expected = output;
+            }
+            if (output != expected) {
+                qDebug() << "失败：" << name << "的单词流与direct_match不同";
+                failures++;
+            } else {
+                qDebug() << name << "单词数：" << output.count('\n');
+            }
+        }
+    }
+
+    QFile::remove(INPUT_PATH);
+
+    if (failures == 0) {
+        qDebug() << "全部通过";
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -3,6 +3,7 @@
 #include <QFile>
 #include <QTextStream>
 #include "task1/lexergenerator.h"
+#include "task1/symboltable.h"
 #include "task1/dfabuilder.h"
 #include "task1/regexprocessor.h"
 #include "task1/lexertester.h"
@@ -139,10 +140,10 @@ void TestLexerFull::testMultiWordEncoding()
     // 添加状态转移
     // 对于简单的+和-符号
     DFATransition t1, t2, t3, t4;
-    t1.fromState = 0; t1.input = "+"; t1.toState = 1;
-    t2.fromState = 0; t2.input = "-"; t2.toState = 1;
-    t3.fromState = 0; t3.input = "<"; t3.toState = 2;
-    t4.fromState = 2; t4.input = "="; t4.toState = 3;
+    t1.fromState = 0; t1.input = SymbolTable::intern("+"); t1.toState = 1;
+    t2.fromState = 0; t2.input = SymbolTable::intern("-"); t2.toState = 1;
+    t3.fromState = 0; t3.input = SymbolTable::intern("<"); t3.toState = 2;
+    t4.fromState = 2; t4.input = SymbolTable::intern("="); t4.toState = 3;
     
     dfa.transitions << t1 << t2 << t3 << t4;
     
@@ -176,46 +177,46 @@ void TestLexerFull::testIdentifierMatching()
     // 字母转移到状态1（接受态）
     for (char c = 'a'; c <= 'z'; c++) {
         DFATransition t;
-        t.fromState = 0; t.input = QString(c); t.toState = 1;
+        t.fromState = 0; t.input = SymbolTable::intern(QString(c)); t.toState = 1;
         dfa.transitions << t;
     }
     for (char c = 'A'; c <= 'Z'; c++) {
         DFATransition t;
-        t.fromState = 0; t.input = QString(c); t.toState = 1;
+        t.fromState = 0; t.input = SymbolTable::intern(QString(c)); t.toState = 1;
         dfa.transitions << t;
     }
     
     // 字母或数字从状态1转移到状态2（接受态）
     for (char c = 'a'; c <= 'z'; c++) {
         DFATransition t;
-        t.fromState = 1; t.input = QString(c); t.toState = 2;
+        t.fromState = 1; t.input = SymbolTable::intern(QString(c)); t.toState = 2;
         dfa.transitions << t;
     }
     for (char c = 'A'; c <= 'Z'; c++) {
         DFATransition t;
-        t.fromState = 1; t.input = QString(c); t.toState = 2;
+        t.fromState = 1; t.input = SymbolTable::intern(QString(c)); t.toState = 2;
         dfa.transitions << t;
     }
     for (char c = '0'; c <= '9'; c++) {
         DFATransition t;
-        t.fromState = 1; t.input = QString(c); t.toState = 2;
+        t.fromState = 1; t.input = SymbolTable::intern(QString(c)); t.toState = 2;
         dfa.transitions << t;
     }
     
     // 字母或数字从状态2转移到状态2（接受态）
     for (char c = 'a'; c <= 'z'; c++) {
         DFATransition t;
-        t.fromState = 2; t.input = QString(c); t.toState = 2;
+        t.fromState = 2; t.input = SymbolTable::intern(QString(c)); t.toState = 2;
         dfa.transitions << t;
     }
     for (char c = 'A'; c <= 'Z'; c++) {
         DFATransition t;
-        t.fromState = 2; t.input = QString(c); t.toState = 2;
+        t.fromState = 2; t.input = SymbolTable::intern(QString(c)); t.toState = 2;
         dfa.transitions << t;
     }
     for (char c = '0'; c <= '9'; c++) {
         DFATransition t;
-        t.fromState = 2; t.input = QString(c); t.toState = 2;
+        t.fromState = 2; t.input = SymbolTable::intern(QString(c)); t.toState = 2;
         dfa.transitions << t;
     }
     
@@ -251,21 +252,21 @@ void TestLexerFull::testNumberMatching()
     // 数字从状态0转移到状态1（接受态）
     for (char c = '0'; c <= '9'; c++) {
         DFATransition t;
-        t.fromState = 0; t.input = QString(c); t.toState = 1;
+        t.fromState = 0; t.input = SymbolTable::intern(QString(c)); t.toState = 1;
         dfa.transitions << t;
     }
     
     // 数字从状态1转移到状态2（接受态）
     for (char c = '0'; c <= '9'; c++) {
         DFATransition t;
-        t.fromState = 1; t.input = QString(c); t.toState = 2;
+        t.fromState = 1; t.input = SymbolTable::intern(QString(c)); t.toState = 2;
         dfa.transitions << t;
     }
     
     // 数字从状态2转移到状态2（接受态）
     for (char c = '0'; c <= '9'; c++) {
         DFATransition t;
-        t.fromState = 2; t.input = QString(c); t.toState = 2;
+        t.fromState = 2; t.input = SymbolTable::intern(QString(c)); t.toState = 2;
         dfa.transitions << t;
     }
     
@@ -299,9 +300,9 @@ void TestLexerFull::testCommentMatching()
     
     // 添加状态转移
     DFATransition t1, t2, t3;
-    t1.fromState = 0; t1.input = "{"; t1.toState = 1;
-    t2.fromState = 1; t2.input = "a"; t2.toState = 1; // 简化处理，实际应该处理所有字符
-    t3.fromState = 1; t3.input = "}"; t3.toState = 2;
+    t1.fromState = 0; t1.input = SymbolTable::intern("{"); t1.toState = 1;
+    t2.fromState = 1; t2.input = SymbolTable::intern("a"); t2.toState = 1; // 简化处理，实际应该处理所有字符
+    t3.fromState = 1; t3.input = SymbolTable::intern("}"); t3.toState = 2;
     
     dfa.transitions << t1 << t2 << t3;
     
@@ -336,9 +337,9 @@ void TestLexerFull::testSpecialCharacterMatching()
     
     // 添加状态转移
     DFATransition t1, t2, t3;
-    t1.fromState = 0; t1.input = "="; t1.toState = 1;
-    t2.fromState = 0; t2.input = ":"; t2.toState = 2;
-    t3.fromState = 2; t3.input = "="; t3.toState = 1;
+    t1.fromState = 0; t1.input = SymbolTable::intern("="); t1.toState = 1;
+    t2.fromState = 0; t2.input = SymbolTable::intern(":"); t2.toState = 2;
+    t3.fromState = 2; t3.input = SymbolTable::intern("="); t3.toState = 1;
     
     dfa.transitions << t1 << t2 << t3;
     
@@ -374,10 +375,10 @@ void TestLexerFull::testKeywordMatching()
     // 添加状态转移
     // 简化测试，只处理if和end
     DFATransition t1, t2, t3, t4;
-    t1.fromState = 0; t1.input = "i"; t1.toState = 1;
-    t2.fromState = 1; t2.input = "f"; t2.toState = 2;
-    t3.fromState = 0; t3.input = "e"; t3.toState = 3;
-    t4.fromState = 3; t4.input = "n"; t4.toState = 2;
+    t1.fromState = 0; t1.input = SymbolTable::intern("i"); t1.toState = 1;
+    t2.fromState = 1; t2.input = SymbolTable::intern("f"); t2.toState = 2;
+    t3.fromState = 0; t3.input = SymbolTable::intern("e"); t3.toState = 3;
+    t4.fromState = 3; t4.input = SymbolTable::intern("n"); t4.toState = 2;
     
     dfa.transitions << t1 << t2 << t3 << t4;
     
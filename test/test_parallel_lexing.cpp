@@ -0,0 +1,204 @@
+#include <QCoreApplication>
+#include <QList>
+#include <QDebug>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QVector>
+#include <QPair>
+#include <cstdlib>
+#include "task1/lexergenerator.h"
+#include "task1/dfalexer.h"
+#include "test_pipeline.h"
+
+static const char *INPUT_PATH = "test_parallel_lexing_input.txt";
+static const char *LEXER_SOURCE_PATH = "test_parallel_lexing_lexer.cpp";
+static const char *LEXER_BINARY_PATH = "test_parallel_lexing_lexer";
+static const char *LEXER_OUTPUT_PATH = "test_parallel_lexing_lexer.out";
+
+// 与DFALexer和生成的词法分析器的块大小相同
+static const int CHUNK_BYTES = 1 << 20;
+static const int CHUNK_COUNT = 8;
+
+// 依次比较的线程数，0表示取硬件线程数
+static const int THREAD_COUNTS[] = {2, 3, 4, 8, 0};
+
+// 放在块边界前的文本：从边界前before个字节开始，其中第一个单词长length个字节，越过边界
+typedef struct {
+    QByteArray text;
+    int before;
+    int length;
+} Straddle;
+
+bool writeFile(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+/*
+ * 以mini-c示例填充各块，每个块边界处放一个越过边界的单词：注释、双字符运算符、标识符、小数，
+ * 边界落在"<"与"=="之间的"<=="（实际为"<="与"="，从边界推测识别得到跨过实际单词边界的"=="），
+ * 以及一个长度超过一整块的注释（其后的块从注释中间开始推测识别，推测结果全部作废）。
+ * straddles记录各单词的起点与长度，用于确认单线程结果中单词确实越过了边界
+ */
+QByteArray buildInput(QList<QPair<int, int>> &straddles)
+{
+    const QByteArray sample = readTestFile("mini-c/minic_sample.txt").toUtf8();
+    const QList<Straddle> planted = {
+        {"//" + QByteArray(100, 'c') + "<=x", 3, 105},
+        {"<==b", 1, 2},
+        {"++", 1, 2},
+        {"counter" + QByteArray(40, 'x'), 4, 47},
+        {"12345.678", 5, 9},
+        {"//" + QByteArray(CHUNK_BYTES + CHUNK_BYTES / 2, 'a'), 10, CHUNK_BYTES + CHUNK_BYTES / 2 + 2},
+        {"==", 1, 2},
+    };
+
+    QByteArray input;
+    int next = 0;
+    for (int boundary = CHUNK_BYTES; boundary < CHUNK_BYTES * CHUNK_COUNT; boundary += CHUNK_BYTES) {
+        if (input.size() > boundary - 64) {
+            continue;  // 上一个长注释已经越过了这个边界
+        }
+        const Straddle &straddle = planted[next++ % planted.size()];
+        const int start = boundary - straddle.before;
+        while (input.size() + sample.size() < start) {
+            input += sample;
+        }
+        input += QByteArray(start - input.size(), ' ');
+        straddles.append(qMakePair(start, straddle.length));
+        input += straddle.text + " ";
+    }
+    while (input.size() < CHUNK_BYTES * CHUNK_COUNT) {
+        input += sample;
+    }
+    return input;
+}
+
+// 按生成的词法分析器的文本格式输出单词流：单词\t编码\n
+QByteArray formatTokens(const QByteArray &source, const QVector<LexedToken> &tokens)
+{
+    QByteArray text;
+    for (const LexedToken &token : tokens) {
+        text += source.mid(token.offset, token.length) + "\t" + QByteArray::number(token.code) + "\n";
+    }
+    return text;
+}
+
+bool sameTokens(const QVector<LexedToken> &a, const QVector<LexedToken> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.size(); i++) {
+        if (a[i].code != b[i].code || a[i].offset != b[i].offset || a[i].length != b[i].length) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 以-j threads运行生成的词法分析器，返回输出的单词流，失败时返回空
+QByteArray runGeneratedLexer(int threads)
+{
+    const QString command = QString("./%1 -j %2 %3 > %4").arg(LEXER_BINARY_PATH).arg(threads)
+                                .arg(INPUT_PATH).arg(LEXER_OUTPUT_PATH);
+    if (system(qPrintable(command)) != 0) {
+        qDebug() << "失败：运行失败：" << command;
+        return QByteArray();
+    }
+    return readFile(LEXER_OUTPUT_PATH);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QList<RegexItem> items;
+    if (!parseSpec(miniCSpec(), items)) {
+        return 1;
+    }
+    DFA minimizedDFA = buildMinimizedSpecDFA(items);
+    DFALexer lexer;
+    if (!lexer.build(items, minimizedDFA)) {
+        qDebug() << "失败：构建DFALexer失败：" << lexer.getErrorMessage();
+        return 1;
+    }
+
+    int failures = 0;
+    QList<QPair<int, int>> straddles;
+    const QByteArray input = buildInput(straddles);
+    qDebug() << "输入字节数：" << input.size() << "越过块边界的单词数：" << straddles.size();
+
+    lexer.setThreadCount(1);
+    const QVector<LexedToken> expected = lexer.tokenize(input);
+
+    // 单线程结果中，放在边界处的单词应整个被识别为一个单词
+    for (const auto &straddle : straddles) {
+        bool found = false;
+        for (const LexedToken &token : expected) {
+            if (token.offset == straddle.first) {
+                found = token.length == straddle.second;
+                break;
+            }
+        }
+        if (!found) {
+            qDebug() << "失败：偏移" << straddle.first << "处没有识别出越过块边界的单词";
+            failures++;
+        }
+    }
+
+    // DFALexer：各线程数的结果应与单线程完全相同
+    for (int threads : THREAD_COUNTS) {
+        lexer.setThreadCount(threads);
+        if (!sameTokens(lexer.tokenize(input), expected)) {
+            qDebug() << "失败：DFALexer" << threads << "个线程的结果与单线程不同";
+            failures++;
+        }
+    }
+
+    // 生成的词法分析器：-j各线程数的输出应与-j 1相同，-j 1的输出应与DFALexer相同
+    LexerGenerator generator;
+    const QString code = generator.generateLexer(items, minimizedDFA, GenerationMethod::TABLE_DRIVEN);
+    const QString compile = QString("g++ -std=c++17 -O2 -o %1 %2 -lpthread").arg(LEXER_BINARY_PATH).arg(LEXER_SOURCE_PATH);
+    if (code.isEmpty() || !writeFile(LEXER_SOURCE_PATH, code.toUtf8()) || !writeFile(INPUT_PATH, input)
+        || system(qPrintable(compile)) != 0) {
+        qDebug() << "失败：生成或编译词法分析器失败：" << generator.getErrorMessage();
+        failures++;
+    } else {
+        const QByteArray sequential = runGeneratedLexer(1);
+        if (sequential != formatTokens(input, expected)) {
+            qDebug() << "失败：生成的词法分析器-j 1的输出与DFALexer不同";
+            failures++;
+        }
+        for (int threads : THREAD_COUNTS) {
+            if (runGeneratedLexer(threads) != sequential) {
+                qDebug() << "失败：生成的词法分析器-j" << threads << "的输出与-j 1不同";
+                failures++;
+            }
+        }
+    }
+
+    QFile::remove(INPUT_PATH);
+    QFile::remove(LEXER_SOURCE_PATH);
+    QFile::remove(LEXER_BINARY_PATH);
+    QFile::remove(LEXER_OUTPUT_PATH);
+
+    if (failures == 0) {
+        qDebug() << "全部通过";
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+#include <QCoreApplication>
+#include <QList>
+#include <QDebug>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "test_pipeline.h"
+
+// 依次比较的线程数，0表示取硬件线程数
+static const int THREAD_COUNTS[] = {2, 3, 4, 8, 0};
+
+// 与DFABuilder中并行处理一层所需的最少状态数相同
+static const int PARALLEL_MIN_LEVEL_SIZE = 64;
+
+/*
+ * 较大的合成定义：两百多个关键字使前几层很宽，
+ * "倒数第9个字符为x"的模式在x/y上展开为2^9个状态，
+ * 另有一般的标识符、数字与注释与它们重叠
+ */
+QString syntheticSpec()
+{
+    QString spec = "letter=[A-Za-z]\ndigit=[0-9]\n";
+    spec += "_identifier100=(_|letter)(_|letter|digit)*\n";
+    spec += "_number101=digit+(.digit+)?((e|E)(\\+|-)?digit+)?\n";
+    spec += "_comment102=/\\*(letter|digit| )*\\*/\n";
+    spec += "_tail103=#(x|y)*x(x|y)(x|y)(x|y)(x|y)(x|y)(x|y)(x|y)(x|y)\n";
+
+    QStringList words;
+    const QString syllables = "bcdfgklmnprstvz";
+    const QString vowels = "aeiou";
+    for (int i = 0; i < 240; i++) {
+        QString word;
+        int n = i * 7 + 3;
+        for (int k = 0; k < 2 + i % 3; k++) {
+            word += syllables.at(n % syllables.length());
+            word += vowels.at((n / syllables.length()) % vowels.length());
+            n = n / 5 + k * 11 + i;
+        }
+        words.append(word);
+    }
+    spec += "_Keyword300S=" + words.join("|") + "\n";
+    return spec;
+}
+
+// 按层（从起始状态的广度优先距离）统计状态数，返回最宽一层的状态数
+int widestLevel(const DFA &dfa)
+{
+    QVector<QList<DFAState>> edges(dfa.states.size());
+    for (const DFATransition &transition : dfa.transitions) {
+        edges[transition.fromState].append(transition.toState);
+    }
+    QVector<int> depth(dfa.states.size(), -1);
+    QVector<int> levelSizes;
+    QList<DFAState> queue = {dfa.startState};
+    depth[dfa.startState] = 0;
+    for (int head = 0; head < queue.size(); head++) {
+        const DFAState state = queue[head];
+        if (levelSizes.size() <= depth[state]) {
+            levelSizes.resize(depth[state] + 1);
+        }
+        levelSizes[depth[state]]++;
+        for (DFAState target : edges[state]) {
+            if (depth[target] == -1) {
+                depth[target] = depth[state] + 1;
+                queue.append(target);
+            }
+        }
+    }
+    int widest = 0;
+    for (int size : levelSizes) {
+        widest = qMax(widest, size);
+    }
+    return widest;
+}
+
+// 比较两个DFA的状态编号、转移（含顺序）与接受标注，不同时返回第一处差异的描述
+QString firstDifference(const DFA &expected, const DFA &actual)
+{
+    if (expected.states != actual.states || expected.startState != actual.startState) {
+        return QString("状态不同：%1个与%2个").arg(expected.states.size()).arg(actual.states.size());
+    }
+    if (expected.transitions.size() != actual.transitions.size()) {
+        return QString("转移数不同：%1与%2").arg(expected.transitions.size()).arg(actual.transitions.size());
+    }
+    for (int i = 0; i < expected.transitions.size(); i++) {
+        const DFATransition &a = expected.transitions[i];
+        const DFATransition &b = actual.transitions[i];
+        if (a.fromState != b.fromState || a.input != b.input || a.toState != b.toState) {
+            return QString("第%1条转移不同").arg(i);
+        }
+    }
+    if (expected.acceptStates != actual.acceptStates) {
+        return "接受状态不同";
+    }
+    if (expected.acceptStateToRegexIndex != actual.acceptStateToRegexIndex) {
+        return "接受状态的正则表达式索引不同";
+    }
+    if (expected.acceptStateToWordIndex != actual.acceptStateToWordIndex) {
+        return "接受状态的单词下标不同";
+    }
+    return QString();
+}
+
+// 单线程与各线程数的子集构造结果应完全相同，返回失败次数
+int compareThreadCounts(const QString &name, const QString &spec, bool requireParallelLevel)
+{
+    QList<RegexItem> items;
+    if (!parseSpec(spec, items)) {
+        return 1;
+    }
+
+    int failures = 0;
+    const DFA expected = buildSpecDFA(items, false, 1);
+    const int widest = widestLevel(expected);
+    qDebug() << name << "状态数：" << expected.states.size() << "最宽一层：" << widest;
+    if (requireParallelLevel && widest < PARALLEL_MIN_LEVEL_SIZE) {
+        qDebug() << "失败：" << name << "没有一层宽到需要并行处理";
+        failures++;
+    }
+
+    for (int threads : THREAD_COUNTS) {
+        const QString difference = firstDifference(expected, buildSpecDFA(items, false, threads));
+        if (!difference.isEmpty()) {
+            qDebug() << "失败：" << name << threads << "个线程与单线程的DFA不同：" << difference;
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int failures = 0;
+    failures += compareThreadCounts("mini-c", miniCSpec(), false);
+    failures += compareThreadCounts("合成定义", syntheticSpec(), true);
+
+    if (failures == 0) {
+        qDebug() << "全部通过";
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+/*
+ * @file test_pipeline.h
+ * @brief 测试共用的构建流程：读取test目录下的正则表达式定义，按Task1Window的流程构建DFA
+ */
+#ifndef TEST_PIPELINE_H
+#define TEST_PIPELINE_H
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include "task1/regexprocessor.h"
+#include "task1/nfabuilder.h"
+#include "task1/dfabuilder.h"
+#include "task1/dfaminimizer.h"
+
+// test目录下文件的路径
+inline QString testDataPath(const QString &name)
+{
+    return QFileInfo(QString(__FILE__)).absolutePath() + "/" + name;
+}
+
+// 读取test目录下的文件，失败时返回空字符串
+inline QString readTestFile(const QString &name)
+{
+    QFile file(testDataPath(name));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "无法打开测试文件：" << file.fileName();
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+// mini-c的正则表达式定义（test/mini-c/regex.txt）
+inline QString miniCSpec()
+{
+    return readTestFile("mini-c/regex.txt");
+}
+
+// 解析正则表达式定义，得到正则表达式项
+inline bool parseSpec(const QString &spec, QList<RegexItem> &items)
+{
+    RegexProcessor processor;
+    if (spec.isEmpty() || !processor.parse(spec)) {
+        qDebug() << "解析正则表达式失败：" << processor.getErrorMessage();
+        return false;
+    }
+    items = processor.getRegexItems();
+    return true;
+}
+
+/*
+ * 按Task1Window的流程构建总DFA：以'_'开头的项按名称排序，
+ * 子集构造时合并各项的NFA，直接构造时按同一顺序排列语法树，最后标注多单词项的接受状态
+ */
+inline DFA buildSpecDFA(const QList<RegexItem> &items, bool direct, int threadCount = 1)
+{
+    NFABuilder nfaBuilder;
+    QMap<QString, int> indexMap;
+    for (int i = 0; i < items.size(); i++) {
+        if (items[i].name.startsWith('_')) {
+            indexMap[items[i].name] = i;
+        }
+    }
+
+    DFABuilder dfaBuilder;
+    dfaBuilder.setThreadCount(threadCount);
+    dfaBuilder.setTokenPriority(items);
+    DFA dfa;
+    if (direct) {
+        QList<RegexSyntaxTree> trees;
+        QList<int> regexIndices;
+        for (auto it = indexMap.constBegin(); it != indexMap.constEnd(); ++it) {
+            trees.append(nfaBuilder.buildSyntaxTree(items[it.value()]));
+            regexIndices.append(it.value());
+        }
+        dfa = dfaBuilder.convertRegexesToDFA(trees, regexIndices);
+    } else {
+        QList<NFA> nfAs;
+        for (auto it = indexMap.constBegin(); it != indexMap.constEnd(); ++it) {
+            NFA nfa = nfaBuilder.buildNFA(items[it.value()]);
+            for (const NFAState &state : nfa.acceptStates) {
+                nfa.acceptStateToRegexIndex[state] = it.value();
+            }
+            nfAs.append(nfa);
+        }
+        dfa = dfaBuilder.convertNFAToDFA(NFABuilder::mergeNFAs(nfAs));
+    }
+    dfaBuilder.labelWordAcceptStates(dfa, items);
+    return dfa;
+}
+
+// 构建并最小化总DFA
+inline DFA buildMinimizedSpecDFA(const QList<RegexItem> &items, bool direct = false, int threadCount = 1)
+{
+    DFAMinimizer minimizer;
+    return minimizer.minimizeDFA(buildSpecDFA(items, direct, threadCount));
+}
+
+#endif // TEST_PIPELINE_H
@@ -0,0 +1,176 @@
+#include <QCoreApplication>
+#include <QList>
+#include <QPair>
+#include <QDebug>
+#include <QString>
+#include <QStringList>
+#include "task1/regexengine.h"
+
+// 各后端的配置
+typedef struct {
+    const char *name;    // 后端名称
+    bool bitParallel;    // 是否允许位并行
+    bool lazyDFA;        // 是否启用惰性DFA
+    int cacheSize;       // 惰性DFA缓存上限，0表示默认值
+} Backend;
+
+// 1字节的缓存只容纳起始状态，第一次构造新状态就放弃惰性DFA（LAZY_BAIL）；
+// 2KB的缓存会反复清空后继续构造
+static const Backend BACKENDS[] = {
+    {"NFA模拟", false, false, 0},
+    {"惰性DFA", false, true, 0},
+    {"惰性DFA（缓存放弃）", false, true, 1},
+    {"惰性DFA（缓存清空）", false, true, 2048},
+    {"位并行", true, false, 0},
+    {"位并行+惰性DFA", true, true, 0},
+};
+
+// 引用实现：只用NFA模拟，搜索时与原实现相同，从每个位置起做一次锚定匹配
+bool referenceSearch(RegexEngine &reference, const QString &input, int &startPos, int &matchLength)
+{
+    for (int i = 0; i < input.length(); i++) {
+        int len = 0;
+        if (reference.match(input.mid(i), len)) {
+            startPos = i;
+            matchLength = len;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 确定性的伪随机输入，字符取自alphabet
+QStringList randomInputs(const QString &alphabet, int count, int maxLength)
+{
+    QStringList inputs;
+    quint32 seed = 12345;
+    for (int n = 0; n < count; n++) {
+        seed = seed * 1103515245u + 12345u;
+        int length = (seed >> 16) % (maxLength + 1);
+        QString input;
+        for (int i = 0; i < length; i++) {
+            seed = seed * 1103515245u + 12345u;
+            input += alphabet.at((seed >> 16) % alphabet.length());
+        }
+        inputs.append(input);
+    }
+    return inputs;
+}
+
+// 在全部输入上比较后端与引用实现的match和search结果，返回不一致的次数
+int compareBackend(const Backend &backend, const QString &pattern, const QStringList &inputs)
+{
+    RegexEngine reference;
+    reference.setBitParallelEnabled(false);
+    reference.setLazyDFAEnabled(false);
+
+    RegexEngine engine;
+    engine.setBitParallelEnabled(backend.bitParallel);
+    engine.setLazyDFAEnabled(backend.lazyDFA);
+    if (backend.cacheSize > 0) {
+        engine.setLazyDFACacheSize(backend.cacheSize);
+    }
+
+    if (!reference.compile(pattern) || !engine.compile(pattern)) {
+        qDebug() << pattern << "编译失败：" << engine.getErrorMessage();
+        return 1;
+    }
+
+    int mismatches = 0;
+    for (const QString &input : inputs) {
+        int refLen = -1;
+        int len = -1;
+        bool refMatched = reference.match(input, refLen);
+        bool matched = engine.match(input, len);
+        if (refMatched != matched || (matched && refLen != len)) {
+            qDebug() << backend.name << "match不一致：" << pattern << input
+                     << "期望" << refMatched << refLen << "实际" << matched << len;
+            mismatches++;
+        }
+
+        int refStart = -1;
+        int start = -1;
+        refLen = -1;
+        len = -1;
+        refMatched = referenceSearch(reference, input, refStart, refLen);
+        matched = engine.search(input, start, len);
+        if (refMatched != matched || (matched && (refStart != start || refLen != len))) {
+            qDebug() << backend.name << "search不一致：" << pattern << input
+                     << "期望" << refMatched << refStart << refLen << "实际" << matched << start << len;
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // 锚点、空匹配、字符集、重复，以及有字面量前缀的模式（输入中多为前缀不完整的位置）
+    const QStringList patterns = {
+        "ab", "a*", "x?", "(a|b)*c", "a+b+", "[^0-9]+", "[a-c]d", ".b", "a{2,3}", "(ab|a)(bc|c)?",
+        "^ab", "ab$", "^a*$", "^(a|b)+", "(c|d)$",
+        "abc", "abd[0-9]+", "(cat|car)s?", "ca(t|r)", "01x*",
+        "ab|bcde", "abcd|c", "a|ab|abc", "x*yz|y", "(a|b)*abb",
+    };
+    const QStringList inputs = randomInputs("abcdrstx01 \n", 300, 12)
+                               + QStringList{"", "a", "ab", "xab", "aab", "abab", "b\nab", "ca", "cab", "cats",
+                                             "xcarsx", "abd", "abd7", "ababd42", "0101x", "aaaa",
+                                             "abcde", "abcd", "xxyz", "xyyz", "aabcabc", "babb"};
+
+    // 位置数超过64的模式不能使用位并行，应退回惰性DFA或NFA模拟
+    QString longPattern;
+    for (int i = 0; i < 35; i++) {
+        longPattern += "(a|b)";
+    }
+    const QStringList longPatterns = {longPattern, "(ab|cd|ef|gh|ij|kl|mn|op|qr|st|uv|wx|yz)*(abc|abd|abe|abf|abg|abh|abi|abj|abk|abl|abm|abn|abo|abp|abq)"};
+    QStringList longInputs = randomInputs("abcd", 40, 80);
+    longInputs += QStringList{QString(35, 'a'), QString(34, 'a'), QString(40, 'b') + "x" + QString(35, 'a'), "ababcdabq", "cdcdab"};
+
+    // 长输入：开头附近就有匹配，或者匹配一直延续到末尾。
+    // 引用实现从每个位置起做锚定匹配，所以只用匹配起点靠前的输入
+    const int bigLength = 1 << 15;
+    const QList<QPair<QString, QString>> bigCases = {
+        {"ab", "xab" + QString(bigLength, 'b')},
+        {"(ab|b)+", "xab" + QString(bigLength, 'b')},
+        {"b+c", QString(bigLength, 'b') + "c"},
+        {"x(a|b)*", "x" + QString(bigLength, 'a')},
+    };
+
+    int failures = 0;
+    for (const Backend &backend : BACKENDS) {
+        int mismatches = 0;
+        for (const QString &pattern : patterns) {
+            mismatches += compareBackend(backend, pattern, inputs);
+        }
+        for (const QString &pattern : longPatterns) {
+            mismatches += compareBackend(backend, pattern, longInputs);
+        }
+        for (const auto &bigCase : bigCases) {
+            mismatches += compareBackend(backend, bigCase.first, QStringList{bigCase.second});
+        }
+        qDebug() << backend.name << "不一致次数：" << mismatches;
+        if (mismatches > 0) {
+            failures++;
+        }
+    }
+
+    // 位并行只用于位置数不超过64的模式
+    RegexEngine engine;
+    if (!engine.compile("(cat|car)s?") || !engine.isBitParallel()) {
+        qDebug() << "失败：位置数较少的模式没有使用位并行";
+        failures++;
+    }
+    for (const QString &pattern : longPatterns) {
+        if (!engine.compile(pattern) || engine.isBitParallel()) {
+            qDebug() << "失败：位置数超过64的模式使用了位并行";
+            failures++;
+        }
+    }
+
+    if (failures == 0) {
+        qDebug() << "全部通过";
+    }
+    return failures == 0 ? 0 : 1;
+}
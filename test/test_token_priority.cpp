@@ -0,0 +1,65 @@
+#include <QCoreApplication>
+#include <QList>
+#include <QDebug>
+#include <QString>
+#include "task1/dfalexer.h"
+#include "test_pipeline.h"
+
+static const char *SOURCE = "int main ( ) { real x = 1.5 ; if ( x >= 2 ) return _ ; }";
+
+// 把mini-c中关键字项改名为keywordName，构建最小化DFA并识别SOURCE，返回token编码序列
+QList<int> lexWithSpec(const QString &keywordName, bool direct)
+{
+    QList<int> codes;
+    QList<RegexItem> items;
+    if (!parseSpec(miniCSpec().replace("_Keyword300S", keywordName), items)) {
+        return codes;
+    }
+    DFA minimizedDFA = buildMinimizedSpecDFA(items, direct);
+    
+    DFALexer lexer;
+    if (!lexer.build(items, minimizedDFA)) {
+        qDebug() << "构建词法分析器失败：" << lexer.getErrorMessage();
+        return codes;
+    }
+    for (const LexedToken &token : lexer.tokenize(QByteArray(SOURCE))) {
+        codes.append(token.code);
+    }
+    return codes;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    
+    int failures = 0;
+    for (bool direct : {false, true}) {
+        const char *method = direct ? "直接构造" : "子集构造";
+        
+        // 关键字项改名后排到标识符之前或之后，识别结果都不应改变
+        QList<int> original = lexWithSpec("_Keyword300S", direct);
+        QList<int> renamed = lexWithSpec("_kw300S", direct);
+        qDebug() << method << "原名称：" << original;
+        qDebug() << method << "改名后：" << renamed;
+        
+        // int、real、if、return是关键字，main、x是标识符，_是特殊符号
+        const bool keywordsOk = original.size() == 20
+                                && original[0] >= 300 && original[1] == 200
+                                && original[5] >= 300 && original[6] == 200
+                                && original[10] >= 300 && original[16] >= 300
+                                && original[17] != 200;
+        if (!keywordsOk) {
+            qDebug() << method << "失败：关键字或特殊符号被识别为标识符";
+            failures++;
+        }
+        if (original != renamed) {
+            qDebug() << method << "失败：改名后识别结果不同";
+            failures++;
+        }
+    }
+    
+    if (failures == 0) {
+        qDebug() << "全部通过";
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -3,6 +3,7 @@
 #include <QDebug>
 #include <QString>
 #include "task1/lexergenerator.h"
+#include "task1/symboltable.h"
 
 int main(int argc, char *argv[])
 {
@@ -60,11 +61,11 @@ int main(int argc, char *argv[])
     
     // 添加一些基本的状态转移
     DFATransition t1, t2, t3, t4, t5;
-    t1.fromState = 0; t1.input = "a"; t1.toState = 1;
-    t2.fromState = 0; t2.input = "0"; t2.toState = 2;
-    t3.fromState = 0; t3.input = "{"; t3.toState = 3;
-    t4.fromState = 0; t4.input = "+"; t4.toState = 4;
-    t5.fromState = 0; t5.input = "i"; t5.toState = 5;
+    t1.fromState = 0; t1.input = SymbolTable::intern("a"); t1.toState = 1;
+    t2.fromState = 0; t2.input = SymbolTable::intern("0"); t2.toState = 2;
+    t3.fromState = 0; t3.input = SymbolTable::intern("{"); t3.toState = 3;
+    t4.fromState = 0; t4.input = SymbolTable::intern("+"); t4.toState = 4;
+    t5.fromState = 0; t5.input = SymbolTable::intern("i"); t5.toState = 5;
     
     dfa.transitions << t1 << t2 << t3 << t4 << t5;
     